@@ -9,8 +9,6 @@
 
 #include "AnalogSensorNtcThermistor.h"
 #include "ConstantsServices.h"
-#include <wiringPi.h>
-#include <ads1115.h>
 #include <cmath>
 //#include <stdio.h>
 //#include <stdlib.h>
@@ -27,6 +25,14 @@ AnalogSensorNtcThermistor::AnalogSensorNtcThermistor(const char* instanceName, c
 {
     // Enable errors log channel
     logChannels_ = Logger::ERRORS;
+
+    for ( unsigned int i=0; i < MAX_IDS; i++ )
+    {
+        gains_[i] = 1.0f;
+        offsets_[i] = 0.0f;
+        loggedValues_[i] = MIN_TEMPERATURE;
+    }
+    buildTable();
 }
 
 Result AnalogSensorNtcThermistor::initialize()
@@ -60,6 +66,26 @@ Result AnalogSensorNtcThermistor::initialize()
     }    
     else LOGGING(INFO, "INFO: read value of constant RPU is %d", resistancePullUp_);
 
+    // Steinhart-Hart model if its 3 coefficients are there
+    const char* COEFFICIENT_NAMES[3] = { "SH_A_E12", "SH_B_E12", "SH_C_E12" };
+    unsigned int numCoefficients = 0u;
+    for ( unsigned int i=0; i < 3u; i++ )
+    {
+        int32_t coefficient = 0;
+        if ( constsServices.readConstant(COEFFICIENT_NAMES[i], coefficient) != RESULT_OK ) continue;
+        coefficients_[i] = coefficient * 1e-12;
+        numCoefficients++;
+    }
+    steinhartHart_ = ( numCoefficients == 3u );
+    if ( numCoefficients != 0u && !steinhartHart_ )
+    {
+        LOGGING(ERRORS, "ERROR only %d of 3 Steinhart-Hart coefficients of model %s, to use B parameter", numCoefficients, model_.c_str());
+    }
+
+    buildTable();
+    LOGGING(INFO, "%s temperature table of %d segments from %.1f degC at ratio 0 to %.1f degC at ratio 1",
+                  steinhartHart_ ? "Steinhart-Hart" : "B parameter", TABLE_SEGMENTS, table_[0], table_[TABLE_SEGMENTS]);
+
     return RESULT_OK;
 }
 
@@ -83,45 +109,145 @@ Result AnalogSensorNtcThermistor::readValue(unsigned char id, float& value) cons
         return result;
     }    
 
+    // Ratiometric: supply of the divider measured on its own input
+    float vcc = NTC_VCC_VOLTS;
+    result = getVcc(vcc);
+    if ( result != RESULT_OK ) return result;
+
+    value = toTemperature(voltage / vcc);
+    calibrate(id, voltage, value);
+
+    return result;
+}
+
+Result AnalogSensorNtcThermistor::readValues(const unsigned char* ids, float* values, unsigned int count) const
+{
+    assert( gpioAnalog_ != nullptr );
+
+    if ( count > MAX_IDS )
+    {
+        LOGGING(ERRORS, "ERROR reading %d inputs at once, %d at most", count, MAX_IDS);
+        return RESULT_ERROR;
+    }
+
+    // Vcc is measured once for all inputs
+    float vcc = NTC_VCC_VOLTS;
+    Result result = getVcc(vcc);
+    if ( result != RESULT_OK ) return result;
+
+    // Ratios stay below RATIO_LIMIT: Vcc is not below NTC_MIN_VCC_VOLTS
+    float voltages[MAX_IDS];
+    float ratios[MAX_IDS];
+    bool read[MAX_IDS];
+    for ( unsigned int i=0; i < count; i++ )
+    {
+        read[i] = ( gpioAnalog_->getVoltage(ids[i], voltages[i]) == RESULT_OK );
+        if ( !read[i] )
+        {
+            LOGGING(ERRORS, "ERROR getting voltage of input %d of gpioAnalog_", ids[i]);
+            result = RESULT_ERROR;
+        }
+        ratios[i] = read[i] ? voltages[i] / vcc : 0.0f;
+    }
+
+    toTemperatures(ratios, values, count);
+
+    for ( unsigned int i=0; i < count; i++ )
+    {
+        if ( read[i] ) calibrate(ids[i], voltages[i], values[i]);
+        else values[i] = NAN;
+    }
+
+    return result;
+}
+
+Result AnalogSensorNtcThermistor::setCalibration(unsigned char id, float gain, float offset)
+{
+    if ( id >= MAX_IDS )
+    {
+        LOGGING(ERRORS, "ERROR calibration of input %d, must be below %d", id, MAX_IDS);
+        return RESULT_ERROR;
+    }
+    gains_[id] = gain;
+    offsets_[id] = offset;
+    LOGGING(INFO, "input %d calibrated with gain %.6f and offset %.3f degC", id, gain, offset);
+
+    return RESULT_OK;
+}
+
+float AnalogSensorNtcThermistor::evaluate(float ratio) const
+{
+    if ( !( ratio > 0.0f ) ) return MAX_TEMPERATURE;
+    if ( ratio >= 1.0f ) return MIN_TEMPERATURE;
+
     // To convert voltage to temperature:
     //
     //           Vout
     // Rntc = ---------- * Rpullup
     //        Vcc - Vout
     //
-    float vcc = 3.3;
-    if (voltage > vcc) vcc = voltage;
-    float resistanceNtc = static_cast<float>( voltage * resistancePullUp_ / ( vcc - voltage ) );
-        
+    double resistanceNtc = ratio * static_cast<double>(resistancePullUp_) / ( 1.0 - ratio );
+
     // To convert NTC resistance to temperature:
     //
     //               1      1         Rntc    -1
-    // Tntc[K] = [ ----- + --- * Ln ( ---- ) ]
+    // Tntc[K] = [ ----- + --- * Ln ( ---- ) ]                  B parameter
     //             T0[K]    B          R0
     //
-    float temperatureNtc = static_cast<float>( 1.0 / ( 1.0/(temperature0_+273.0) + 1.0/beta_*log(resistanceNtc/resistance0_) ) );
-    
-    // Convert value from degress Kelvin to Celsius
-    value = static_cast<float>(temperatureNtc - 273.0);    
-
-    if ( previousValues_.find(id) == previousValues_.end() )
+    // Tntc[K] = [ A + B * Ln(Rntc) + C * Ln(Rntc)^3 ]^-1       Steinhart-Hart
+    //
+    // Below 0 K the inverse is negative: far above the range
+    double inverseTemperature = 0.0;
+    if ( steinhartHart_ )
     {
-    	previousValues_[id] = value;
-        LOGGING(INFO, "got voltage %.2f volts, calculated resistanceNtc %.0f Ohms, calculated temperatureNtc is %.1f degC", voltage, resistanceNtc, value);
+        double logResistance = log(resistanceNtc);
+        inverseTemperature = coefficients_[0] + coefficients_[1] * logResistance + coefficients_[2] * logResistance * logResistance * logResistance;
     }
-    else
-    {
-    	if ( value != previousValues_[id] )
-    	{
-    		LOGGING(INFO, "got voltage %.2f volts, calculated resistanceNtc %.0f Ohms, calculated temperatureNtc is %.1f degC", voltage, resistanceNtc, value);
-    		previousValues_[id] = value;
-    	}
-    	else
-    	{
-    		LOGGING(VERBOSE, "got voltage %.2f volts, calculated resistanceNtc %.0f Ohms, calculated temperatureNtc is %.1f degC", voltage, resistanceNtc, value);
-    	}
+    else inverseTemperature = 1.0/(temperature0_+273.0) + 1.0/beta_*log(resistanceNtc/resistance0_);
+    if ( inverseTemperature <= 0.0 ) return MAX_TEMPERATURE;
+
+    // Convert value from degress Kelvin to Celsius; coefficients are fitted with 273.15
+    double temperatureNtc = 1.0 / inverseTemperature - ( steinhartHart_ ? 273.15 : 273.0 );
+    if ( temperatureNtc < MIN_TEMPERATURE ) return MIN_TEMPERATURE;
+    if ( temperatureNtc > MAX_TEMPERATURE ) return MAX_TEMPERATURE;
+
+    return static_cast<float>(temperatureNtc);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result AnalogSensorNtcThermistor::getVcc(float & vcc) const
+{
+    vcc = NTC_VCC_VOLTS;
+    if ( vccInput_ == NO_VCC_INPUT ) return RESULT_OK;
+
+    Result result = gpioAnalog_->getVoltage(vccInput_, vcc);
+    if ( result != RESULT_OK || vcc < NTC_MIN_VCC_VOLTS )
+    {
+        LOGGING(ERRORS, "ERROR getting Vcc of input %d: %.3f volts, result %d", vccInput_, vcc, result);
+        return RESULT_ERROR;
     }
 
-    return result;
+    return RESULT_OK;
 }
 
+void AnalogSensorNtcThermistor::calibrate(unsigned char id, float voltage, float & value) const
+{
+    if ( id >= MAX_IDS ) return;
+    value = gains_[id] * value + offsets_[id];
+
+    // Logged when it changes by half a degree
+    if ( fabsf(value - loggedValues_[id]) >= 0.5f )
+    {
+        LOGGING(INFO, "got voltage %.3f volts, temperatureNtc is %.1f degC", voltage, value);
+        loggedValues_[id] = value;
+    }
+}
+
+void AnalogSensorNtcThermistor::buildTable()
+{
+    for ( unsigned int i=0; i <= TABLE_SEGMENTS; i++ ) table_[i] = evaluate( static_cast<float>(i) / TABLE_SEGMENTS );
+}
@@ -8,12 +8,44 @@
  *  @date   January 2017
  *  @brief  Definition of AnalogSensorNtcThermistor
  *
- *  Function to be documented.
+ *  Temperature of an NTC thermistor read as voltage of a divider with a
+ *  pull-up resistor RPU to Vcc, on an analog input of IGpio. The NTC
+ *  resistance follows from the ratio Vout / Vcc:
+ *
+ *                ratio
+ *  Rntc = Rpullup * ---------
+ *                1 - ratio
+ *
+ *  and the temperature from one of two models:
+ *      - B parameter:    1/T = 1/T0 + 1/B * Ln(Rntc / R0)
+ *      - Steinhart-Hart: 1/T = A + B * Ln(Rntc) + C * Ln(Rntc)^3
+ *  Constants of the model are read from NtcThermistor<model>.consts: B, T0
+ *  (degC), R0 and RPU (Ohm), and, for Steinhart-Hart, SH_A_E12, SH_B_E12
+ *  and SH_C_E12 (coefficients times 1e12; see NtcCalibration to fit them
+ *  from reference points). Defaults are those of 25C10KB3470.
+ *
+ *  Whatever the model, it is evaluated once per table entry: initialize()
+ *  fills a table of the temperature at TABLE_SEGMENTS + 1 ratios evenly
+ *  spaced from 0 to 1 (2 KB, within 0.005 degC of the equation from -20
+ *  to 100 degC), and a read is one table access with linear interpolation,
+ *  without log(). Temperatures are clamped to the range of NTC
+ *  thermistors, MIN_TEMPERATURE to MAX_TEMPERATURE.
+ *
+ *  readValues() converts several inputs of the model in one call: Vcc is
+ *  measured once and the table is read by toTemperatures(), a loop
+ *  without branches that the compiler vectorizes at -O3 (NEON on the
+ *  Raspberry Pi, SSE/AVX on a simulation host, lookups as gathers with
+ *  AVX2), so that reading 16 inputs costs little more than reading one.
+ *
+ *  Vcc is NTC_VCC_VOLTS, or measured at every read on an analog input
+ *  wired to it (setVccInput()), so that the reading does not depend on the
+ *  supply. Every input id can be calibrated with a gain and an offset
+ *  applied to the temperature of the table (setCalibration()).
  */
 /////////////////////////////////////////////////////////////////////////////
 
 #include <stdint.h>
-#include <map>
+#include <string>
 #include "LenamDevs_types.h"
 #include "IComponent.h"
 #include "IGpio.h"
@@ -24,6 +56,9 @@
 // GLOBAL CONSTANTS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+const float NTC_VCC_VOLTS = 3.3f;                   // Supply of the divider, if not measured
+const float NTC_MIN_VCC_VOLTS = 1.0f;               // Lower Vcc measured is an input error
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // CLASS DECLARATION
@@ -33,8 +68,15 @@ class AnalogSensorNtcThermistor : public IComponent, public IAnalogSensor
 {
   public:
 
+    static const unsigned int TABLE_SEGMENTS = 512u;
+    static constexpr float MIN_TEMPERATURE = -55.0f;
+    static constexpr float MAX_TEMPERATURE = 150.0f;
+    static const unsigned char MAX_IDS = 16;
+    static const unsigned char NO_VCC_INPUT = 0xFF;
+    static constexpr float RATIO_LIMIT = 64.0f;        // toTemperatures() position fits in int32_t
+
     /*
-     * Class constructor 
+     * Class constructor; table holds default constants until initialize()
      */
     AnalogSensorNtcThermistor(const char* instanceName, const char* model);
 
@@ -53,6 +95,78 @@ class AnalogSensorNtcThermistor : public IComponent, public IAnalogSensor
  
     Result readValue(unsigned char id, float& value) const;
 
+    /**
+     * Reads temperatures of several inputs in one pass
+     * @param ids of inputs, count up to MAX_IDS
+     * @param values read, NAN for inputs whose voltage could not be got
+     * @param count of inputs
+     * @return Result RESULT_OK if all inputs were read
+     */
+    Result readValues(const unsigned char* ids, float* values, unsigned int count) const;
+
+    /**
+     * Measures Vcc of the divider on an analog input instead of using NTC_VCC_VOLTS
+     * @param id of input wired to Vcc, NO_VCC_INPUT to use NTC_VCC_VOLTS
+     */
+    void setVccInput(unsigned char id) { vccInput_ = id; }
+
+    /**
+     * Calibrates temperatures of input as gain * temperature + offset
+     * @param id of input, below MAX_IDS
+     * @param gain of temperature, 1 uncalibrated
+     * @param offset in degC, 0 uncalibrated
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result setCalibration(unsigned char id, float gain, float offset);
+
+    /**
+     * Temperature of divider ratio, from table, before calibration
+     * @param ratio Vout / Vcc of divider
+     * @return float temperature in degC
+     */
+    float toTemperature(float ratio) const
+    {
+        // NaN and negative ratios go to the first entry
+        float position = ratio * static_cast<float>(TABLE_SEGMENTS);
+        if ( !( position > 0.0f ) ) return table_[0];
+        if ( position >= static_cast<float>(TABLE_SEGMENTS) ) return table_[TABLE_SEGMENTS];
+        unsigned int segment = static_cast<unsigned int>(position);
+        float fraction = position - static_cast<float>(segment);
+
+        return table_[segment] + fraction * ( table_[segment + 1u] - table_[segment] );
+    }
+
+    /**
+     * Temperatures of divider ratios, from table, before calibration; within 0.001 degC of toTemperature()
+     * @param ratios Vout / Vcc of dividers, between -RATIO_LIMIT and RATIO_LIMIT
+     * @param temperatures in degC
+     * @param count of ratios
+     */
+    void toTemperatures(const float* ratios, float* __restrict temperatures, unsigned int count) const
+    {
+        // Position in fixed point of 1/65536 segment, clamped as integer: float compares and
+        // min/max stop the vectorizer unless built with -fno-trapping-math
+        const int32_t LAST_POSITION = static_cast<int32_t>(TABLE_SEGMENTS << 16);
+        for ( unsigned int i=0; i < count; i++ )
+        {
+            int32_t position = static_cast<int32_t>(ratios[i] * static_cast<float>(LAST_POSITION));
+            position = ( position > 0 ) ? position : 0;
+            position = ( position < LAST_POSITION ) ? position : LAST_POSITION - 1;
+            int32_t segment = position >> 16;
+            float fraction = static_cast<float>(position & 0xFFFF) * ( 1.0f / 65536.0f );
+            temperatures[i] = table_[segment] + fraction * ( table_[segment + 1] - table_[segment] );
+        }
+    }
+
+    /**
+     * Temperature of divider ratio by the model, as the table was filled
+     * @param ratio Vout / Vcc of divider
+     * @return float temperature in degC, clamped
+     */
+    float evaluate(float ratio) const;
+
+    bool isSteinhartHart() const { return steinhartHart_; }
+
   private:
 
     //std::ifstream constantsFilePtr_;
@@ -64,9 +178,44 @@ class AnalogSensorNtcThermistor : public IComponent, public IAnalogSensor
     int32_t resistance0_      = 10000;
     int32_t resistancePullUp_ = 10000;
 
+    /*
+     * Steinhart-Hart coefficients A, B and C, used instead of B parameter if read
+     */
+    bool steinhartHart_ = false;
+    double coefficients_[3];
+
     IGpio* gpioAnalog_        = nullptr;
 
-    mutable std::map<unsigned char, float> previousValues_;
+    unsigned char vccInput_ = NO_VCC_INPUT;
+
+    /*
+     * Temperature at ratio segment / TABLE_SEGMENTS
+     */
+    float table_[TABLE_SEGMENTS + 1u];
+
+    /*
+     * Calibration and last temperature logged of every input id
+     */
+    float gains_[MAX_IDS];
+    float offsets_[MAX_IDS];
+    mutable float loggedValues_[MAX_IDS];
+
+    /**
+     * Measures Vcc of the divider
+     * @param vcc NTC_VCC_VOLTS or voltage of vccInput_
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result getVcc(float & vcc) const;
+
+    /**
+     * Applies calibration of input to temperature and logs it if changed
+     */
+    void calibrate(unsigned char id, float voltage, float & value) const;
+
+    /*
+     * Fills table_ from constants
+     */
+    void buildTable();
 };
 
 #endif // _ANALOGSENSOR_NTCTHERMISTOR_H
@@ -0,0 +1,145 @@
+#ifndef _CHANNEL_FILTER_H
+#define _CHANNEL_FILTER_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ChannelFilter.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of ChannelFilter
+ *
+ *  Digital filter of the samples of one input channel, applied by the
+ *  sensor acquisition thread before the value reaches the control engine:
+ *      - NONE: samples pass unchanged.
+ *      - MOVING_AVERAGE: mean of the last length samples.
+ *      - MEDIAN: median of the last length samples, which drops spikes.
+ *      - IIR: single pole, each sample moves the output 1/length of the
+ *        way towards it (time constant of length samples).
+ *  Samples are kept in a fixed ring buffer of MAX_LENGTH, so filtering
+ *  allocates nothing. Until length samples have come, the window filters
+ *  use the samples there are; the IIR starts at the first sample.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <algorithm>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ChannelFilter
+{
+  public:
+
+    static const unsigned int MAX_LENGTH = 16u;
+
+    enum Type_T
+    {
+        NONE = 0,
+        MOVING_AVERAGE,
+        MEDIAN,
+        IIR
+    };
+
+    ChannelFilter() { configure(NONE, 1u); }
+
+    /**
+     * Sets filter and drops samples
+     * @param type of filter
+     * @param length window or time constant in samples, 1 to MAX_LENGTH
+     * @return bool false if type or length is not valid; filter is left unchanged
+     */
+    bool configure(Type_T type, unsigned int length)
+    {
+        if ( type > IIR || length < 1u || length > MAX_LENGTH ) return false;
+        type_ = type;
+        length_ = length;
+        reset();
+        return true;
+    }
+
+    /*
+     * Drops samples, e.g. after a gap in acquisition
+     */
+    void reset()
+    {
+        count_ = 0u;
+        next_ = 0u;
+        sum_ = 0.0;
+        output_ = 0.0f;
+    }
+
+    /**
+     * Filters sample
+     * @param sample new sample
+     * @return float filter output
+     */
+    float apply(float sample)
+    {
+        switch ( type_ )
+        {
+        case MOVING_AVERAGE:
+            // Running sum of the window; the sample leaving it is subtracted
+            if ( count_ == length_ ) sum_ -= samples_[next_];
+            else count_++;
+            sum_ += sample;
+            push(sample);
+            output_ = static_cast<float>( sum_ / count_ );
+            break;
+        case MEDIAN:
+        {
+            if ( count_ < length_ ) count_++;
+            push(sample);
+            float sorted[MAX_LENGTH];
+            std::copy(samples_, samples_ + count_, sorted);
+            std::nth_element(sorted, sorted + count_ / 2u, sorted + count_);
+            output_ = sorted[count_ / 2u];
+            if ( ( count_ & 1u ) == 0u )
+            {
+                // Even window: mean of the two middle samples
+                float lower = *std::max_element(sorted, sorted + count_ / 2u);
+                output_ = ( output_ + lower ) / 2.0f;
+            }
+            break;
+        }
+        case IIR:
+            if ( count_ == 0u ) output_ = sample;
+            else output_ += ( sample - output_ ) / static_cast<float>(length_);
+            count_ = 1u;
+            break;
+        default:
+            output_ = sample;
+            break;
+        }
+
+        return output_;
+    }
+
+    Type_T getType() const { return type_; }
+
+    unsigned int getLength() const { return length_; }
+
+  private:
+
+    Type_T type_;
+    unsigned int length_;
+
+    /*
+     * Ring buffer of the last count_ samples, next_ is the oldest once full
+     */
+    float samples_[MAX_LENGTH];
+    unsigned int count_;
+    unsigned int next_;
+    double sum_;
+    float output_;
+
+    void push(float sample)
+    {
+        samples_[next_] = sample;
+        next_ = ( next_ + 1u ) % length_;
+    }
+};
+
+#endif // _CHANNEL_FILTER_H
@@ -0,0 +1,476 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ControlEngine.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ControlEngine class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ControlEngine.h"
+#include <stdio.h>
+#include <string.h>
+#include <functional>
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FORWARD DECLARATIONS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Value of channel; channels not yet read count as 0.0
+ */
+static float valueOf(const ControlEngine::IoValues_T & ioValues, uint8_t channelId)
+{
+    ControlEngine::IoValues_T::const_iterator it = ioValues.find(channelId);
+    return ( it == ioValues.end() ) ? 0.0f : it->second;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ControlFiles::setDefaultChannels(Channel_T* channels)
+{
+    memset(channels, 0, NUM_HOST_CHANNELS * sizeof(Channel_T));
+    for ( unsigned int i=0; i < NUM_HOST_CHANNELS; i++ )
+    {
+        channels[i].id = i;
+        if ( i < NUM_OUTPUT_RELAYS )
+        {
+            snprintf(channels[i].name, MAX_CHAR_SIZE, "Relay%d", i + 1);
+            channels[i].type = OUTPUT_RELAY;
+            channels[i].dutyCycle = 60u;
+        }
+        else if ( i < NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS )
+        {
+            snprintf(channels[i].name, MAX_CHAR_SIZE, "DigitalInput%d", i + 1);
+            snprintf(channels[i].model, MAX_CHAR_SIZE, "N.C.");
+            channels[i].type = INPUT_DIGITAL;
+        }
+        else
+        {
+            snprintf(channels[i].name, MAX_CHAR_SIZE, "AnalogInput%d", i + 1);
+            channels[i].type = INPUT_ANALOG;
+        }
+    }
+}
+
+Result ControlFiles::readChannels(const char* fileName, Channel_T* channels)
+{
+    FILE* filePtr = fopen(fileName, "r");
+    if ( filePtr == NULL )
+    {
+        LOGGING(ERRORS, "ERROR opening file %s", fileName);
+        return RESULT_ERROR;
+    }
+
+    // Read one record past the table to detect extra channels
+    Channel_T read[NUM_HOST_CHANNELS + 1];
+    size_t numChannels = fread(read, sizeof(Channel_T), NUM_HOST_CHANNELS + 1, filePtr);
+    fclose(filePtr);
+    if ( numChannels < NUM_HOST_CHANNELS )
+    {
+        LOGGING(ERRORS, "ERROR missing definition of channels in file %s; only %zu channels defined", fileName, numChannels);
+        return RESULT_ERROR;
+    }
+    if ( numChannels > NUM_HOST_CHANNELS )
+    {
+        LOGGING(ERRORS, "WARNING more than %d channels found in file %s are discarded", NUM_HOST_CHANNELS, fileName);
+    }
+
+    // Check type of channels
+    for ( unsigned int i=0; i < NUM_HOST_CHANNELS; i++ )
+    {
+        if ( i < NUM_OUTPUT_RELAYS && read[i].type != OUTPUT_RELAY )
+        {
+            LOGGING(ERRORS, "ERROR channel %d must be of type output relay", i);
+            return RESULT_ERROR;
+        }
+        if ( i >= NUM_OUTPUT_RELAYS && i < (NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS)
+             && read[i].type != INPUT_DIGITAL && read[i].type != OUTPUT_DIGITAL )
+        {
+            LOGGING(ERRORS, "ERROR channel %d must be of type either input digital or output digital", i);
+            return RESULT_ERROR;
+        }
+        if ( i >= (NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS)
+             && read[i].type != INPUT_ANALOG && read[i].type != INPUT_NTC_THERMISTOR )
+        {
+            LOGGING(ERRORS, "ERROR channel %d must be of type either input analog or NTC thermistor", i);
+            return RESULT_ERROR;
+        }
+    }
+    memcpy(channels, read, NUM_HOST_CHANNELS * sizeof(Channel_T));
+
+    return RESULT_OK;
+}
+
+Result ControlFiles::readGuards(const char* fileName, Guard_T* guards)
+{
+    FILE* filePtr = fopen(fileName, "r");
+    if ( filePtr == NULL )
+    {
+        LOGGING(ERRORS, "ERROR opening file %s", fileName);
+        return RESULT_ERROR;
+    }
+
+    // Read one record past the table to detect extra guards
+    Guard_T read[MAX_NUM_GUARDS + 1];
+    size_t numGuards = fread(read, sizeof(Guard_T), MAX_NUM_GUARDS + 1, filePtr);
+    fclose(filePtr);
+    if ( numGuards > MAX_NUM_GUARDS )
+    {
+        LOGGING(ERRORS, "WARNING more than %d guards found in file %s are discarded", MAX_NUM_GUARDS, fileName);
+        numGuards = MAX_NUM_GUARDS;
+    }
+    memcpy(guards, read, numGuards * sizeof(Guard_T));
+    if ( numGuards < MAX_NUM_GUARDS ) guards[numGuards].type = END_OF_GUARDS;
+
+    return RESULT_OK;
+}
+
+
+ControlEngine::ControlEngine(const char* instanceName) : Logs(instanceName)
+{
+    logChannels_ = Logger::ERRORS;
+
+    memset(channels_, 0, sizeof(channels_));
+    memset(guardTunings_, 0, sizeof(guardTunings_));
+    memset(relayTimings_, 0, sizeof(relayTimings_));
+    guards_[0].type = END_OF_GUARDS;
+    compileGuards();
+
+    programIndex_ = new ProgramTransitionIndex("ProgramTransitionIndex");
+    ASSERT( programIndex_ != nullptr );
+}
+
+ControlEngine::~ControlEngine()
+{
+    delete programIndex_;
+}
+
+Result ControlEngine::configure(const Channel_T* channels, const Guard_T* guards)
+{
+    ASSERT( channels != nullptr );
+
+    memcpy(channels_, channels, sizeof(channels_));
+
+    guards_[0].type = END_OF_GUARDS;
+    for ( unsigned int i=0; guards != nullptr && i < MAX_NUM_GUARDS; i++ )
+    {
+        guards_[i] = guards[i];
+        if ( guards_[i].type == END_OF_GUARDS ) break;
+        if ( guards_[i].channelId >= NUM_OUTPUT_RELAYS )
+        {
+            LOGGING(ERRORS, "ERROR guard %d applies to channel %d which is not an output relay", i+1, guards_[i].channelId);
+            guards_[0].type = END_OF_GUARDS;
+            compileGuards();
+            return RESULT_ERROR;
+        }
+    }
+
+    if ( compileGuards() != RESULT_OK )
+    {
+        guards_[0].type = END_OF_GUARDS;
+        compileGuards();
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result ControlEngine::setGuardTunings(const GuardTuning_T* tunings)
+{
+    for ( unsigned int i=0; tunings != nullptr && i < MAX_NUM_GUARDS; i++ )
+    {
+        if ( !( tunings[i].hysteresis >= 0.0f ) )
+        {
+            LOGGING(ERRORS, "ERROR hysteresis %.3f of guard %d must not be negative", tunings[i].hysteresis, i+1);
+            return RESULT_ERROR;
+        }
+    }
+
+    if ( tunings == nullptr ) memset(guardTunings_, 0, sizeof(guardTunings_));
+    else memcpy(guardTunings_, tunings, sizeof(guardTunings_));
+
+    return compileGuards();
+}
+
+void ControlEngine::setRelayTimings(const RelayTiming_T* timings)
+{
+    if ( timings == nullptr ) memset(relayTimings_, 0, sizeof(relayTimings_));
+    else memcpy(relayTimings_, timings, sizeof(relayTimings_));
+}
+
+Result ControlEngine::setProgram(const ProgramStorage::ProgramImage* program)
+{
+    manualProgram_ = false;
+    manualModeOn_ = false;
+    manualStartMinute_ = -1l;
+
+    programIndex_->clear();
+    if ( program == nullptr ) return RESULT_OK;
+
+    uint8_t dutyCycles[NUM_OUTPUT_RELAYS];
+    for ( unsigned int i=0; i < NUM_OUTPUT_RELAYS; i++ ) dutyCycles[i] = channels_[i].dutyCycle;
+
+    return programIndex_->build(*program, dutyCycles, NUM_OUTPUT_RELAYS);
+}
+
+void ControlEngine::setManualProgram(Mask_T setpoints, unsigned int timeoutMinutes)
+{
+    programIndex_->clear();
+
+    manualProgram_ = true;
+    manualModeOn_ = false;
+    manualStartMinute_ = -1l;
+    manualSetpoints_ = setpoints;
+    manualTimeout_ = timeoutMinutes;
+}
+
+void ControlEngine::startManualProgram()
+{
+    if ( manualProgram_ ) manualModeOn_ = true;
+}
+
+Result ControlEngine::step(long weekSecond, const IoValues_T & ioValues, Outputs_T & outputs, bool tick)
+{
+    long weekMinute = weekSecond / 60;
+
+    outputs.dutyCyclesMask = RelayMask::ALL;
+    outputs.conditionsMask = RelayMask::ALL;
+    outputs.triggersMask   = 0u;
+    outputs.relaySetpoints = 0u;
+    outputs.heldRelays     = 0u;
+
+    // Compose duty cycles mask
+    if ( composeDutyCyclesMask(weekSecond % 60, outputs.dutyCyclesMask) != RESULT_OK )
+    {
+        LOGMSG(ERRORS, "ERROR composing duty cycles mask");
+        return RESULT_ERROR;
+    }
+
+    if ( manualProgram_ )
+    {
+        if ( manualModeOn_ )
+        {
+            if ( manualStartMinute_ == -1l )
+            {
+                LOGMSG(VERBOSE, "starting of manual program");
+
+                // Set manual start minute the first step
+                manualStartMinute_ = weekMinute;
+                programSetpoints_ = manualSetpoints_;
+                LOGGING(VERBOSE, "manual timeout is %d minutes", manualTimeout_);
+            }
+            else
+            {
+                // Check manual time out
+                bool overrun = ( weekMinute < manualStartMinute_ );
+                if
+                (
+                    ( !overrun && ( (weekMinute - manualStartMinute_) >= manualTimeout_ ) )
+                    ||
+                    ( overrun && ( ( ( 7*24*60 - 1) - manualStartMinute_ + weekMinute  ) >= manualTimeout_ ) )
+                )
+                {
+                    programSetpoints_ = 0u;
+                    manualStartMinute_ = -1l;
+                    manualModeOn_ = false;
+
+                    LOGMSG(VERBOSE, "ending of manual program");
+                }
+            }
+
+            // Calculate masked relay set points
+            outputs.relaySetpoints = programSetpoints_ & outputs.dutyCyclesMask;
+        }
+    }
+    else // This is the regular program operation
+    {
+        // Look up relay set points in program transition index
+        if ( programIndex_->isEmpty() )
+        {
+            LOGMSG(ERRORS, "ERROR no program transition index");
+            return RESULT_ERROR;
+        }
+        programSetpoints_ = programIndex_->lookup(weekSecond);
+
+        // Compose conditions and triggers masks
+        evaluateGuards(ioValues, outputs.conditionsMask, outputs.triggersMask, tick);
+
+        // Calculate masked relay set points
+        outputs.relaySetpoints = ( outputs.triggersMask | ( outputs.conditionsMask & programSetpoints_ ) ) & outputs.dutyCyclesMask;
+    }
+    outputs.programSetpoints = programSetpoints_;
+    outputs.heldRelays = applyRelayTimings(weekSecond, outputs.relaySetpoints);
+
+    return RESULT_OK;
+}
+
+void ControlEngine::evaluateGuards(const IoValues_T & ioValues, Mask_T & conditionsMask, Mask_T & triggersMask, bool tick)
+{
+    // One lookup per distinct input, however many guards read it
+    for ( unsigned int i=0; i < numInputs_; i++ )
+    {
+        inputValues_[i] = valueOf(ioValues, inputIds_[i]);
+        LOGGING(VERBOSE, "value of guardId:%02d is %.1f", inputIds_[i], inputValues_[i]);
+    }
+
+    Mask_T clearedBits = 0u;
+    triggersMask = 0u;
+    evaluateTable(guardTables_[GREATER], inputValues_, guardsPrimed_, tick, std::greater<float>(), clearedBits, triggersMask);
+    evaluateTable(guardTables_[LESS], inputValues_, guardsPrimed_, tick, std::less<float>(), clearedBits, triggersMask);
+    evaluateTable(guardTables_[GREATER_EQUAL], inputValues_, guardsPrimed_, tick, std::greater_equal<float>(), clearedBits, triggersMask);
+    evaluateTable(guardTables_[LESS_EQUAL], inputValues_, guardsPrimed_, tick, std::less_equal<float>(), clearedBits, triggersMask);
+    evaluateTable(guardTables_[EQUAL], inputValues_, guardsPrimed_, tick, std::equal_to<float>(), clearedBits, triggersMask);
+    evaluateTable(guardTables_[UNEQUAL], inputValues_, guardsPrimed_, tick, std::not_equal_to<float>(), clearedBits, triggersMask);
+    conditionsMask = RelayMask::ALL & static_cast<Mask_T>(~clearedBits);
+    guardsPrimed_ = true;
+}
+
+long ControlEngine::secondsToNextEvent(long weekSecond) const
+{
+    // Guards need their inputs sampled every tick; manual program has minute time out
+    if ( manualProgram_ || hasGuards() || programIndex_->isEmpty() ) return 0l;
+
+    // Held relays switch when their minimum on/off time ends
+    long seconds = programIndex_->secondsToNextEvent(weekSecond);
+    for ( unsigned int i=0; i < NUM_OUTPUT_RELAYS && heldRelays_ != 0u; i++ )
+    {
+        if ( ( ( heldRelays_ >> i ) & 1u ) == 0u ) continue;
+        long elapsed = ( weekSecond - switchSeconds_[i] + SECONDS_PER_WEEK ) % SECONDS_PER_WEEK;
+        long minimum = ( ( relayStates_ >> i ) & 1u ) ? relayTimings_[i].minOnSeconds : relayTimings_[i].minOffSeconds;
+        seconds = std::min(seconds, std::max(minimum - elapsed, 1l));
+    }
+
+    return seconds;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result ControlEngine::composeDutyCyclesMask(long second, Mask_T & dutyCyclesMask)
+{
+    dutyCyclesMask = RelayMask::ALL;
+
+    for (unsigned int i=0; i < NUM_OUTPUT_RELAYS; i++ )
+    {
+        if ( second >= channels_[i].dutyCycle )
+        {
+            dutyCyclesMask &= ~RelayMask::bit(channels_[i].id);
+
+            LOGGING(VERBOSE, "updating mask current second:%d dutyCycle:%d", second, channels_[i].dutyCycle);
+        }
+    }
+
+    return RESULT_OK;
+}
+
+Mask_T ControlEngine::applyRelayTimings(long weekSecond, Mask_T & setpoints)
+{
+    // Relays output at first step count as just switched
+    if ( !relayStatesKnown_ )
+    {
+        for ( unsigned int i=0; i < NUM_OUTPUT_RELAYS; i++ ) switchSeconds_[i] = weekSecond;
+        relayStates_ = setpoints;
+        relayStatesKnown_ = true;
+    }
+
+    Mask_T changed = setpoints ^ relayStates_;
+    heldRelays_ = 0u;
+    for ( unsigned int i=0; i < NUM_OUTPUT_RELAYS && changed != 0u; i++ )
+    {
+        if ( ( ( changed >> i ) & 1u ) == 0u ) continue;
+        long elapsed = ( weekSecond - switchSeconds_[i] + SECONDS_PER_WEEK ) % SECONDS_PER_WEEK;
+        long minimum = ( ( relayStates_ >> i ) & 1u ) ? relayTimings_[i].minOnSeconds : relayTimings_[i].minOffSeconds;
+        if ( elapsed < minimum ) heldRelays_ |= RelayMask::bit(i);
+        else switchSeconds_[i] = weekSecond;
+    }
+    relayStates_ = static_cast<Mask_T>( ( setpoints & ~heldRelays_ ) | ( relayStates_ & heldRelays_ ) );
+    if ( heldRelays_ != 0u ) LOGGING(VERBOSE, "relays held by minimum on/off times: %s", RelayMask::toString(heldRelays_).c_str());
+    setpoints = relayStates_;
+
+    return heldRelays_;
+}
+
+Result ControlEngine::compileGuards()
+{
+    // Comparison of each threshold that clears a condition and that sets a trigger
+    const Comparison_T CONDITION_COMPARISONS[6] = { GREATER, LESS, LESS_EQUAL, GREATER_EQUAL, UNEQUAL, EQUAL };
+    const Comparison_T TRIGGER_COMPARISONS[6] = { LESS_EQUAL, GREATER_EQUAL, GREATER, LESS, EQUAL, UNEQUAL };
+
+    for ( GuardTable_T & table : guardTables_ ) table.size = 0u;
+    numInputs_ = 0u;
+    guardsPrimed_ = false;
+
+    for ( unsigned int i=0; i < MAX_NUM_GUARDS && guards_[i].type != END_OF_GUARDS; i++ )
+    {
+        const Guard_T & guard = guards_[i];
+        if ( guard.type != CONDITION && guard.type != TRIGGER ) continue;
+        if ( static_cast<unsigned int>(guard.guardThreshold) > UNEQUAL_TO )
+        {
+            LOGGING(ERRORS, "ERROR unknown threshold %d of guard %d", guard.guardThreshold, i+1);
+            for ( GuardTable_T & table : guardTables_ ) table.size = 0u;
+            numInputs_ = 0u;
+            return RESULT_ERROR;
+        }
+
+        unsigned int slot = 0u;
+        while ( slot < numInputs_ && inputIds_[slot] != guard.guardId ) slot++;
+        if ( slot == numInputs_ ) inputIds_[numInputs_++] = guard.guardId;
+
+        bool condition = ( guard.type == CONDITION );
+        Comparison_T comparison = condition ? CONDITION_COMPARISONS[guard.guardThreshold] : TRIGGER_COMPARISONS[guard.guardThreshold];
+        GuardTable_T & table = guardTables_[comparison];
+        table.slots[table.size] = static_cast<uint8_t>(slot);
+        table.levels[table.size] = guard.guardLevel;
+
+        // Hysteresis moves the level back by the band while the comparison holds; none for == and !=
+        float hysteresis = guardTunings_[i].hysteresis;
+        switch ( comparison )
+        {
+            case GREATER:
+            case GREATER_EQUAL: table.releaseLevels[table.size] = guard.guardLevel - hysteresis; break;
+            case LESS:
+            case LESS_EQUAL:    table.releaseLevels[table.size] = guard.guardLevel + hysteresis; break;
+            default:            table.releaseLevels[table.size] = guard.guardLevel; break;
+        }
+        table.debounces[table.size] = std::max<uint8_t>(guardTunings_[i].debounce, 1u);
+        table.conditionBits[table.size] = condition ? RelayMask::bit(guard.channelId) : 0u;
+        table.triggerBits[table.size] = condition ? 0u : RelayMask::bit(guard.channelId);
+        table.states[table.size] = 0u;
+        table.counts[table.size] = 0u;
+        table.size++;
+    }
+
+    return RESULT_OK;
+}
+
+template <typename Comparison>
+void ControlEngine::evaluateTable(GuardTable_T & table, const float* inputValues, bool primed, bool tick, Comparison holds,
+                                  Mask_T & clearedBits, Mask_T & triggersMask)
+{
+    for ( unsigned int i=0; i < table.size; i++ )
+    {
+        // Result differing from state counts ticks, and becomes the state after debounce ticks;
+        // out of ticks the count only restarts, and only guards without debounce take it
+        float level = table.states[i] ? table.releaseLevels[i] : table.levels[i];
+        uint8_t differs = static_cast<uint8_t>( holds(inputValues[table.slots[i]], level) ) ^ table.states[i];
+        uint8_t count = static_cast<uint8_t>( ( table.counts[i] + tick ) & ( 0u - differs ) );
+        uint8_t debounce = primed ? table.debounces[i] : 1u;
+        uint8_t take = static_cast<uint8_t>( ( ( count >= debounce ) & tick ) | ( differs & ( debounce == 1u ) & !tick ) );
+        table.states[i] ^= take;
+        table.counts[i] = static_cast<uint8_t>( count & ( take - 1u ) );
+
+        // A state that holds gives an all ones hit, which selects the bits of its guard
+        Mask_T hit = static_cast<Mask_T>( 0u - static_cast<Mask_T>(table.states[i]) );
+        clearedBits |= hit & table.conditionBits[i];
+        triggersMask |= hit & table.triggerBits[i];
+    }
+}
@@ -0,0 +1,417 @@
+#ifndef _CONTROL_ENGINE_H
+#define _CONTROL_ENGINE_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ControlEngine.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of ControlEngine
+ *
+ *  Decision logic of the Host Timer without side effects: given the week
+ *  second and the values of the input/output channels, it computes the
+ *  program set points, the duty cycles, conditions and triggers masks and
+ *  the resulting relay set points (see HostTimer.h for their meaning).
+ *
+ *  Guards are compiled by configure() into flat tables, one per comparison
+ *  (>, <, >=, <=, ==, !=) with the input slot, level and relay bit of each
+ *  guard: a condition clears its bit when the comparison holds, a trigger
+ *  sets it. Every step looks up each distinct guard input once and builds
+ *  the conditions and triggers masks in one pass without branches.
+ *
+ *  Against relay chatter, e.g. a LOWER_THAN 20.0 condition on a temperature
+ *  hovering around 20.0, every guard can be tuned (setGuardTunings()) and
+ *  every relay timed (setRelayTimings()), with state kept between steps:
+ *      - Hysteresis: once a >, <, >= or <= comparison holds, it keeps holding
+ *        until the input crosses the level by the hysteresis band.
+ *      - Debounce: a new comparison result is taken after it lasts that many
+ *        consecutive ticks; the first step after configure() takes it at once.
+ *        Steps out of the tick cadence (digital input edges) do not count, so
+ *        a bouncing contact cannot complete the debounce within milliseconds;
+ *        a bounce back to the current result still restarts the count.
+ *      - Minimum on/off times: a relay that switched on stays on, and one that
+ *        switched off stays off, for at least those seconds, whatever the
+ *        program, duty cycle or guards ask.
+ *  Tunings are kept apart from Guard_T so that Program.guards records keep
+ *  their layout.
+ *
+ *  The engine owns no GPIO driver, file or clock: HostTimer feeds it with
+ *  real hardware and wall-clock time, FleetSimulator with simulated values,
+ *  so any number of independent engines can run in one process.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <map>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "RelayMask.h"
+#include "ProgramStorage.h"
+#include "ProgramTransitionIndex.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// BUILD FLAGS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Analog input channels: 4 per ADS1115, up to 16 with 4 chips (see GpioAnalogFrontEnd.h)
+#ifndef HOST_TIMER_NUM_AIN_CHANNELS
+#define HOST_TIMER_NUM_AIN_CHANNELS 4
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// GLOBAL CONSTANTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int          NUM_OUTPUT_RELAYS = HOST_TIMER_NUM_OUTPUT_RELAYS;   // See RelayMask.h
+const unsigned int           NUM_DIO_CHANNELS =  8u;
+const unsigned int           NUM_AIN_CHANNELS = HOST_TIMER_NUM_AIN_CHANNELS;
+const unsigned int          NUM_HOST_CHANNELS = NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS + NUM_AIN_CHANNELS;
+const unsigned int             MAX_NUM_GUARDS = 16u;
+const unsigned int              MAX_CHAR_SIZE = 30u;
+static_assert( NUM_AIN_CHANNELS >= 1u && NUM_AIN_CHANNELS <= 16u, "number of analog input channels must be from 1 to 16" );
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// DATA STRUCTURES
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Records of Program.channels and Program.guards files, shared by HostTimer and ControlEngine
+ */
+struct ControlTypes
+{
+    enum ChannelType_T
+    {
+        INPUT_DIGITAL,
+        INPUT_ANALOG,
+        OUTPUT_RELAY,
+        OUTPUT_DIGITAL,
+        OUTPUT_ANALOG,
+        INPUT_NTC_THERMISTOR,
+        NOT_CONNECTED
+    };
+
+    enum GuardType_T
+    {
+        CONDITION,
+        TRIGGER,
+        END_OF_GUARDS
+    };
+
+    struct Channel_T
+    {
+        uint8_t id;
+        char name[MAX_CHAR_SIZE];
+        ChannelType_T type;
+        char model[MAX_CHAR_SIZE];
+        uint8_t dutyCycle;
+    };
+
+    enum Threshold_T
+    {
+        MAXIMUM,
+        MINIMUM,
+        HIGHER_THAN,
+        LOWER_THAN,
+        EQUAL_TO,
+        UNEQUAL_TO
+    };
+
+    struct Guard_T
+    {
+        GuardType_T type;
+        uint8_t channelId;
+        uint8_t guardId;
+        Threshold_T guardThreshold;
+        float guardLevel;
+        // Pending to implement attribute "units" : char units[10];
+    };
+
+    /*
+     * Anti-chatter settings of a guard (see ControlEngine.h), all 0 for none
+     */
+    struct GuardTuning_T
+    {
+        float hysteresis;           // Band in units of the guard input
+        uint8_t debounce;           // Consecutive ticks of a new comparison result
+    };
+
+    /*
+     * Minimum seconds of a relay on after switching on, and off after switching off, all 0 for none
+     */
+    struct RelayTiming_T
+    {
+        uint32_t minOnSeconds;
+        uint32_t minOffSeconds;
+    };
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Default channels and readers of Program.channels and Program.guards files, shared by
+ * HostTimer, FleetSimulator and ScheduleReplay so that all of them run the same control law
+ */
+class ControlFiles : public Logs, public ControlTypes
+{
+  public:
+
+    /*
+     * Class constructor
+     */
+    ControlFiles(const char* instanceName) : Logs(instanceName)
+    {
+        logChannels_ = Logger::ERRORS;
+    }
+
+    /*
+     * Class destructor
+     */
+    ~ControlFiles() {}
+
+    /**
+     * Fills default channels: relays always enabled, then digital and analog inputs
+     * @param channels array of NUM_HOST_CHANNELS channels
+     */
+    static void setDefaultChannels(Channel_T* channels);
+
+    /**
+     * Reads channels file of NUM_HOST_CHANNELS records and checks the type of every channel
+     * against its position: relays, then digital inputs/outputs, then analog inputs
+     * Records past NUM_HOST_CHANNELS are discarded with a warning
+     * @param fileName of channels file
+     * @param channels array of NUM_HOST_CHANNELS channels, left unchanged on error
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result readChannels(const char* fileName, Channel_T* channels);
+
+    /**
+     * Reads guards file of up to MAX_NUM_GUARDS records
+     * Records past MAX_NUM_GUARDS are discarded with a warning
+     * @param fileName of guards file
+     * @param guards array of MAX_NUM_GUARDS guards, ended by END_OF_GUARDS if fewer are read
+     * @return Result RESULT_ERROR if file cannot be opened; guards are left unchanged
+     */
+    Result readGuards(const char* fileName, Guard_T* guards);
+};
+
+class ControlEngine : public Logs, public ControlTypes
+{
+  public:
+
+    /*
+     * Values of input/output channels by channel id
+     */
+    typedef std::map<uint8_t, float> IoValues_T;
+
+    /*
+     * Result of one control step
+     */
+    struct Outputs_T
+    {
+        Mask_T programSetpoints;
+        Mask_T dutyCyclesMask;
+        Mask_T conditionsMask;
+        Mask_T triggersMask;
+        Mask_T relaySetpoints;
+        Mask_T heldRelays;          // Relays kept by their minimum on/off times, included in relaySetpoints
+    };
+
+    /*
+     * Class constructor
+     */
+    ControlEngine(const char* instanceName);
+
+    /*
+     * Class destructor
+     */
+    ~ControlEngine();
+
+    /**
+     * Sets channels and guards
+     * @param channels array of NUM_HOST_CHANNELS channels
+     * @param guards array of up to MAX_NUM_GUARDS guards ended by END_OF_GUARDS, or nullptr for no guards
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result configure(const Channel_T* channels, const Guard_T* guards);
+
+    /**
+     * Sets anti-chatter tunings of guards; kept when guards are configured again
+     * @param tunings array of MAX_NUM_GUARDS tunings, by guard position, or nullptr for none
+     * @return Result RESULT_ERROR if a hysteresis is negative; tunings are left unchanged
+     */
+    Result setGuardTunings(const GuardTuning_T* tunings);
+
+    /**
+     * Sets minimum on/off times of relays
+     * @param timings array of NUM_OUTPUT_RELAYS timings, or nullptr for none
+     */
+    void setRelayTimings(const RelayTiming_T* timings);
+
+    /**
+     * Sets week program; channels must be configured first as duty cycles are indexed with it
+     * @param program mapped and validated week program, or nullptr for no program
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result setProgram(const ProgramStorage::ProgramImage* program);
+
+    /**
+     * Sets manual program instead of week program
+     * @param setpoints of relays while manual program lasts
+     * @param timeoutMinutes after which all relays are switched off
+     */
+    void setManualProgram(Mask_T setpoints, unsigned int timeoutMinutes);
+
+    /**
+     * Starts manual program at next step (see HostTimer.h)
+     */
+    void startManualProgram();
+
+    bool isManualProgram() const { return manualProgram_; }
+
+    bool hasGuards() const { return guards_[0].type != END_OF_GUARDS; }
+
+    const Channel_T & getChannel(unsigned int i) const { return channels_[i]; }
+
+    /**
+     * Computes set points and masks at weekSecond
+     * @param weekSecond from 0 to SECONDS_PER_WEEK - 1
+     * @param ioValues values of input/output channels
+     * @param outputs set points and masks
+     * @param tick false for steps out of the tick cadence, which do not advance guard debounce
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result step(long weekSecond, const IoValues_T & ioValues, Outputs_T & outputs, bool tick = true);
+
+    /**
+     * Composes conditions and triggers masks of guards in one pass
+     * @param ioValues values of input/output channels
+     * @param conditionsMask relays whose conditions hold
+     * @param triggersMask relays triggered
+     * @param tick false for evaluations out of the tick cadence, which do not advance guard debounce
+     */
+    void evaluateGuards(const IoValues_T & ioValues, Mask_T & conditionsMask, Mask_T & triggersMask, bool tick = true);
+
+    /**
+     * Seconds during which step() gives the same outputs whatever the inputs
+     * @param weekSecond from 0 to SECONDS_PER_WEEK - 1
+     * @return long number of seconds to next program transition, duty-cycle boundary or end of a minimum
+     *         on/off time of a held relay, or 0 if inputs must be sampled every tick (guards or manual program)
+     */
+    long secondsToNextEvent(long weekSecond) const;
+
+  private:
+
+    Channel_T channels_[NUM_HOST_CHANNELS];
+
+    Guard_T guards_[MAX_NUM_GUARDS];
+
+    ProgramTransitionIndex * programIndex_;
+
+    bool manualProgram_ = false;
+    bool manualModeOn_ = false;
+    long manualStartMinute_ = -1l;
+    Mask_T manualSetpoints_ = 0u;
+    unsigned int manualTimeout_ = 0u;
+
+    Mask_T programSetpoints_ = 0u;
+
+    GuardTuning_T guardTunings_[MAX_NUM_GUARDS];
+
+    /*
+     * Relay levels last output, week second of their last switch and relays held at last step
+     */
+    RelayTiming_T relayTimings_[NUM_OUTPUT_RELAYS];
+    bool relayStatesKnown_ = false;
+    Mask_T relayStates_ = 0u;
+    long switchSeconds_[NUM_OUTPUT_RELAYS];
+    Mask_T heldRelays_ = 0u;
+
+    /*
+     * Comparisons of guards: a Threshold_T is one of them for a condition and another for a trigger
+     */
+    enum Comparison_T
+    {
+        GREATER,
+        LESS,
+        GREATER_EQUAL,
+        LESS_EQUAL,
+        EQUAL,
+        UNEQUAL,
+        NUM_COMPARISONS
+    };
+
+    /*
+     * Guards of one comparison in structure of arrays: guard i compares inputValues_[slots[i]]
+     * with levels[i], or releaseLevels[i] while it holds, and after debounces[i] ticks of a new
+     * result takes it as states[i]; while that holds, it clears conditionBits[i] and sets triggerBits[i]
+     */
+    struct GuardTable_T
+    {
+        unsigned int size;
+        uint8_t slots[MAX_NUM_GUARDS];
+        float levels[MAX_NUM_GUARDS];
+        float releaseLevels[MAX_NUM_GUARDS];
+        uint8_t debounces[MAX_NUM_GUARDS];
+        Mask_T conditionBits[MAX_NUM_GUARDS];
+        Mask_T triggerBits[MAX_NUM_GUARDS];
+        uint8_t states[MAX_NUM_GUARDS];
+        uint8_t counts[MAX_NUM_GUARDS];
+    };
+    GuardTable_T guardTables_[NUM_COMPARISONS];
+
+    /*
+     * False until guards compiled are first evaluated, which takes comparison results at once
+     */
+    bool guardsPrimed_ = false;
+
+    /*
+     * Channel id and value of every distinct guard input slot
+     */
+    uint8_t inputIds_[MAX_NUM_GUARDS];
+    float inputValues_[MAX_NUM_GUARDS];
+    unsigned int numInputs_ = 0u;
+
+    /**
+     * Composes duty cycles mask based on second of minute and channels duty cycles
+     * @param second of minute
+     * @param Mask_T& resulted duty cycles mask
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result composeDutyCyclesMask(long second, Mask_T & mask);
+
+    /**
+     * Keeps relays that switched within their minimum on/off times
+     * @param weekSecond from 0 to SECONDS_PER_WEEK - 1
+     * @param setpoints relay set points, changed to the relays output
+     * @return Mask_T relays held
+     */
+    Mask_T applyRelayTimings(long weekSecond, Mask_T & setpoints);
+
+    /**
+     * Compiles guards_ and guardTunings_ into guardTables_
+     * @return Result RESULT_ERROR if a guard has an unknown threshold
+     */
+    Result compileGuards();
+
+    /**
+     * Evaluates guards of one comparison table without branches and updates their states
+     * @param table of guards
+     * @param inputValues of input slots
+     * @param primed false to take comparison results without debounce
+     * @param tick false to keep debounce counts, so only guards without debounce take new results
+     * @param holds comparison of value and level
+     * @param clearedBits of conditions mask, accumulated
+     * @param triggersMask accumulated
+     */
+    template <typename Comparison>
+    static void evaluateTable(GuardTable_T & table, const float* inputValues, bool primed, bool tick, Comparison holds,
+                              Mask_T & clearedBits, Mask_T & triggersMask);
+};
+
+#endif // _CONTROL_ENGINE_H
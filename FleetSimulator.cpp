@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   FleetSimulator.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements FleetSimulator class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FleetSimulator.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <algorithm>
+#include <bitset>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FORWARD DECLARATIONS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Xorshift pseudo-random generator: uniform value in [0, 1)
+ */
+static float nextRandom(uint32_t & seed)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return static_cast<float>( seed >> 8 ) / static_cast<float>( 1u << 24 );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+FleetSimulator::FleetSimulator(const char* instanceName, unsigned int numWorkers) : Logs(instanceName)
+{
+    logChannels_ = Logger::ERRORS;
+
+    ControlFiles::setDefaultChannels(channels_);
+    guards_[0].type = END_OF_GUARDS;
+    memset(guardTunings_, 0, sizeof(guardTunings_));
+    memset(relayTimings_, 0, sizeof(relayTimings_));
+
+    pool_ = new WorkStealingPool("FleetSimulatorPool", numWorkers);
+    ASSERT( pool_ != nullptr );
+}
+
+FleetSimulator::~FleetSimulator()
+{
+    delete pool_;
+    for ( Host_T* host : hosts_ )
+    {
+        delete host->engine;
+        delete host;
+    }
+    for ( auto & program : programs_ ) delete program.second;
+}
+
+Result FleetSimulator::loadChannels(const char* fileName)
+{
+    ControlFiles controlFiles("FleetSimulatorChannels");
+    return controlFiles.readChannels(fileName, channels_);
+}
+
+Result FleetSimulator::loadGuards(const char* fileName)
+{
+    ControlFiles controlFiles("FleetSimulatorGuards");
+    return controlFiles.readGuards(fileName, guards_);
+}
+
+Result FleetSimulator::setTunings(const GuardTuning_T* tunings, const RelayTiming_T* timings)
+{
+    for ( unsigned int i=0; tunings != nullptr && i < MAX_NUM_GUARDS; i++ )
+    {
+        if ( !( tunings[i].hysteresis >= 0.0f ) )
+        {
+            LOGGING(ERRORS, "ERROR hysteresis %.3f of guard %d must not be negative", tunings[i].hysteresis, i+1);
+            return RESULT_ERROR;
+        }
+    }
+
+    if ( tunings == nullptr ) memset(guardTunings_, 0, sizeof(guardTunings_));
+    else memcpy(guardTunings_, tunings, sizeof(guardTunings_));
+    if ( timings == nullptr ) memset(relayTimings_, 0, sizeof(relayTimings_));
+    else memcpy(relayTimings_, timings, sizeof(relayTimings_));
+
+    return RESULT_OK;
+}
+
+Result FleetSimulator::addHosts(unsigned int numHosts, const char* programFileName)
+{
+    // Hosts with the same program share its mapping
+    ProgramStorage* program;
+    auto it = programs_.find(programFileName);
+    if ( it != programs_.end() ) program = it->second;
+    else
+    {
+        program = new ProgramStorage("FleetSimulatorProgram");
+        ASSERT( program != nullptr );
+        if ( program->loadWeekProgram(programFileName, NUM_OUTPUT_RELAYS) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR loading program file %s", programFileName);
+            delete program;
+            return RESULT_ERROR;
+        }
+        programs_[programFileName] = program;
+    }
+
+    for ( unsigned int i=0; i < numHosts; i++ )
+    {
+        Host_T* host = new Host_T;
+        ASSERT( host != nullptr );
+        host->engine = new ControlEngine("FleetSimulatorEngine");
+        ASSERT( host->engine != nullptr );
+        if ( host->engine->configure(channels_, guards_) != RESULT_OK || host->engine->setGuardTunings(guardTunings_) != RESULT_OK ||
+             host->engine->setProgram(program->getImage()) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR configuring engine of host %zu", hosts_.size());
+            delete host->engine;
+            delete host;
+            return RESULT_ERROR;
+        }
+        host->engine->setRelayTimings(relayTimings_);
+        host->seed = 2463534242u + 7919u * hosts_.size();
+        host->offset = 4.0f * nextRandom(host->seed) - 2.0f;
+        host->relaySetpoints = 0u;
+        host->ticks = 0u;
+        host->relaySwitches = 0u;
+        host->relayTransitions = 0u;
+        host->errors = 0u;
+        hosts_.push_back(host);
+    }
+
+    LOGGING(INFO, "added %d hosts with program %s", numHosts, programFileName);
+
+    return RESULT_OK;
+}
+
+Result FleetSimulator::run(long startWeekSecond, long durationSeconds, Stats_T & stats)
+{
+    for ( Host_T* host : hosts_ )
+    {
+        host->ticks = 0u;
+        host->relaySwitches = 0u;
+        host->relayTransitions = 0u;
+        host->errors = 0u;
+    }
+    uint64_t steals = pool_->getStealCount();
+
+    unsigned int numShards = ( hosts_.size() + HOSTS_PER_SHARD - 1 ) / HOSTS_PER_SHARD;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    Result result = pool_->run(numShards, [this, startWeekSecond, durationSeconds] (unsigned int shard, unsigned int /*worker*/)
+                                          { runShard(shard, startWeekSecond, durationSeconds); });
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    stats.hosts = hosts_.size();
+    stats.workers = pool_->getNumWorkers();
+    stats.simulatedSeconds = durationSeconds;
+    stats.ticks = 0u;
+    stats.relaySwitches = 0u;
+    stats.relayTransitions = 0u;
+    stats.errors = 0u;
+    for ( Host_T* host : hosts_ )
+    {
+        stats.ticks += host->ticks;
+        stats.relaySwitches += host->relaySwitches;
+        stats.relayTransitions += host->relayTransitions;
+        stats.errors += host->errors;
+    }
+    stats.steals = pool_->getStealCount() - steals;
+    stats.wallSeconds = std::chrono::duration<double>(end - begin).count();
+    stats.ticksPerSecond = ( stats.wallSeconds > 0.0 ) ? stats.ticks / stats.wallSeconds : 0.0;
+    stats.ticksPerSecondPerCore = stats.ticksPerSecond / stats.workers;
+    double hostDays = static_cast<double>(stats.hosts) * durationSeconds / (24.0*60.0*60.0);
+    stats.relayTransitionsPerHostDay = ( hostDays > 0.0 ) ? stats.relayTransitions / hostDays : 0.0;
+
+    LOGGING(INFO, "simulated %d hosts for %ld s: %llu ticks in %.3f s, %.0f ticks/s, %.0f ticks/s/core, %llu errors",
+                  stats.hosts, durationSeconds, static_cast<unsigned long long>(stats.ticks), stats.wallSeconds,
+                  stats.ticksPerSecond, stats.ticksPerSecondPerCore, static_cast<unsigned long long>(stats.errors));
+
+    if ( result != RESULT_OK || stats.errors != 0u ) return RESULT_ERROR;
+
+    return RESULT_OK;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void FleetSimulator::runShard(unsigned int shard, long startWeekSecond, long durationSeconds)
+{
+    unsigned int last = std::min<size_t>( ( shard + 1 ) * HOSTS_PER_SHARD, hosts_.size() );
+    for ( unsigned int i = shard * HOSTS_PER_SHARD; i < last; i++ )
+    {
+        Host_T & host = *hosts_[i];
+        long elapsed = 0;
+        for ( long second = 0; second < durationSeconds; )
+        {
+            long weekSecond = ( startWeekSecond + second ) % SECONDS_PER_WEEK;
+            simulateInputs(host, weekSecond, elapsed);
+
+            ControlEngine::Outputs_T outputs;
+            if ( host.engine->step(weekSecond, host.ioValues, outputs) != RESULT_OK )
+            {
+                host.errors++;
+                break;
+            }
+            host.ticks++;
+            if ( outputs.relaySetpoints != host.relaySetpoints )
+            {
+                host.relaySwitches++;
+                host.relayTransitions += std::bitset<8*sizeof(Mask_T)>(outputs.relaySetpoints ^ host.relaySetpoints).count();
+                host.relaySetpoints = outputs.relaySetpoints;
+            }
+
+            // Same pacing as HostTimer: every second with guards, otherwise to next event
+            elapsed = std::max(host.engine->secondsToNextEvent(weekSecond), 1l);
+            second += elapsed;
+        }
+    }
+}
+
+void FleetSimulator::simulateInputs(Host_T & host, long weekSecond, long elapsedSeconds)
+{
+    const float PI = 3.14159265f;
+    float dayPhase = 2.0f * PI * static_cast<float>( weekSecond % (24*60*60) ) / (24.0f*60.0f*60.0f);
+
+    for ( const Channel_T & channel : channels_ )
+    {
+        switch ( channel.type )
+        {
+        case INPUT_ANALOG:
+        case INPUT_NTC_THERMISTOR:
+            host.ioValues[channel.id] = 20.0f - 10.0f * cosf(dayPhase) + host.offset + ( nextRandom(host.seed) - 0.5f );
+            break;
+        case INPUT_DIGITAL:
+            if ( nextRandom(host.seed) < static_cast<float>(elapsedSeconds) / 3600.0f )
+            {
+                host.ioValues[channel.id] = ( host.ioValues[channel.id] == 0.0f ) ? 1.0f : 0.0f;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
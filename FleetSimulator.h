@@ -0,0 +1,167 @@
+#ifndef _FLEET_SIMULATOR_H
+#define _FLEET_SIMULATOR_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   FleetSimulator.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of FleetSimulator
+ *
+ *  Runs many independent Host Timer control engines in one process to test
+ *  programs and guards at scale, e.g. a fleet-wide program rollout.
+ *
+ *  Every simulated host has its own ControlEngine, channels, guards and
+ *  simulated input/output values; hosts with the same .prog file share its
+ *  read-only mapping. Hosts are stepped in simulated time as HostTimer does
+ *  in wall-clock time: every second while guards need their inputs, and
+ *  otherwise straight to the next program transition or duty-cycle boundary.
+ *
+ *  Hosts are grouped in shards of HOSTS_PER_SHARD run as tasks of a
+ *  WorkStealingPool; the statistics report engine ticks (control steps) per
+ *  second of wall time and per worker thread.
+ *
+ *  Simulated inputs are deterministic for a given host number:
+ *      - Analog and NTC thermistor channels follow a daily cycle between 10 and 30
+ *        plus a host offset and noise.
+ *      - Digital inputs toggle at random with a mean period of one hour.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "ControlEngine.h"
+#include "ProgramStorage.h"
+#include "WorkStealingPool.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class FleetSimulator : public Logs, public ControlTypes
+{
+  public:
+
+    static const unsigned int HOSTS_PER_SHARD = 16u;
+
+    struct Stats_T
+    {
+        unsigned int hosts;
+        unsigned int workers;
+        long simulatedSeconds;
+        uint64_t ticks;             // Engine control steps of all hosts
+        uint64_t relaySwitches;     // Changes of relay set points of all hosts
+        uint64_t relayTransitions;  // Relays switched on or off, of all hosts
+        double relayTransitionsPerHostDay;
+        uint64_t errors;            // Failed control steps
+        uint64_t steals;            // Shards run by a worker other than the one they were dealt to
+        double wallSeconds;
+        double ticksPerSecond;
+        double ticksPerSecondPerCore;
+    };
+
+    /*
+     * Class constructor
+     * @param numWorkers number of worker threads, 0 for one per core
+     */
+    FleetSimulator(const char* instanceName, unsigned int numWorkers = 0u);
+
+    /*
+     * Class destructor
+     */
+    ~FleetSimulator();
+
+    /**
+     * Reads channels file used by hosts added afterwards; without it all relays
+     * have no duty cycle, channels 8 to 15 are digital inputs and 16 to 19 analog inputs
+     * Type of every channel is checked against its position (see ControlFiles::readChannels)
+     * @param fileName of channels file (format of Program.channels)
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result loadChannels(const char* fileName);
+
+    /**
+     * Reads guards file used by hosts added afterwards; without it hosts have no guards
+     * @param fileName of guards file (format of Program.guards)
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result loadGuards(const char* fileName);
+
+    /**
+     * Sets anti-chatter tunings of guards and minimum on/off times of relays of hosts added afterwards
+     * @param tunings array of MAX_NUM_GUARDS tunings, or nullptr for none
+     * @param timings array of NUM_OUTPUT_RELAYS timings, or nullptr for none
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result setTunings(const GuardTuning_T* tunings, const RelayTiming_T* timings);
+
+    /**
+     * Adds hosts running a week program with the current channels and guards
+     * @param numHosts number of hosts to add
+     * @param programFileName week program in format v1 or v2
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result addHosts(unsigned int numHosts, const char* programFileName);
+
+    unsigned int getNumHosts() const { return hosts_.size(); }
+
+    /**
+     * Runs all hosts over a period of simulated time
+     * @param startWeekSecond week second where simulation starts
+     * @param durationSeconds simulated seconds
+     * @param stats statistics of the run
+     * @return Result RESULT_OK in case all control steps succeeded
+     */
+    Result run(long startWeekSecond, long durationSeconds, Stats_T & stats);
+
+    /**
+     * Relay set points of a host at the end of last run
+     * @param host number, in order of addition
+     * @return Mask_T relay set points
+     */
+    Mask_T getRelaySetpoints(unsigned int host) const { return hosts_[host]->relaySetpoints; }
+
+  private:
+
+    struct Host_T
+    {
+        ControlEngine* engine;
+        ControlEngine::IoValues_T ioValues;
+        uint32_t seed;
+        float offset;
+        Mask_T relaySetpoints;
+        uint64_t ticks;
+        uint64_t relaySwitches;
+        uint64_t relayTransitions;
+        uint64_t errors;
+    };
+
+    std::vector<Host_T*> hosts_;
+
+    std::map<std::string, ProgramStorage*> programs_;
+
+    Channel_T channels_[NUM_HOST_CHANNELS];
+
+    Guard_T guards_[MAX_NUM_GUARDS];
+    GuardTuning_T guardTunings_[MAX_NUM_GUARDS];
+    RelayTiming_T relayTimings_[NUM_OUTPUT_RELAYS];
+
+    WorkStealingPool * pool_;
+
+    /**
+     * Runs hosts of one shard
+     */
+    void runShard(unsigned int shard, long startWeekSecond, long durationSeconds);
+
+    /**
+     * Updates simulated input/output values of host
+     */
+    void simulateInputs(Host_T & host, long weekSecond, long elapsedSeconds);
+};
+
+#endif // _FLEET_SIMULATOR_H
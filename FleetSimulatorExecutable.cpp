@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   FleetSimulatorExecutable.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements FleetSimulatorExecutable to run many Host Timer engines in one process
+ *
+ *  usage: FleetSimulator -p <program.prog> [-p <program.prog> ...] [-n <hosts>] [-d <days>]
+ *                        [-t <threads>] [-c <Program.channels>] [-g <Program.guards>]
+ *                        [-y <hysteresis milli>] [-b <debounce ticks>] [-m <relay minimum on/off seconds>]
+ *
+ *  Hosts are spread evenly over the given programs. Hysteresis and debounce apply to all guards,
+ *  minimum on/off times to all relays, so that relay transitions per host and day can be
+ *  compared without and with them. Prints the statistics of the run
+ *  and 0 on success or 1 on error as last line.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FleetSimulator.h"
+#include <stdlib.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "FleetSimulator.logs";
+
+int main( int argc, const char* argv[] )
+{
+    std::vector<std::string> programFileNames;
+    std::string channelsFileName, guardsFileName;
+    unsigned int numHosts = 1000u, numThreads = 0u;
+    long days = 7l;
+    long hysteresisMilli = 0l, debounce = 0l, minSeconds = 0l;
+
+    for ( int i=1; i + 1 < argc; i += 2 )
+    {
+        std::string param = argv[i];
+        if      ( param == "-p" ) programFileNames.push_back(argv[i+1]);
+        else if ( param == "-n" ) numHosts = atoi(argv[i+1]);
+        else if ( param == "-d" ) days = atol(argv[i+1]);
+        else if ( param == "-t" ) numThreads = atoi(argv[i+1]);
+        else if ( param == "-c" ) channelsFileName = argv[i+1];
+        else if ( param == "-g" ) guardsFileName = argv[i+1];
+        else if ( param == "-y" ) hysteresisMilli = atol(argv[i+1]);
+        else if ( param == "-b" ) debounce = atol(argv[i+1]);
+        else if ( param == "-m" ) minSeconds = atol(argv[i+1]);
+        else
+        {
+            programFileNames.clear();
+            break;
+        }
+    }
+    if ( programFileNames.empty() || numHosts == 0u || days <= 0l || argc % 2 == 0 ||
+         hysteresisMilli < 0l || debounce < 0l || debounce > 255l || minSeconds < 0l )
+    {
+        std::cout << "usage: FleetSimulator -p <program.prog> [-p <program.prog> ...] [-n <hosts>] [-d <days>]" << std::endl;
+        std::cout << "                      [-t <threads>] [-c <Program.channels>] [-g <Program.guards>]" << std::endl;
+        std::cout << "                      [-y <hysteresis milli>] [-b <debounce ticks>] [-m <relay minimum on/off seconds>]" << std::endl;
+        return 2;
+    }
+
+    FleetSimulator fleetSimulator("FleetSimulator", numThreads);
+
+    Result result = RESULT_OK;
+    if ( !channelsFileName.empty() && fleetSimulator.loadChannels(channelsFileName.c_str()) != RESULT_OK ) result = RESULT_ERROR;
+    if ( !guardsFileName.empty() && fleetSimulator.loadGuards(guardsFileName.c_str()) != RESULT_OK ) result = RESULT_ERROR;
+
+    ControlTypes::GuardTuning_T tunings[MAX_NUM_GUARDS];
+    for ( ControlTypes::GuardTuning_T & tuning : tunings ) tuning = { hysteresisMilli * 1e-3f, static_cast<uint8_t>(debounce) };
+    ControlTypes::RelayTiming_T timings[NUM_OUTPUT_RELAYS];
+    for ( ControlTypes::RelayTiming_T & timing : timings ) timing = { static_cast<uint32_t>(minSeconds), static_cast<uint32_t>(minSeconds) };
+    if ( result == RESULT_OK && fleetSimulator.setTunings(tunings, timings) != RESULT_OK ) result = RESULT_ERROR;
+    for ( unsigned int i=0; i < programFileNames.size() && result == RESULT_OK; i++ )
+    {
+        unsigned int hosts = numHosts / programFileNames.size() + ( i < numHosts % programFileNames.size() ? 1u : 0u );
+        result = fleetSimulator.addHosts(hosts, programFileNames[i].c_str());
+    }
+
+    FleetSimulator::Stats_T stats;
+    if ( result == RESULT_OK )
+    {
+        result = fleetSimulator.run(0l, days*24l*60l*60l, stats);
+
+        std::cout << "hosts: " << stats.hosts << std::endl;
+        std::cout << "worker threads: " << stats.workers << std::endl;
+        std::cout << "simulated seconds: " << stats.simulatedSeconds << std::endl;
+        std::cout << "engine ticks: " << stats.ticks << std::endl;
+        std::cout << "relay switches: " << stats.relaySwitches << std::endl;
+        std::cout << "relay transitions: " << stats.relayTransitions << std::endl;
+        std::cout << "relay transitions/host/day: " << stats.relayTransitionsPerHostDay << std::endl;
+        std::cout << "errors: " << stats.errors << std::endl;
+        std::cout << "shards stolen: " << stats.steals << std::endl;
+        std::cout << "wall seconds: " << stats.wallSeconds << std::endl;
+        std::cout << "ticks/s: " << stats.ticksPerSecond << std::endl;
+        std::cout << "ticks/s/core: " << stats.ticksPerSecondPerCore << std::endl;
+    }
+
+    if ( result == RESULT_OK ) std::cout << "0" << std::endl;
+    else                       std::cout << "1" << std::endl;
+
+    return ( result == RESULT_OK ) ? 0 : 1;
+}
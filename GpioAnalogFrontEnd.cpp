@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioAnalogFrontEnd.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioAnalogFrontEnd class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GpioAnalogFrontEnd.h"
+#include <string>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GpioAnalogFrontEnd::GpioAnalogFrontEnd(const char* instanceName, II2cBus* bus, unsigned char numChips,
+                                       GpioAnalogRaspberryPi2BAds1115::Pga_T pga, GpioAnalogRaspberryPi2BAds1115::DataRate_T dataRate)
+:   IComponent(instanceName),
+    numChips_(numChips)
+{
+    // Enable errors log channel
+    logChannels_ = Logger::ERRORS;
+
+    assert( numChips_ >= 1 && numChips_ <= MAX_NUM_CHIPS );
+    for ( unsigned char chip = 0; chip < MAX_NUM_CHIPS; chip++ )
+    {
+        chips_[chip] = nullptr;
+        if ( chip >= numChips_ ) continue;
+        std::string chipName = std::string(instanceName) + "Ads1115_" + std::to_string(chip);
+        chips_[chip] = new GpioAnalogRaspberryPi2BAds1115(chipName.c_str(), bus, static_cast<uint8_t>(ADS1115_ADDRESS + chip), pga, dataRate);
+        ASSERT( chips_[chip] != nullptr );
+    }
+    for ( unsigned char id = 0; id < MAX_NUM_INPUTS; id++ )
+    {
+        oversampling_[id] = 1;
+        sums_[id] = 0;
+    }
+}
+
+GpioAnalogFrontEnd::~GpioAnalogFrontEnd()
+{
+    for ( unsigned char chip = 0; chip < MAX_NUM_CHIPS; chip++ ) delete chips_[chip];
+}
+
+Result GpioAnalogFrontEnd::initialize()
+{
+    sampledMask_ = 0u;
+    for ( unsigned char chip = 0; chip < numChips_; chip++ )
+    {
+        if ( chips_[chip]->initialize() != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR initializing ADS1115 %d at address 0x%02x", chip, ADS1115_ADDRESS + chip);
+            return RESULT_ERROR;
+        }
+    }
+    LOGGING(INFO, "%d ADS1115 with %d analog inputs", numChips_, getNumInputs());
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogFrontEnd::getVoltage(unsigned char id, float &voltage)
+{
+    if ( id >= getNumInputs() )
+    {
+        LOGGING(ERRORS, "ERROR analog input %d out of range of %d inputs", id, getNumInputs());
+        return RESULT_ERROR;
+    }
+    int32_t sum = sums_[id];
+    if ( ( ( sampledMask_ >> id ) & 1u ) == 0u && convert(id, sum) != RESULT_OK ) return RESULT_ERROR;
+    voltage = static_cast<float>(sum) / oversampling_[id] * ( getFullScale() / 32768 );
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogFrontEnd::getCode(unsigned char id, int16_t & code)
+{
+    if ( id >= getNumInputs() )
+    {
+        LOGGING(ERRORS, "ERROR analog input %d out of range of %d inputs", id, getNumInputs());
+        return RESULT_ERROR;
+    }
+    int32_t sum = sums_[id];
+    if ( ( ( sampledMask_ >> id ) & 1u ) == 0u && convert(id, sum) != RESULT_OK ) return RESULT_ERROR;
+
+    // Rounded to nearest, halves away from zero
+    int32_t half = oversampling_[id] / 2;
+    code = static_cast<int16_t>( ( sum >= 0 ) ? ( sum + half ) / oversampling_[id] : ( sum - half ) / oversampling_[id] );
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogFrontEnd::sampleInputs(InputMask_T mask)
+{
+    sampledMask_ = 0u;
+    if ( ( mask >> getNumInputs() ) != 0u )
+    {
+        LOGGING(ERRORS, "ERROR analog input mask 0x%04x out of range of %d inputs", mask, getNumInputs());
+        return RESULT_ERROR;
+    }
+
+    unsigned int pending[MAX_NUM_CHIPS];
+    for ( unsigned char chip = 0; chip < numChips_; chip++ ) pending[chip] = ( mask >> ( chip * CHIP_INPUTS ) ) & 0xFu;
+
+    while ( true )
+    {
+        // Switch every chip with inputs left, keeping the input being converted if pending
+        unsigned char inputs[MAX_NUM_CHIPS];
+        GpioAnalogRaspberryPi2BAds1115* switchChips[MAX_NUM_CHIPS];
+        unsigned char switchInputs[MAX_NUM_CHIPS];
+        unsigned int numSwitches = 0u;
+        bool done = true;
+        for ( unsigned char chip = 0; chip < numChips_; chip++ )
+        {
+            inputs[chip] = CHIP_INPUTS;
+            if ( pending[chip] == 0u ) continue;
+            done = false;
+            unsigned char current = chips_[chip]->getInput();
+            for ( unsigned char i = 0; i < CHIP_INPUTS; i++ )
+            {
+                unsigned char input = ( current + i ) % CHIP_INPUTS;
+                if ( ( ( pending[chip] >> input ) & 1u ) != 0u )
+                {
+                    inputs[chip] = input;
+                    break;
+                }
+            }
+            if ( inputs[chip] == current ) continue;
+            switchChips[numSwitches] = chips_[chip];
+            switchInputs[numSwitches++] = inputs[chip];
+        }
+        if ( done ) break;
+        if ( GpioAnalogRaspberryPi2BAds1115::switchInputs(switchChips, switchInputs, numSwitches) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR switching inputs of %d ADS1115", numSwitches);
+            return RESULT_ERROR;
+        }
+
+        // Chips waited for one after the other keep converting meanwhile
+        for ( unsigned char chip = 0; chip < numChips_; chip++ )
+        {
+            if ( inputs[chip] == CHIP_INPUTS ) continue;
+            unsigned char id = chip * CHIP_INPUTS + inputs[chip];
+            if ( convert(id, sums_[id]) != RESULT_OK )
+            {
+                LOGGING(ERRORS, "ERROR sampling analog input %d", id);
+                return RESULT_ERROR;
+            }
+            pending[chip] &= ~( 1u << inputs[chip] );
+        }
+    }
+    sampledMask_ = mask;
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogFrontEnd::setOversampling(unsigned char id, unsigned int oversampling)
+{
+    if ( id >= getNumInputs() || oversampling < 1u || oversampling > MAX_OVERSAMPLING )
+    {
+        LOGGING(ERRORS, "ERROR oversampling %d of analog input %d, must be 1 to %d", oversampling, id, MAX_OVERSAMPLING);
+        return RESULT_ERROR;
+    }
+    oversampling_[id] = static_cast<unsigned char>(oversampling);
+    sampledMask_ &= static_cast<InputMask_T>( ~( 1u << id ) );
+
+    return RESULT_OK;
+}
+
+void GpioAnalogFrontEnd::setReadyWait(unsigned char chip, const GpioAnalogRaspberryPi2BAds1115::ReadyWait_T & readyWait)
+{
+    if ( chip < numChips_ ) chips_[chip]->setReadyWait(readyWait);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result GpioAnalogFrontEnd::convert(unsigned char id, int32_t & sum)
+{
+    GpioAnalogRaspberryPi2BAds1115 * chip = chips_[id / CHIP_INPUTS];
+    unsigned char input = id % CHIP_INPUTS;
+
+    int16_t code = 0;
+    if ( chip->getCode(input, code) != RESULT_OK ) return RESULT_ERROR;
+    int32_t codes = code;
+    for ( unsigned int i=1; i < oversampling_[id]; i++ )
+    {
+        if ( chip->waitConversion() != RESULT_OK || chip->getCode(input, code) != RESULT_OK ) return RESULT_ERROR;
+        codes += code;
+    }
+    sum = codes;
+    sampleCount_ += oversampling_[id];
+
+    return RESULT_OK;
+}
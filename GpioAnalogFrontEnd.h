@@ -0,0 +1,150 @@
+#ifndef _GPIO_ANALOG_FRONT_END_H
+#define _GPIO_ANALOG_FRONT_END_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioAnalogFrontEnd.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of GpioAnalogFrontEnd
+ *
+ *  Analog inputs of up to MAX_NUM_CHIPS ADS1115 on one I2C bus, at
+ *  addresses 0x48 to 0x4B (ADDR pin to GND, VDD, SDA and SCL). Input id is
+ *  chip * 4 + multiplexer input, so chip 0 keeps ids 0 to 3.
+ *
+ *  sampleInputs() converts a set of inputs with a round-robin scheduler:
+ *  at every step each chip with inputs left is switched to its next one,
+ *  all in one bus transaction, then the step waits for the chips one after
+ *  the other and reads them.
+ *  While one chip is being waited for or read, the others are already
+ *  converting, so a step costs about one multiplexer switch whatever the
+ *  number of chips, and samples per second grow with the number of chips.
+ *
+ *  An input with oversampling n (setOversampling(), 1 to MAX_OVERSAMPLING)
+ *  averages n consecutive conversions, keeping the fraction of LSB.
+ *
+ *  getVoltage() returns the voltage sampled by the last sampleInputs() if
+ *  the input was in its mask, otherwise converts the input on its own.
+ *  Not thread safe: one thread samples the inputs.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include "LenamDevs_types.h"
+#include "IComponent.h"
+#include "IGpio.h"
+#include "II2cBus.h"
+#include "GpioAnalogRaspberryPi2BAds1115.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class GpioAnalogFrontEnd : public IComponent, public IGpio
+{
+  public:
+
+    static const unsigned char MAX_NUM_CHIPS = 4;
+    static const unsigned char CHIP_INPUTS = GpioAnalogRaspberryPi2BAds1115::NUMBER_CHANNELS;
+    static const unsigned char MAX_NUM_INPUTS = MAX_NUM_CHIPS * CHIP_INPUTS;
+    static const unsigned char MAX_OVERSAMPLING = 16;
+
+    /*
+     * Bit i is input id i
+     */
+    typedef uint16_t InputMask_T;
+
+    /*
+     * Class constructor
+     * @param bus I2C bus of the ADC's, not owned
+     * @param numChips number of ADS1115, at consecutive addresses from ADS1115_ADDRESS
+     */
+    GpioAnalogFrontEnd(const char* instanceName, II2cBus* bus, unsigned char numChips = 1,
+                       GpioAnalogRaspberryPi2BAds1115::Pga_T pga = GpioAnalogRaspberryPi2BAds1115::PGA_4_096V,
+                       GpioAnalogRaspberryPi2BAds1115::DataRate_T dataRate = GpioAnalogRaspberryPi2BAds1115::DR_128_SPS);
+
+    /*
+     * Class destructor
+     */
+    ~GpioAnalogFrontEnd();
+
+    /*
+     * Initializes all chips; every chip must answer
+     */
+    Result initialize();
+
+    Result start() { return RESULT_OK; }
+
+    void shutdown() {}
+
+    Result setMode(unsigned char gpioId, GpioMode_T mode) { return RESULT_UNIMPLEMENTED; }
+
+    Result getLevel(unsigned char id, signed int& level) const { return RESULT_UNIMPLEMENTED; }
+
+    Result setLevel(unsigned char id, signed int level) { return RESULT_UNIMPLEMENTED; }
+
+    Result getVoltage(unsigned char id, float &voltage) override;
+
+    /**
+     * Code of input, sampled by last sampleInputs() if in its mask
+     * @param id of input
+     * @param code conversion result rounded mean of oversampling, full scale is 32768
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result getCode(unsigned char id, int16_t & code);
+
+    /**
+     * Converts inputs of mask, overlapping the conversions of the chips
+     * @param mask of input ids; inputs of missing chips are not allowed
+     * @return Result RESULT_OK in case of correct execution; on error no sample is kept
+     */
+    Result sampleInputs(InputMask_T mask);
+
+    /**
+     * Sets conversions averaged by every sample of input
+     * @param id of input
+     * @param oversampling 1 to MAX_OVERSAMPLING
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result setOversampling(unsigned char id, unsigned int oversampling);
+
+    /**
+     * Waits on ALERT/RDY of chip instead of sleeping the conversion time
+     */
+    void setReadyWait(unsigned char chip, const GpioAnalogRaspberryPi2BAds1115::ReadyWait_T & readyWait);
+
+    unsigned char getNumChips() const { return numChips_; }
+
+    unsigned char getNumInputs() const { return numChips_ * CHIP_INPUTS; }
+
+    float getFullScale() const { return chips_[0]->getFullScale(); }
+
+    /*
+     * Conversions read, oversampling included
+     */
+    uint64_t getSampleCount() const { return sampleCount_; }
+
+  private:
+
+    unsigned char numChips_;
+    GpioAnalogRaspberryPi2BAds1115 * chips_[MAX_NUM_CHIPS];
+
+    /*
+     * Sums of the oversampled codes of last sampleInputs() and their mask
+     */
+    unsigned char oversampling_[MAX_NUM_INPUTS];
+    int32_t sums_[MAX_NUM_INPUTS];
+    InputMask_T sampledMask_ = 0u;
+    uint64_t sampleCount_ = 0u;
+
+    /**
+     * Sums oversampling conversions of input, starting with the first one after a switch to it
+     * @param id of input
+     * @param sum of codes
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result convert(unsigned char id, int32_t & sum);
+};
+
+#endif // _GPIO_ANALOG_FRONT_END_H
@@ -0,0 +1,281 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioAnalogRaspberryPi2BAds1115.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioAnalogRaspberryPi2BAds1115 class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GpioAnalogRaspberryPi2BAds1115.h"
+#include <math.h>
+#include <thread>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// STATIC CONSTANTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const float GpioAnalogRaspberryPi2BAds1115::FULL_SCALE_VOLTS[6] = { 6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f };
+
+const unsigned int GpioAnalogRaspberryPi2BAds1115::SAMPLES_PER_SECOND[8] = { 8u, 16u, 32u, 64u, 128u, 250u, 475u, 860u };
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GpioAnalogRaspberryPi2BAds1115::GpioAnalogRaspberryPi2BAds1115(const char* instanceName, II2cBus* bus, uint8_t address,
+                                                               Pga_T pga, DataRate_T dataRate)
+:   IComponent(instanceName),
+    bus_(bus),
+    address_(address),
+    pga_(pga),
+    dataRate_(dataRate)
+{
+    // Enable errors log channel
+    logChannels_ = Logger::ERRORS;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::initialize()
+{
+    assert( bus_ != nullptr );
+
+    mux_ = NUMBER_CHANNELS;
+
+    // ALERT/RDY as conversion ready signal
+    if ( writeRegister(ADS1115_REG_LO_THRESH, ADS1115_RDY_LO_THRESH) != RESULT_OK ||
+         writeRegister(ADS1115_REG_HI_THRESH, ADS1115_RDY_HI_THRESH) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR setting thresholds of ADS1115 at address 0x%02x", address_);
+        return RESULT_ERROR;
+    }
+
+    // Continuous conversion of input 0; the config read back proves the device is there
+    if ( switchInput(0) != RESULT_OK || waitInput() != RESULT_OK ) return RESULT_ERROR;
+    uint16_t config = 0u;
+    if ( readRegister(ADS1115_REG_CONFIG, config) != RESULT_OK || ( config & ~ADS1115_CONFIG_OS ) != configOf(0) )
+    {
+        LOGGING(ERRORS, "ERROR ADS1115 at address 0x%02x read back config 0x%04x instead of 0x%04x", address_, config, configOf(0));
+        mux_ = NUMBER_CHANNELS;
+        return RESULT_ERROR;
+    }
+    LOGGING(INFO, "ADS1115 at address 0x%02x converting continuously at %d SPS with full scale %.3f V",
+                  address_, SAMPLES_PER_SECOND[dataRate_], FULL_SCALE_VOLTS[pga_]);
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::getVoltage(unsigned char id, float &voltage)
+{
+    int16_t adcRead = 0;
+    Result result = getCode(id, adcRead);
+    if ( result != RESULT_OK ) return result;
+    voltage = adcRead * ( FULL_SCALE_VOLTS[pga_] / 32768 );
+
+    // Conversion noise is not logged: only changes of 1/256 of full scale
+    if ( fabsf(voltage - previousValues_[id]) >= FULL_SCALE_VOLTS[pga_] / 256 )
+    {
+        LOGGING(INFO, "id:%d adcRead:%d voltage:%1f", id, adcRead, voltage);
+        previousValues_[id] = voltage;
+    }
+    else
+    {
+        LOGGING(VERBOSE, "id:%d adcRead:%d voltage:%1f", id, adcRead, voltage);
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::getCode(unsigned char id, int16_t & code)
+{
+    if ( id >= NUMBER_CHANNELS )
+    {
+        LOGGING(ERRORS, "ERROR analog input %d out of range", id);
+        return RESULT_ERROR;
+    }
+    if ( id != mux_ && switchInput(id) != RESULT_OK ) return RESULT_ERROR;
+    if ( waitInput() != RESULT_OK ) return RESULT_ERROR;
+
+    uint16_t conversion = 0u;
+    if ( readRegister(ADS1115_REG_CONVERSION, conversion) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR reading conversion of input %d of ADS1115 at address 0x%02x", id, address_);
+        return RESULT_ERROR;
+    }
+    code = static_cast<int16_t>(conversion);
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::getVoltages(float voltages[NUMBER_CHANNELS])
+{
+    unsigned char first = ( mux_ < NUMBER_CHANNELS ) ? mux_ : 0;
+    for ( unsigned char i=0; i < NUMBER_CHANNELS; i++ )
+    {
+        unsigned char id = ( first + i ) % NUMBER_CHANNELS;
+        if ( getVoltage(id, voltages[id]) != RESULT_OK ) return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::switchInput(unsigned char id)
+{
+    if ( id >= NUMBER_CHANNELS )
+    {
+        LOGGING(ERRORS, "ERROR analog input %d out of range", id);
+        return RESULT_ERROR;
+    }
+    if ( writeRegister(ADS1115_REG_CONFIG, configOf(id)) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR switching ADS1115 at address 0x%02x to input %d", address_, id);
+        mux_ = NUMBER_CHANNELS;
+        return RESULT_ERROR;
+    }
+    mux_ = id;
+    switchTime_ = std::chrono::steady_clock::now();
+    settled_ = false;
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::switchInputs(GpioAnalogRaspberryPi2BAds1115* chips[], const unsigned char ids[], unsigned int numChips)
+{
+    if ( numChips == 0u ) return RESULT_OK;
+    assert( numChips <= ADS1115_NUM_ADDRESSES );
+
+    // One config register write per chip
+    uint8_t data[ADS1115_NUM_ADDRESSES][3];
+    II2cBus::Message_T messages[ADS1115_NUM_ADDRESSES];
+    for ( unsigned int i=0; i < numChips; i++ )
+    {
+        assert( chips[i]->bus_ == chips[0]->bus_ );
+        if ( ids[i] >= NUMBER_CHANNELS ) return RESULT_ERROR;
+        uint16_t config = chips[i]->configOf(ids[i]);
+        data[i][0] = ADS1115_REG_CONFIG;
+        data[i][1] = static_cast<uint8_t>(config >> 8);
+        data[i][2] = static_cast<uint8_t>(config & 0xFFu);
+        messages[i].address = chips[i]->address_;
+        messages[i].read = false;
+        messages[i].data = data[i];
+        messages[i].size = sizeof(data[i]);
+    }
+
+    Result result = chips[0]->bus_->transfer(messages, numChips);
+    std::chrono::steady_clock::time_point switchTime = std::chrono::steady_clock::now();
+    for ( unsigned int i=0; i < numChips; i++ )
+    {
+        // A failed batch may have switched some chips: none is known
+        chips[i]->mux_ = ( result == RESULT_OK ) ? ids[i] : NUMBER_CHANNELS;
+        chips[i]->switchTime_ = switchTime;
+        chips[i]->settled_ = false;
+    }
+
+    return result;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::waitInput()
+{
+    if ( mux_ >= NUMBER_CHANNELS ) return RESULT_ERROR;
+    if ( settled_ ) return RESULT_OK;
+
+    // Conversion in progress may be of previous input: wait for it and for a complete one
+    unsigned int periodUs = 1000000u / SAMPLES_PER_SECOND[dataRate_];
+    if ( readyWait_ )
+    {
+        for ( unsigned int i=0; i < 2u; i++ )
+        {
+            if ( readyWait_(2u * periodUs + 1000u) != RESULT_OK )
+            {
+                LOGGING(ERRORS, "ERROR no ALERT/RDY pulse of ADS1115 at address 0x%02x", address_);
+                mux_ = NUMBER_CHANNELS;
+                return RESULT_ERROR;
+            }
+        }
+    }
+    else
+    {
+        // Internal oscillator may run 10% slow; time spent since the switch is not slept again
+        std::this_thread::sleep_until( switchTime_ + std::chrono::microseconds( 2u * periodUs + periodUs / 5u + 100u ) );
+    }
+    settled_ = true;
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::waitConversion()
+{
+    if ( mux_ >= NUMBER_CHANNELS || !settled_ ) return waitInput();
+
+    unsigned int periodUs = 1000000u / SAMPLES_PER_SECOND[dataRate_];
+    if ( readyWait_ )
+    {
+        if ( readyWait_(2u * periodUs + 1000u) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR no ALERT/RDY pulse of ADS1115 at address 0x%02x", address_);
+            mux_ = NUMBER_CHANNELS;
+            return RESULT_ERROR;
+        }
+    }
+    else
+    {
+        // A conversion ends within any period, 10% slow oscillator included
+        std::this_thread::sleep_for( std::chrono::microseconds( periodUs + periodUs / 10u + 50u ) );
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::toDataRate(int32_t samplesPerSecond, DataRate_T & dataRate)
+{
+    for ( unsigned int i=0; i < sizeof(SAMPLES_PER_SECOND)/sizeof(SAMPLES_PER_SECOND[0]); i++ )
+    {
+        if ( static_cast<int32_t>(SAMPLES_PER_SECOND[i]) != samplesPerSecond ) continue;
+        dataRate = static_cast<DataRate_T>(i);
+        return RESULT_OK;
+    }
+
+    return RESULT_ERROR;
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::toPga(int32_t fullScaleMv, Pga_T & pga)
+{
+    for ( unsigned int i=0; i < sizeof(FULL_SCALE_VOLTS)/sizeof(FULL_SCALE_VOLTS[0]); i++ )
+    {
+        if ( static_cast<int32_t>( FULL_SCALE_VOLTS[i] * 1000.0f + 0.5f ) != fullScaleMv ) continue;
+        pga = static_cast<Pga_T>(i);
+        return RESULT_OK;
+    }
+
+    return RESULT_ERROR;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t GpioAnalogRaspberryPi2BAds1115::configOf(unsigned char id) const
+{
+    // Continuous mode, traditional comparator active low, ALERT/RDY asserted after each conversion
+    return static_cast<uint16_t>( ( ( ADS1115_MUX_SINGLE_AIN0 + id ) << ADS1115_CONFIG_MUX_SHIFT ) |
+                                  ( pga_ << ADS1115_CONFIG_PGA_SHIFT ) | ( dataRate_ << ADS1115_CONFIG_DR_SHIFT ) );
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::writeRegister(uint8_t reg, uint16_t value)
+{
+    // Register pointer, then value MSB first
+    uint8_t data[3] = { reg, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFFu) };
+
+    return bus_->write(address_, data, sizeof(data));
+}
+
+Result GpioAnalogRaspberryPi2BAds1115::readRegister(uint8_t reg, uint16_t & value)
+{
+    uint8_t data[2];
+    if ( bus_->writeRead(address_, &reg, 1u, data, sizeof(data)) != RESULT_OK ) return RESULT_ERROR;
+    value = static_cast<uint16_t>( ( data[0] << 8 ) | data[1] );
+
+    return RESULT_OK;
+}
@@ -8,23 +8,65 @@
  *  @date   July 2018
  *  @brief  Definition of GpioAnalogRaspberryPi2BAds1115
  *
- *  Function to be documented.
+ *  Analog inputs of an ADS1115 16-bit ADC, driven through its registers
+ *  over an II2cBus (I2cRaspberryPi2B on /dev/i2c-1, or a stand-in such as
+ *  SimulatedAds1115 in tests).
+ *
+ *  The ADC runs in continuous-conversion mode with configurable PGA (full
+ *  scale) and data rate, each input single-ended against GND:
+ *      - Reading the input being converted is one register read: the
+ *        conversion register always holds the latest conversion.
+ *      - Reading another input switches the multiplexer and waits for the
+ *        conversion in progress and a complete one: the first conversion
+ *        after the switch may still be of the previous input.
+ *      - getVoltages() sequences the multiplexer across the 4 inputs,
+ *        starting at the one being converted.
+ *      - waitConversion() waits for the next conversion of the same input,
+ *        to average several of them (oversampling).
+ *      - switchInput() and waitInput() split a switch, so that several
+ *        ADC's convert at once (see GpioAnalogFrontEnd); switchInputs()
+ *        switches them with one bus transaction.
+ *  The thresholds are set so that ALERT/RDY pulses at the end of every
+ *  conversion. If that pin is wired (setReadyWait()), the driver waits for
+ *  it; otherwise it sleeps the conversion time at the data rate.
+ *
+ *  Not thread safe: one thread samples the inputs.
  */
 /////////////////////////////////////////////////////////////////////////////
 
 #include <stdint.h>
 #include <array>
+#include <chrono>
+#include <functional>
 #include "LenamDevs_types.h"
 #include "IComponent.h"
 #include "IGpio.h"
-#include <wiringPi.h>
-#include <ads1115.h>
+#include "II2cBus.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // GLOBAL CONSTANTS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+const uint8_t ADS1115_ADDRESS = 0x48u;              // ADDR pin to GND
+const unsigned int ADS1115_NUM_ADDRESSES = 4u;      // 0x48 to 0x4B, ADDR pin to GND, VDD, SDA or SCL
+
+// Registers and config register fields (ADS111x datasheet, section 9.6)
+const uint8_t  ADS1115_REG_CONVERSION     = 0x00u;
+const uint8_t  ADS1115_REG_CONFIG         = 0x01u;
+const uint8_t  ADS1115_REG_LO_THRESH      = 0x02u;
+const uint8_t  ADS1115_REG_HI_THRESH      = 0x03u;
+const uint16_t ADS1115_CONFIG_OS          = 0x8000u;   // Start single-shot conversion / not converting
+const unsigned ADS1115_CONFIG_MUX_SHIFT   = 12u;
+const uint16_t ADS1115_CONFIG_MUX_MASK    = 0x7000u;
+const uint16_t ADS1115_MUX_SINGLE_AIN0    = 0x4u;      // AIN0 to AIN3 against GND are 0x4 to 0x7
+const unsigned ADS1115_CONFIG_PGA_SHIFT   = 9u;
+const uint16_t ADS1115_CONFIG_MODE_SINGLE = 0x0100u;
+const unsigned ADS1115_CONFIG_DR_SHIFT    = 5u;
+const uint16_t ADS1115_CONFIG_COMP_QUE_DISABLE = 0x0003u;   // Other values enable ALERT/RDY
+const uint16_t ADS1115_RDY_HI_THRESH      = 0x8000u;   // MSB of Hi_thresh 1 and of Lo_thresh 0:
+const uint16_t ADS1115_RDY_LO_THRESH      = 0x0000u;   // ALERT/RDY pulses at every conversion end
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // CLASS DECLARATION
@@ -35,56 +77,156 @@ class GpioAnalogRaspberryPi2BAds1115 : public IComponent, public IGpio
   public:
 
     /*
-     * Class constructor 
+     * Programmable gain amplifier, by full scale voltage
+     */
+    enum Pga_T { PGA_6_144V = 0, PGA_4_096V, PGA_2_048V, PGA_1_024V, PGA_0_512V, PGA_0_256V };
+
+    /*
+     * Data rate, in samples per second
+     */
+    enum DataRate_T { DR_8_SPS = 0, DR_16_SPS, DR_32_SPS, DR_64_SPS, DR_128_SPS, DR_250_SPS, DR_475_SPS, DR_860_SPS };
+
+    /*
+     * Waits for a pulse of ALERT/RDY, for at most timeoutUs; RESULT_OK if it came
+     */
+    typedef std::function<Result(unsigned int timeoutUs)> ReadyWait_T;
+
+    static const unsigned char NUMBER_CHANNELS = 4;
+
+    /*
+     * Class constructor
+     * @param bus I2C bus of the ADC, not owned
+     * @param address 7-bit I2C address of the ADC
      */
-    GpioAnalogRaspberryPi2BAds1115(const char* instanceName) : IComponent(instanceName)
-    {
-        // Enable errors log channel
-        logChannels_ = Logger::ERRORS;
-    }
+    GpioAnalogRaspberryPi2BAds1115(const char* instanceName, II2cBus* bus, uint8_t address = ADS1115_ADDRESS,
+                                   Pga_T pga = PGA_4_096V, DataRate_T dataRate = DR_128_SPS);
 
     /*
-     * Class destructor 
+     * Class destructor
      */
     ~GpioAnalogRaspberryPi2BAds1115() {}
 
-    Result initialize() { ads1115Setup(100,0x48); return RESULT_OK; }
+    /*
+     * Sets ALERT/RDY as conversion ready signal and starts continuous conversion of input 0
+     */
+    Result initialize();
 
     Result start() { return RESULT_OK; }
 
-    void shutdown() {} 
-    
+    void shutdown() {}
+
     Result setMode(unsigned char gpioId, GpioMode_T mode) { return RESULT_UNIMPLEMENTED; }
 
     Result getLevel(unsigned char id, signed int& level) const { return RESULT_UNIMPLEMENTED; }
-    
+
     Result setLevel(unsigned char id, signed int level) { return RESULT_UNIMPLEMENTED; }
 
-    Result getVoltage(unsigned char id, float &voltage) override
-    {
-        assert( id < NUMBER_CHANNELS_ );
+    Result getVoltage(unsigned char id, float &voltage) override;
+
+    /**
+     * Reads latest conversion of input, switching the multiplexer to it if needed
+     * @param id of input, 0 to 3
+     * @param code conversion result, full scale is 32768
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result getCode(unsigned char id, int16_t & code);
 
-        int16_t adcRead = (int16_t)analogRead(100 + (int16_t)id); 
-        voltage = adcRead * (4.096 / 32768);
+    /**
+     * Reads all inputs, sequencing the multiplexer from the input being converted
+     * @param voltages of inputs 0 to 3
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result getVoltages(float voltages[NUMBER_CHANNELS]);
 
-        if ( voltage != previousValues_[id] )
-        {
-            LOGGING(INFO, "id:%d adcRead:%d voltage:%1f", id, adcRead, voltage);
-            previousValues_[id] = voltage;
-        }
-        else
-        {
-            LOGGING(VERBOSE, "id:%d adcRead:%d voltage:%1f", id, adcRead, voltage);
-        }
+    /**
+     * Switches multiplexer to input without waiting for its conversion, so that other
+     * ADC's can be switched meanwhile; see waitInput()
+     * @param id of input, 0 to 3
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result switchInput(unsigned char id);
+
+    /**
+     * Switches multiplexers of ADC's sharing one bus in one batched transaction; see switchInput()
+     * @param chips ADC's to switch, at most ADS1115_NUM_ADDRESSES
+     * @param ids input of every chip, 0 to 3
+     * @param numChips number of chips
+     * @return Result RESULT_OK in case of correct execution; on error no chip is switched
+     */
+    static Result switchInputs(GpioAnalogRaspberryPi2BAds1115* chips[], const unsigned char ids[], unsigned int numChips);
 
-        return RESULT_OK;
-    }
+    /**
+     * Waits until a complete conversion of the input switched to is available;
+     * returns at once if it already is
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result waitInput();
+
+    /**
+     * Waits until a conversion after the one last read is available, to oversample the input
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result waitConversion();
+
+    /*
+     * Input being converted, NUMBER_CHANNELS if conversion is not started
+     */
+    unsigned char getInput() const { return mux_; }
+
+    /**
+     * Waits on ALERT/RDY instead of sleeping the conversion time
+     * @param readyWait function waiting for the pin, e.g. on a GPIO edge; empty to sleep
+     */
+    void setReadyWait(const ReadyWait_T & readyWait) { readyWait_ = readyWait; }
+
+    float getFullScale() const { return FULL_SCALE_VOLTS[pga_]; }
+
+    unsigned int getSamplesPerSecond() const { return SAMPLES_PER_SECOND[dataRate_]; }
+
+    /**
+     * Data rate of samples per second, which must be one of the ADS1115 rates
+     * @return Result RESULT_OK if rate is supported
+     */
+    static Result toDataRate(int32_t samplesPerSecond, DataRate_T & dataRate);
+
+    /**
+     * PGA of full scale in millivolts, which must be one of the ADS1115 full scales
+     * @return Result RESULT_OK if full scale is supported
+     */
+    static Result toPga(int32_t fullScaleMv, Pga_T & pga);
 
   private:
 
-    static const unsigned char NUMBER_CHANNELS_ = 4;
+    static const float FULL_SCALE_VOLTS[6];
+    static const unsigned int SAMPLES_PER_SECOND[8];
+
+    II2cBus * bus_;
+    uint8_t address_;
+    Pga_T pga_;
+    DataRate_T dataRate_;
+    ReadyWait_T readyWait_;
+
+    /*
+     * Input being converted, NUMBER_CHANNELS if conversion is not started
+     */
+    unsigned char mux_ = NUMBER_CHANNELS;
+
+    /*
+     * Time of last multiplexer switch, and whether a conversion of the input has completed since
+     */
+    std::chrono::steady_clock::time_point switchTime_;
+    bool settled_ = false;
+
+    std::array<float, NUMBER_CHANNELS> previousValues_ { { 0.0, 0.0, 0.0, 0.0 } };
+
+    /**
+     * Config register of continuous conversion of input
+     */
+    uint16_t configOf(unsigned char id) const;
+
+    Result writeRegister(uint8_t reg, uint16_t value);
 
-    std::array<float, NUMBER_CHANNELS_> previousValues_ { { 0.0, 0.0, 0.0, 0.0 } };
+    Result readRegister(uint8_t reg, uint16_t & value);
 };
 
 #endif // _GPIORASPBERRYPI2BADS1115_H
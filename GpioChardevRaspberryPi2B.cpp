@@ -0,0 +1,286 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioChardevRaspberryPi2B.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioChardevRaspberryPi2B class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GpioChardevRaspberryPi2B.h"
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GpioChardevRaspberryPi2B::GpioChardevRaspberryPi2B(const char* instanceName, const char* chipName) : IComponent(instanceName), chipName_(chipName)
+{
+    logChannels_ = Logger::ERRORS;
+
+    for ( uint8_t i=0; i < NUM_GPIOS; i++ ) lineFlags_[i] = GPIO_V2_LINE_FLAG_INPUT;
+}
+
+Result GpioChardevRaspberryPi2B::initialize()
+{
+    shutdown();
+
+    int chipFd = open(chipName_.c_str(), O_RDWR | O_CLOEXEC);
+    if ( chipFd < 0 )
+    {
+        LOGGING(ERRORS, "ERROR opening GPIO chip %s with errno %d", chipName_.c_str(), errno);
+        return RESULT_ERROR;
+    }
+
+    struct gpio_v2_line_request request;
+    memset(&request, 0, sizeof(request));
+    for ( uint8_t i=0; i < NUM_GPIOS; i++ ) request.offsets[i] = GPIO_NUMBERS_RASPBERRY_PI_2B[i];
+    strncpy(request.consumer, "HostTimer", sizeof(request.consumer) - 1);
+    request.num_lines = NUM_GPIOS;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT;
+    int result = ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request);
+    close(chipFd);
+    if ( result < 0 )
+    {
+        LOGGING(ERRORS, "ERROR requesting %d lines of GPIO chip %s with errno %d", NUM_GPIOS, chipName_.c_str(), errno);
+        return RESULT_ERROR;
+    }
+    lineFd_ = request.fd;
+
+    // Edge events are read without blocking
+    if ( fcntl(lineFd_, F_SETFL, fcntl(lineFd_, F_GETFL) | O_NONBLOCK) < 0 )
+    {
+        LOGGING(ERRORS, "ERROR setting line request non-blocking with errno %d", errno);
+        shutdown();
+        return RESULT_ERROR;
+    }
+
+    for ( uint8_t i=0; i < NUM_GPIOS; i++ ) lineFlags_[i] = GPIO_V2_LINE_FLAG_INPUT;
+    outputLevels_ = 0u;
+
+    LOGGING(INFO, "requested %d lines of GPIO chip %s", NUM_GPIOS, chipName_.c_str());
+
+    return RESULT_OK;
+}
+
+void GpioChardevRaspberryPi2B::shutdown()
+{
+    if ( lineFd_ >= 0 )
+    {
+        close(lineFd_);
+        lineFd_ = -1;
+    }
+}
+
+Result GpioChardevRaspberryPi2B::setMode(uint8_t gpioId, GpioMode_T mode)
+{
+    if ( gpioId >= NUM_GPIOS )
+    {
+        LOGGING(ERRORS, "ERROR GPIO ID %d out of range", gpioId);
+        return RESULT_ERROR;
+    }
+
+    switch (mode)
+    {
+      case INPUT_DIGITAL:
+        lineFlags_[gpioId] = GPIO_V2_LINE_FLAG_INPUT;
+        break;
+      case INPUT_DIGITAL_INVERTED:
+        lineFlags_[gpioId] = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+        break;
+      case OUTPUT_DIGITAL:
+        lineFlags_[gpioId] = GPIO_V2_LINE_FLAG_OUTPUT;
+        break;
+      case OUTPUT_DIGITAL_INVERTED:
+        lineFlags_[gpioId] = GPIO_V2_LINE_FLAG_OUTPUT | GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+        break;
+      default:
+        LOGGING(ERRORS, "ERROR GPIO mode %d unkwown", mode);
+        return RESULT_ERROR;
+    }
+
+    // Outputs start at level low
+    outputLevels_ &= ~( 1u << gpioId );
+
+    return applyLineConfig();
+}
+
+Result GpioChardevRaspberryPi2B::getLevel(uint8_t gpioId, signed int& level) const
+{
+    GpioMask_T levels;
+    if ( gpioId >= NUM_GPIOS || getLevels(1u << gpioId, levels) != RESULT_OK ) return RESULT_ERROR;
+    level = ( levels != 0u ) ? 1 : 0;
+
+    return RESULT_OK;
+}
+
+Result GpioChardevRaspberryPi2B::setLevel(uint8_t gpioId, signed int level)
+{
+    if ( level != 0 && level != 1 )
+    {
+        LOGGING(ERRORS, "ERROR level %d is not supported", level);
+        return RESULT_ERROR;
+    }
+    if ( gpioId >= NUM_GPIOS )
+    {
+        LOGGING(ERRORS, "ERROR GPIO ID %d out of range", gpioId);
+        return RESULT_ERROR;
+    }
+
+    return setLevels(1u << gpioId, static_cast<GpioMask_T>(level) << gpioId);
+}
+
+Result GpioChardevRaspberryPi2B::setLevels(GpioMask_T mask, GpioMask_T levels)
+{
+    if ( ( mask >> NUM_GPIOS ) != 0u )
+    {
+        LOGGING(ERRORS, "ERROR GPIO mask 0x%x out of range", mask);
+        return RESULT_ERROR;
+    }
+
+    struct gpio_v2_line_values values;
+    values.mask = mask;
+    values.bits = levels & mask;
+    if ( ioctl(lineFd_, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0 )
+    {
+        LOGGING(ERRORS, "ERROR setting levels 0x%x of GPIO mask 0x%x with errno %d", levels & mask, mask, errno);
+        return RESULT_ERROR;
+    }
+    outputLevels_ = ( outputLevels_ & ~mask ) | ( levels & mask );
+
+    // Check levels are set correctly
+    GpioMask_T getLevels;
+    if ( this->getLevels(mask, getLevels) != RESULT_OK || getLevels != ( levels & mask ) )
+    {
+        LOGGING(ERRORS, "unable to set levels 0x%x of GPIO mask 0x%x", levels & mask, mask);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioChardevRaspberryPi2B::getLevels(GpioMask_T mask, GpioMask_T & levels) const
+{
+    if ( ( mask >> NUM_GPIOS ) != 0u ) return RESULT_ERROR;
+
+    struct gpio_v2_line_values values;
+    values.mask = mask;
+    values.bits = 0u;
+    if ( ioctl(lineFd_, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0 ) return RESULT_ERROR;
+    levels = static_cast<GpioMask_T>( values.bits & mask );
+
+    return RESULT_OK;
+}
+
+
+Result GpioChardevRaspberryPi2B::setEdges(GpioMask_T mask)
+{
+    if ( ( mask >> NUM_GPIOS ) != 0u )
+    {
+        LOGGING(ERRORS, "ERROR GPIO mask 0x%x out of range", mask);
+        return RESULT_ERROR;
+    }
+
+    const uint64_t EDGE_FLAGS = GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    for ( uint8_t i=0; i < NUM_GPIOS; i++ )
+    {
+        if ( ( ( mask >> i ) & 1u ) == 0u )
+        {
+            lineFlags_[i] &= ~EDGE_FLAGS;
+        }
+        else if ( lineFlags_[i] & GPIO_V2_LINE_FLAG_INPUT )
+        {
+            lineFlags_[i] |= EDGE_FLAGS;
+        }
+        else
+        {
+            LOGGING(ERRORS, "ERROR edges requested on output GPIO ID %d", i);
+            return RESULT_ERROR;
+        }
+    }
+
+    return applyLineConfig();
+}
+
+Result GpioChardevRaspberryPi2B::readEdges(GpioMask_T & edges, int64_t & timestampNs)
+{
+    edges = 0u;
+    timestampNs = 0;
+
+    struct gpio_v2_line_event events[NUM_GPIOS];
+    while (1)
+    {
+        ssize_t length = read(lineFd_, events, sizeof(events));
+        if ( length < 0 )
+        {
+            if ( errno == EAGAIN ) break;
+            if ( errno == EINTR ) continue;
+            LOGGING(ERRORS, "ERROR reading line events with errno %d", errno);
+            return RESULT_ERROR;
+        }
+        for ( unsigned int i=0; i < length / sizeof(struct gpio_v2_line_event); i++ )
+        {
+            for ( uint8_t gpioId = 0; gpioId < NUM_GPIOS; gpioId++ )
+            {
+                if ( GPIO_NUMBERS_RASPBERRY_PI_2B[gpioId] == events[i].offset ) edges |= ( 1u << gpioId );
+            }
+            if ( timestampNs == 0 ) timestampNs = static_cast<int64_t>(events[i].timestamp_ns);
+        }
+        if ( length < static_cast<ssize_t>(sizeof(events)) ) break;
+    }
+
+    return RESULT_OK;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result GpioChardevRaspberryPi2B::applyLineConfig()
+{
+    struct gpio_v2_line_config config;
+    memset(&config, 0, sizeof(config));
+    config.flags = GPIO_V2_LINE_FLAG_INPUT;
+
+    // One flags attribute per distinct mode other than plain input
+    GpioMask_T outputMask = 0u;
+    for ( uint8_t i=0; i < NUM_GPIOS; i++ )
+    {
+        if ( lineFlags_[i] & GPIO_V2_LINE_FLAG_OUTPUT ) outputMask |= ( 1u << i );
+        if ( lineFlags_[i] == GPIO_V2_LINE_FLAG_INPUT ) continue;
+
+        unsigned int attr = 0u;
+        while ( attr < config.num_attrs && config.attrs[attr].attr.flags != lineFlags_[i] ) attr++;
+        if ( attr == config.num_attrs )
+        {
+            config.attrs[attr].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+            config.attrs[attr].attr.flags = lineFlags_[i];
+            config.num_attrs++;
+        }
+        config.attrs[attr].mask |= ( 1ull << i );
+    }
+
+    // Output lines keep their levels
+    if ( outputMask != 0u )
+    {
+        struct gpio_v2_line_config_attribute & attr = config.attrs[config.num_attrs++];
+        attr.attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        attr.attr.values = outputLevels_ & outputMask;
+        attr.mask = outputMask;
+    }
+
+    if ( ioctl(lineFd_, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0 )
+    {
+        LOGGING(ERRORS, "ERROR setting line configuration with errno %d", errno);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
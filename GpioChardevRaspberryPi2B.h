@@ -0,0 +1,117 @@
+#ifndef _GPIO_CHARDEV_RASPBERRYPI2B_H
+#define _GPIO_CHARDEV_RASPBERRYPI2B_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioChardevRaspberryPi2B.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of GpioChardevRaspberryPi2B
+ *
+ *  Digital GPIO's of the Raspberry Pi through the GPIO character device
+ *  (/dev/gpiochipN, v2 uAPI, Linux 5.10 or later).
+ *
+ *  All GPIO's are requested in one line request, line i being GPIO Id i.
+ *  setLevels() and getLevels() are one ioctl each, so all relays switch
+ *  at the same time; setLevels() verifies with one more ioctl. Modes are
+ *  applied to the whole request as one line configuration, keeping the
+ *  levels of the other output lines.
+ *
+ *  Edges are detected by the kernel on lines with the edge flags set, and
+ *  queued with their CLOCK_MONOTONIC timestamps as events readable from the
+ *  line request file descriptor, which is also the edge file descriptor.
+ *
+ *  GPIO's exported in sysfs are busy for the character device: use either
+ *  this backend or GpioRaspberryPi2B (GPIO_CHARDEV in HostTimer.consts).
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include "LenamDevs_types.h"
+#include "IComponent.h"
+#include "IGpioBulk.h"
+#include "GpioRaspberryPi2B.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// GLOBAL CONSTANTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char GPIO_CHIP_NAME[20] = "/dev/gpiochip0";
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class GpioChardevRaspberryPi2B : public IComponent, public IGpioBulk
+{
+  public:
+
+    /*
+     * Class constructor 
+     * @param chipName GPIO character device
+     */
+    GpioChardevRaspberryPi2B(const char* instanceName, const char* chipName = GPIO_CHIP_NAME);
+
+    /*
+     * Class destructor 
+     */
+    ~GpioChardevRaspberryPi2B() { shutdown(); }
+
+    /*
+     * Requests all GPIO lines as inputs
+     */
+    Result initialize();
+
+    Result start() { return RESULT_OK; }
+
+    /*
+     * Releases GPIO lines
+     */
+    void shutdown();
+
+    Result setMode(uint8_t gpioId, GpioMode_T mode);
+
+    Result getLevel(uint8_t gpioId, signed int& level) const;
+
+    Result setLevel(uint8_t gpioId, signed int level);
+
+    Result getVoltage(uint8_t id, float &voltage) { return RESULT_UNIMPLEMENTED; }
+
+    Result setLevels(GpioMask_T mask, GpioMask_T levels);
+
+    Result getLevels(GpioMask_T mask, GpioMask_T & levels) const;
+
+    Result setEdges(GpioMask_T mask);
+
+    int getEdgeFd() const { return lineFd_; }
+
+    Result readEdges(GpioMask_T & edges, int64_t & timestampNs);
+
+  private:
+
+    static const uint8_t NUM_GPIOS = sizeof(GPIO_NUMBERS_RASPBERRY_PI_2B);
+
+    std::string chipName_;
+
+    int lineFd_ = -1;
+
+    /*
+     * Line flags of GPIO Id (GPIO_V2_LINE_FLAG_*)
+     */
+    uint64_t lineFlags_[NUM_GPIOS];
+
+    /*
+     * Levels of output lines, kept when line configuration is applied
+     */
+    GpioMask_T outputLevels_ = 0u;
+
+    /**
+     * Applies lineFlags_ and outputLevels_ to line request
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result applyLineConfig();
+};
+
+#endif // _GPIO_CHARDEV_RASPBERRYPI2B_H
@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioMemRaspberryPi2B.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioMemRaspberryPi2B class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GpioMemRaspberryPi2B.h"
+#include <sys/mman.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GpioMemRaspberryPi2B::GpioMemRaspberryPi2B(const char* instanceName, const char* memName) : IComponent(instanceName), memName_(memName)
+{
+    logChannels_ = Logger::ERRORS;
+
+    memcpy(gpioIdNumber_, GPIO_NUMBERS_RASPBERRY_PI_2B, sizeof(gpioIdNumber_));
+}
+
+Result GpioMemRaspberryPi2B::initialize()
+{
+    shutdown();
+
+    int memFd = open(memName_.c_str(), O_RDWR | O_SYNC | O_CLOEXEC);
+    if ( memFd < 0 )
+    {
+        LOGGING(ERRORS, "ERROR opening GPIO memory %s with errno %d", memName_.c_str(), errno);
+        return RESULT_ERROR;
+    }
+    void * block = mmap(NULL, GPIO_MEM_BLOCK_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+    close(memFd);
+    if ( block == MAP_FAILED )
+    {
+        LOGGING(ERRORS, "ERROR mapping GPIO memory %s with errno %d", memName_.c_str(), errno);
+        return RESULT_ERROR;
+    }
+    registers_ = static_cast<volatile uint32_t *>(block);
+    invertedMask_ = 0u;
+
+    LOGGING(INFO, "mapped GPIO registers of %s", memName_.c_str());
+
+    return RESULT_OK;
+}
+
+void GpioMemRaspberryPi2B::shutdown()
+{
+    if ( registers_ != nullptr )
+    {
+        munmap(const_cast<uint32_t *>(registers_), GPIO_MEM_BLOCK_SIZE);
+        registers_ = nullptr;
+    }
+}
+
+Result GpioMemRaspberryPi2B::setMode(uint8_t gpioId, GpioMode_T mode)
+{
+    uint32_t function;
+
+    if ( gpioId >= NUM_GPIOS || registers_ == nullptr )
+    {
+        LOGGING(ERRORS, "ERROR GPIO ID %d out of range", gpioId);
+        return RESULT_ERROR;
+    }
+
+    switch (mode)
+    {
+      case INPUT_DIGITAL:
+      case INPUT_DIGITAL_INVERTED:
+        function = 0u;
+        break;
+      case OUTPUT_DIGITAL:
+      case OUTPUT_DIGITAL_INVERTED:
+        function = 1u;
+        break;
+      default:
+        LOGGING(ERRORS, "ERROR GPIO mode %d unkwown", mode);
+        return RESULT_ERROR;
+    }
+    if ( mode == INPUT_DIGITAL_INVERTED || mode == OUTPUT_DIGITAL_INVERTED ) invertedMask_ |= ( 1u << gpioId );
+    else                                                                    invertedMask_ &= ~( 1u << gpioId );
+
+    // Outputs start at level low: latched before the pin is driven
+    uint8_t number = gpioIdNumber_[gpioId];
+    if ( function == 1u )
+    {
+        if ( ( invertedMask_ >> gpioId ) & 1u ) reg(GPIO_REG_GPSET0) = ( 1u << number );
+        else                                    reg(GPIO_REG_GPCLR0) = ( 1u << number );
+    }
+
+    // Function select: 10 GPIO's of 3 bits per GPFSELn register
+    volatile uint32_t & gpfsel = reg(GPIO_REG_GPFSEL0 + ( number / 10u ) * sizeof(uint32_t));
+    unsigned int shift = ( number % 10u ) * 3u;
+    gpfsel = ( gpfsel & ~( 7u << shift ) ) | ( function << shift );
+    LOGGING(VERBOSE, "set GPIO# %d function %d", number, function);
+
+    // Check init level of output
+    GpioMask_T level;
+    if ( function == 1u && ( getLevels(1u << gpioId, level) != RESULT_OK || level != 0u ) )
+    {
+        LOGGING(ERRORS, "ERROR setting GPIO# %d to init level 0", number);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioMemRaspberryPi2B::getLevel(uint8_t gpioId, signed int& level) const
+{
+    GpioMask_T levels;
+    if ( gpioId >= NUM_GPIOS || getLevels(1u << gpioId, levels) != RESULT_OK ) return RESULT_ERROR;
+    level = ( levels != 0u ) ? 1 : 0;
+
+    return RESULT_OK;
+}
+
+Result GpioMemRaspberryPi2B::setLevel(uint8_t gpioId, signed int level)
+{
+    if ( level != 0 && level != 1 )
+    {
+        LOGGING(ERRORS, "ERROR level %d is not supported", level);
+        return RESULT_ERROR;
+    }
+    if ( gpioId >= NUM_GPIOS )
+    {
+        LOGGING(ERRORS, "ERROR GPIO ID %d out of range", gpioId);
+        return RESULT_ERROR;
+    }
+
+    return setLevels(1u << gpioId, static_cast<GpioMask_T>(level) << gpioId);
+}
+
+Result GpioMemRaspberryPi2B::setLevels(GpioMask_T mask, GpioMask_T levels)
+{
+    if ( ( mask >> NUM_GPIOS ) != 0u || registers_ == nullptr )
+    {
+        LOGGING(ERRORS, "ERROR GPIO mask 0x%x out of range", mask);
+        return RESULT_ERROR;
+    }
+
+    // Pin levels, after inversion of inverted modes
+    GpioMask_T pinLevels = ( levels ^ invertedMask_ ) & mask;
+    reg(GPIO_REG_GPSET0) = toPinBits(pinLevels);
+    reg(GPIO_REG_GPCLR0) = toPinBits(mask & ~pinLevels);
+
+    // Check levels are set correctly
+    GpioMask_T getLevels;
+    if ( this->getLevels(mask, getLevels) != RESULT_OK || getLevels != ( levels & mask ) )
+    {
+        LOGGING(ERRORS, "unable to set levels 0x%x of GPIO mask 0x%x", levels & mask, mask);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioMemRaspberryPi2B::getLevels(GpioMask_T mask, GpioMask_T & levels) const
+{
+    if ( ( mask >> NUM_GPIOS ) != 0u || registers_ == nullptr ) return RESULT_ERROR;
+
+    uint32_t pinLevels = reg(GPIO_REG_GPLEV0);
+    levels = 0u;
+    for ( uint8_t gpioId = 0; gpioId < NUM_GPIOS; gpioId++ )
+    {
+        if ( ( pinLevels >> gpioIdNumber_[gpioId] ) & 1u ) levels |= ( 1u << gpioId );
+    }
+    levels = ( levels ^ invertedMask_ ) & mask;
+
+    return RESULT_OK;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t GpioMemRaspberryPi2B::toPinBits(GpioMask_T mask) const
+{
+    uint32_t pinBits = 0u;
+    for ( uint8_t gpioId = 0; gpioId < NUM_GPIOS; gpioId++ )
+    {
+        if ( ( mask >> gpioId ) & 1u ) pinBits |= ( 1u << gpioIdNumber_[gpioId] );
+    }
+
+    return pinBits;
+}
@@ -0,0 +1,132 @@
+#ifndef _GPIO_MEM_RASPBERRYPI2B_H
+#define _GPIO_MEM_RASPBERRYPI2B_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioMemRaspberryPi2B.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of GpioMemRaspberryPi2B
+ *
+ *  Digital GPIO's of the Raspberry Pi through the GPIO registers of the
+ *  BCM2836, mapped in memory from /dev/gpiomem (no root needed).
+ *
+ *  Once mapped, no access makes a system call:
+ *      - setLevels() sets all high GPIO's of the mask with one store to
+ *        GPSET0 and all low ones with one store to GPCLR0, so no other
+ *        GPIO is touched and no read-modify-write is needed.
+ *      - getLevels() is one load from GPLEV0.
+ *      - setMode() writes the 3 function select bits of the GPIO in GPFSELn.
+ *  The hardware has no active low setting: inverted modes are applied by
+ *  software to the levels set and got.
+ *
+ *  The mapped file is a constructor parameter, so that a plain file of
+ *  GPIO_MEM_BLOCK_SIZE bytes can stand in for /dev/gpiomem in tests, which
+ *  then read the registers written and write the levels to be read.
+ *
+ *  No edge detection: use GpioRaspberryPi2B or GpioChardevRaspberryPi2B
+ *  for interrupt driven inputs.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include "LenamDevs_types.h"
+#include "IComponent.h"
+#include "IGpioBulk.h"
+#include "GpioRaspberryPi2B.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// GLOBAL CONSTANTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char GPIO_MEM_NAME[20] = "/dev/gpiomem";
+
+// GPIO register block and byte offsets of its registers (BCM2835 ARM Peripherals, section 6.1)
+const unsigned int GPIO_MEM_BLOCK_SIZE = 4096u;
+const unsigned int GPIO_REG_GPFSEL0    = 0x00u;
+const unsigned int GPIO_REG_GPSET0     = 0x1Cu;
+const unsigned int GPIO_REG_GPCLR0     = 0x28u;
+const unsigned int GPIO_REG_GPLEV0     = 0x34u;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class GpioMemRaspberryPi2B : public IComponent, public IGpioBulk
+{
+  public:
+
+    /*
+     * Class constructor
+     * @param memName file mapped as GPIO register block
+     */
+    GpioMemRaspberryPi2B(const char* instanceName, const char* memName = GPIO_MEM_NAME);
+
+    /*
+     * Class destructor
+     */
+    ~GpioMemRaspberryPi2B() { shutdown(); }
+
+    /*
+     * Maps GPIO register block
+     */
+    Result initialize();
+
+    Result start() { return RESULT_OK; }
+
+    /*
+     * Unmaps GPIO register block
+     */
+    void shutdown();
+
+    Result setMode(uint8_t gpioId, GpioMode_T mode);
+
+    Result getLevel(uint8_t gpioId, signed int& level) const;
+
+    Result setLevel(uint8_t gpioId, signed int level);
+
+    Result getVoltage(uint8_t id, float &voltage) { return RESULT_UNIMPLEMENTED; }
+
+    /**
+     * Sets levels with one store to GPSET0 and one to GPCLR0, then verifies them in GPLEV0
+     */
+    Result setLevels(GpioMask_T mask, GpioMask_T levels);
+
+    Result getLevels(GpioMask_T mask, GpioMask_T & levels) const;
+
+  private:
+
+    static const uint8_t NUM_GPIOS = sizeof(GPIO_NUMBERS_RASPBERRY_PI_2B);
+
+    std::string memName_;
+
+    volatile uint32_t * registers_ = nullptr;
+
+    /*
+     * Correspondence between GPIO Id and Number
+     */
+    uint8_t gpioIdNumber_[NUM_GPIOS];
+
+    /*
+     * GPIO Ids in inverted modes
+     */
+    GpioMask_T invertedMask_ = 0u;
+
+    /**
+     * Register word
+     * @param offset byte offset of register
+     * @return volatile uint32_t & register
+     */
+    volatile uint32_t & reg(unsigned int offset) const { return registers_[offset / sizeof(uint32_t)]; }
+
+    /**
+     * Bits of GPIO numbers of GPIO Ids of mask, as in GPSET0, GPCLR0 and GPLEV0
+     * @param mask of GPIO Ids
+     * @return uint32_t bit n set for GPIO number n
+     */
+    uint32_t toPinBits(GpioMask_T mask) const;
+};
+
+#endif // _GPIO_MEM_RASPBERRYPI2B_H
@@ -11,16 +11,30 @@
 #include "CommonGlobalsWebTimer.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/epoll.h>
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // PUBLIC METHODS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-GpioRaspberryPi2B::GpioRaspberryPi2B(const char* instanceName) : IComponent(instanceName)
+GpioRaspberryPi2B::GpioRaspberryPi2B(const char* instanceName, const char* sysfsRoot) : IComponent(instanceName), sysfsRoot_(sysfsRoot)
 {
     logChannels_ = Logger::VERBOSE;
+
+    numGpios_ = 0u;
+    for ( unsigned int i=0; i < MAX_NUM_GPIOS; i++ )
+    {
+        valueFd_[i] = -1;
+        directionFd_[i] = -1;
+        activeLowFd_[i] = -1;
+        edgeFd_[i] = -1;
+    }
 }
 
 Result GpioRaspberryPi2B::initialize()
@@ -32,114 +46,113 @@ Result GpioRaspberryPi2B::initialize()
         // Number of GPIO's
         numGpios_ = MAX_NUM_GPIOS;
  
-        // Designation of GPIO pin numbers
-        //                 Pin Numbers = {11, 13, 15, 19, 22, 21, 24, 23,   32, 31, 33, 36, 35, 38, 37, 40}
-        //gpioIdNumber_[MAX_NUM_GPIOS] = {17, 27, 22, 10, 25, 09, 08, 11,   12, 06, 13, 16, 19, 20, 26, 21}
-        //                    Function = {RY, RY, RY, RY, RY, RY, RY, RY,   IO, IO, IO, IO, IO, IO, IO, IO}
-        //
-        // Output Relays
-        gpioIdNumber_[ 0] = 17; // Pin Number 11
-        gpioIdNumber_[ 1] = 27; // Pin Number 13
-        gpioIdNumber_[ 2] = 22; // Pin Number 15
-        gpioIdNumber_[ 3] = 10; // Pin Number 19
-        gpioIdNumber_[ 4] = 25; // Pin Number 22
-        gpioIdNumber_[ 5] =  9; // Pin Number 21
-        gpioIdNumber_[ 6] =  8; // Pin Number 24
-        gpioIdNumber_[ 7] = 11; // Pin Number 23
-        //
-        // Digital Input/Output's
-        gpioIdNumber_[ 8] = 12; // Pin Number 32
-        gpioIdNumber_[ 9] =  6; // Pin Number 31
-        gpioIdNumber_[10] = 13; // Pin Number 33
-        gpioIdNumber_[11] = 16; // Pin Number 36
-        gpioIdNumber_[12] = 19; // Pin Number 35
-        gpioIdNumber_[13] = 20; // Pin Number 38
-        gpioIdNumber_[14] = 26; // Pin Number 37
-        gpioIdNumber_[15] = 21; // Pin Number 40
+        // Output Relays and Digital Input/Output's
+        memcpy(gpioIdNumber_, GPIO_NUMBERS_RASPBERRY_PI_2B, sizeof(gpioIdNumber_));
     }
 
     // Export GPIO's to file system
+    if ( exportGpios() != RESULT_OK ) return RESULT_ERROR;
+
+    // Keep attribute files open
+    shutdown();
     for (unsigned int i=0; i<numGpios_; i++)
     {
-        if ( !isGpioExported(gpioIdNumber_[i]) )
+        valueFd_[i]     = openAttribute(gpioIdNumber_[i], "value");
+        directionFd_[i] = openAttribute(gpioIdNumber_[i], "direction");
+        activeLowFd_[i] = openAttribute(gpioIdNumber_[i], "active_low");
+        if ( valueFd_[i] < 0 || directionFd_[i] < 0 || activeLowFd_[i] < 0 ) return RESULT_ERROR;
+    }
+
+    // Edges set by a previous run would prevent setting GPIO's as outputs
+    for (uint8_t i=0; i<numGpios_; i++)
+    {
+        if ( writeEdge(i, "none") != RESULT_OK )
         {
-            if ( exportGpio(gpioIdNumber_[i]) != RESULT_OK )
-            {
-                LOGGING(ERRORS, "ERROR exporting GPIO number %d", gpioIdNumber_[i]);
-                return RESULT_ERROR;
-            } 
+            LOGGING(ERRORS, "WARNING resetting edge of GPIO# %d", gpioIdNumber_[i]);
         }
     }
+    edgeMask_ = 0u;
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if ( epollFd_ < 0 )
+    {
+        LOGGING(ERRORS, "WARNING epoll_create1 failed with errno %d, edges are not detected", errno);
+    }
 
     return RESULT_OK;
 }
 
+void GpioRaspberryPi2B::shutdown()
+{
+    for ( unsigned int i=0; i < MAX_NUM_GPIOS; i++ )
+    {
+        if ( valueFd_[i] >= 0 )     close(valueFd_[i]);
+        if ( directionFd_[i] >= 0 ) close(directionFd_[i]);
+        if ( activeLowFd_[i] >= 0 ) close(activeLowFd_[i]);
+        if ( edgeFd_[i] >= 0 )      close(edgeFd_[i]);
+        valueFd_[i] = -1;
+        directionFd_[i] = -1;
+        activeLowFd_[i] = -1;
+        edgeFd_[i] = -1;
+    }
+    if ( epollFd_ >= 0 ) close(epollFd_);
+    epollFd_ = -1;
+    edgeMask_ = 0u;
+}
+
 Result GpioRaspberryPi2B::setMode(uint8_t gpioId, GpioMode_T mode)
 {
-    char auxBuffer[50];
-    std::string setDirectionCommand, setActiveLowCommand = "default_active_low";
-    std::string setDirection, getDirection, setActiveLow = "0", getActiveLow;
+    const char* setDirection;
+    const char* setActiveLow = "0";
+
+    if ( gpioId >= numGpios_ )
+    {
+        LOGGING(ERRORS, "ERROR GPIO ID %d out of range", gpioId);
+        return RESULT_ERROR;
+    }
 
     switch (mode)
     {
       case INPUT_DIGITAL_INVERTED:
-        sprintf(auxBuffer, "echo 1 > /sys/class/gpio/gpio%d/active_low", gpioIdNumber_[gpioId]);
-        setActiveLowCommand = auxBuffer;
-        setActiveLow = '1';
+        setActiveLow = "1";
       case INPUT_DIGITAL:
-        sprintf(auxBuffer, "echo in > /sys/class/gpio/gpio%d/direction", gpioIdNumber_[gpioId]);
-        setDirectionCommand = auxBuffer;
         setDirection = "in";
         break;
       case OUTPUT_DIGITAL_INVERTED:
-        sprintf(auxBuffer, "echo 1 > /sys/class/gpio/gpio%d/active_low", gpioIdNumber_[gpioId]);
-        setActiveLowCommand = auxBuffer;
-        setActiveLow = '1';
+        setActiveLow = "1";
       case OUTPUT_DIGITAL:
-        sprintf(auxBuffer, "echo out > /sys/class/gpio/gpio%d/direction", gpioIdNumber_[gpioId]);
-        setDirectionCommand = auxBuffer;
         setDirection = "out";
         break;
       default:
         LOGGING(ERRORS, "ERROR GPIO mode %d unkwown", mode);
         return RESULT_ERROR;
     }
-    if ( setActiveLowCommand != "default_active_low" )
+
+    // Outputs cannot have edge detection
+    if ( setDirection[0] == 'o' && ( ( edgeMask_ >> gpioId ) & 1u ) != 0u )
     {
-        LOGGING(VERBOSE, "executing linux command '%s'...", setActiveLowCommand.c_str());
-        system(setActiveLowCommand.c_str());
-        usleep(10000);
+        if ( setEdges(edgeMask_ & ~( 1u << gpioId )) != RESULT_OK ) return RESULT_ERROR;
     }
-    LOGGING(VERBOSE, "executing linux command '%s'...", setDirectionCommand.c_str());
-    system(setDirectionCommand.c_str());
-    usleep(10000);
-    
-    // Check active low is set correctly
-    char activeLowFile[50];
-    sprintf(activeLowFile, "/sys/class/gpio/gpio%d/active_low", gpioIdNumber_[gpioId]);
-    std::ifstream activeLowFilePtr(activeLowFile);
-    if ( !activeLowFilePtr.is_open() )
+
+    LOGGING(VERBOSE, "setting GPIO# %d active_low %s and direction %s...", gpioIdNumber_[gpioId], setActiveLow, setDirection);
+    if ( writeAttribute(activeLowFd_[gpioId], setActiveLow) != RESULT_OK || writeAttribute(directionFd_[gpioId], setDirection) != RESULT_OK )
     {
-        LOGGING(ERRORS, "ERROR opening file %s", activeLowFile);
+        LOGGING(ERRORS, "ERROR writing mode of GPIO# %d", gpioIdNumber_[gpioId]);
         return RESULT_ERROR;
     }
-    activeLowFilePtr >> getActiveLow;
-    activeLowFilePtr.close();
-    if (getActiveLow != setActiveLow)
+
+    // Check active low is set correctly
+    char getActiveLow[8];
+    if ( readAttribute(activeLowFd_[gpioId], getActiveLow, sizeof(getActiveLow)) != RESULT_OK || strcmp(getActiveLow, setActiveLow) != 0 )
     {
-        LOGGING(ERRORS, "unable to set GPIO# %d active_low to %s, setting got is %s", gpioIdNumber_[gpioId], setActiveLow.c_str(), getActiveLow.c_str());
+        LOGGING(ERRORS, "unable to set GPIO# %d active_low to %s", gpioIdNumber_[gpioId], setActiveLow);
         return RESULT_ERROR;
     }
 
     // Check direction is set correctly
-    char directionFile[50];
-    sprintf(directionFile, "/sys/class/gpio/gpio%d/direction", gpioIdNumber_[gpioId]);
-    std::ifstream directionFilePtr(directionFile);
-    directionFilePtr >> getDirection;
-    directionFilePtr.close();
-    if (getDirection != setDirection)
+    char getDirection[8];
+    if ( readAttribute(directionFd_[gpioId], getDirection, sizeof(getDirection)) != RESULT_OK || strcmp(getDirection, setDirection) != 0 )
     {
-        LOGGING(ERRORS, "unable to set %s mode in GPIO# %d", setDirection.c_str(), gpioIdNumber_[gpioId]);
+        LOGGING(ERRORS, "unable to set %s mode in GPIO# %d", setDirection, gpioIdNumber_[gpioId]);
         return RESULT_ERROR;
     }
 
@@ -158,19 +171,19 @@ Result GpioRaspberryPi2B::setMode(uint8_t gpioId, GpioMode_T mode)
 
 Result GpioRaspberryPi2B::getLevel(uint8_t gpioId, signed int& level) const
 {
-    char valueFileName[50];
-    sprintf(valueFileName, "/sys/class/gpio/gpio%d/value", gpioIdNumber_[gpioId]);
-    std::ifstream valueFilePtr(valueFileName);
-    valueFilePtr >> level;
-    valueFilePtr.close();
+    char value[8];
+    if ( gpioId >= numGpios_ || readAttribute(valueFd_[gpioId], value, sizeof(value)) != RESULT_OK )
+    {
+        return RESULT_ERROR;
+    }
+    level = ( value[0] == '1' ) ? 1 : 0;
 
     return RESULT_OK;
 }
 
 Result GpioRaspberryPi2B::setLevel(uint8_t gpioId, signed int level)
 {
-    char setLevelCommand[50];
-    std::string setLevel, getLevel;
+    const char* setLevel;
 
     // Check level value is supported
     switch (level)
@@ -185,59 +198,278 @@ Result GpioRaspberryPi2B::setLevel(uint8_t gpioId, signed int level)
         LOGGING(ERRORS, "ERROR level %d is not supported", level);
         return RESULT_ERROR;
     }
+    if ( gpioId >= numGpios_ )
+    {
+        LOGGING(ERRORS, "ERROR GPIO ID %d out of range", gpioId);
+        return RESULT_ERROR;
+    }
 
     // Set level
-    sprintf(setLevelCommand, "echo %d > /sys/class/gpio/gpio%d/value", level, gpioIdNumber_[gpioId]);  
-    LOGGING(VERBOSE, "executing linux command '%s'...", setLevelCommand);
-    system(setLevelCommand);
-    usleep(10000);
+    if ( writeAttribute(valueFd_[gpioId], setLevel) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR writing level %s in GPIO# %d", setLevel, gpioIdNumber_[gpioId]);
+        return RESULT_ERROR;
+    }
 
     // Check level is set correctly
-    char valueFileName[50];
-    sprintf(valueFileName, "/sys/class/gpio/gpio%d/value", gpioIdNumber_[gpioId]);
-    std::ifstream valueFilePtr(valueFileName);
-    valueFilePtr >> getLevel;
-    valueFilePtr.close();
-    if (getLevel != setLevel)
+    char getLevel[8];
+    if ( readAttribute(valueFd_[gpioId], getLevel, sizeof(getLevel)) != RESULT_OK || strcmp(getLevel, setLevel) != 0 )
+    {
+        LOGGING(ERRORS, "unable to set %s level in GPIO# %d", setLevel, gpioIdNumber_[gpioId]);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioRaspberryPi2B::setLevels(GpioMask_T mask, GpioMask_T levels)
+{
+    if ( ( mask >> numGpios_ ) != 0u )
+    {
+        LOGGING(ERRORS, "ERROR GPIO mask 0x%x out of range", mask);
+        return RESULT_ERROR;
+    }
+
+    // Write all levels first, so that they change as close in time as sysfs allows
+    for ( uint8_t gpioId = 0; gpioId < numGpios_; gpioId++ )
+    {
+        if ( ( ( mask >> gpioId ) & 1u ) == 0u ) continue;
+        if ( writeAttribute(valueFd_[gpioId], ( ( levels >> gpioId ) & 1u ) ? "1" : "0") != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR writing level in GPIO# %d", gpioIdNumber_[gpioId]);
+            return RESULT_ERROR;
+        }
+    }
+
+    // Check levels are set correctly
+    GpioMask_T getLevels;
+    if ( this->getLevels(mask, getLevels) != RESULT_OK || getLevels != ( levels & mask ) )
+    {
+        LOGGING(ERRORS, "unable to set levels 0x%x of GPIO mask 0x%x", levels & mask, mask);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioRaspberryPi2B::getLevels(GpioMask_T mask, GpioMask_T & levels) const
+{
+    if ( ( mask >> numGpios_ ) != 0u ) return RESULT_ERROR;
+
+    levels = 0u;
+    for ( uint8_t gpioId = 0; gpioId < numGpios_; gpioId++ )
+    {
+        if ( ( ( mask >> gpioId ) & 1u ) == 0u ) continue;
+        char value[8];
+        if ( readAttribute(valueFd_[gpioId], value, sizeof(value)) != RESULT_OK ) return RESULT_ERROR;
+        if ( value[0] == '1' ) levels |= ( 1u << gpioId );
+    }
+
+    return RESULT_OK;
+}
+
+Result GpioRaspberryPi2B::setEdges(GpioMask_T mask)
+{
+    if ( ( mask >> numGpios_ ) != 0u )
+    {
+        LOGGING(ERRORS, "ERROR GPIO mask 0x%x out of range", mask);
+        return RESULT_ERROR;
+    }
+    if ( epollFd_ < 0 ) return ( mask == 0u ) ? RESULT_OK : RESULT_UNIMPLEMENTED;
+
+    for ( uint8_t gpioId = 0; gpioId < numGpios_; gpioId++ )
+    {
+        bool enable = ( ( mask >> gpioId ) & 1u ) != 0u;
+        if ( enable == ( ( ( edgeMask_ >> gpioId ) & 1u ) != 0u ) ) continue;
+
+        if ( enable )
+        {
+            struct epoll_event event;
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLPRI;
+            event.data.u32 = gpioId;
+            edgeFd_[gpioId] = openAttribute(gpioIdNumber_[gpioId], "value");
+            if ( edgeFd_[gpioId] < 0 || writeEdge(gpioId, "both") != RESULT_OK || epoll_ctl(epollFd_, EPOLL_CTL_ADD, edgeFd_[gpioId], &event) != 0 )
+            {
+                LOGGING(ERRORS, "ERROR enabling edges of GPIO# %d with errno %d", gpioIdNumber_[gpioId], errno);
+                if ( edgeFd_[gpioId] >= 0 ) close(edgeFd_[gpioId]);
+                edgeFd_[gpioId] = -1;
+                writeEdge(gpioId, "none");
+                return RESULT_ERROR;
+            }
+            edgeMask_ |= ( 1u << gpioId );
+
+            // Clear the flag raised by any previous change
+            char value[8];
+            readAttribute(edgeFd_[gpioId], value, sizeof(value));
+        }
+        else
+        {
+            // Closing the file descriptor removes it from the epoll instance
+            close(edgeFd_[gpioId]);
+            edgeFd_[gpioId] = -1;
+            edgeMask_ &= ~( 1u << gpioId );
+            if ( writeEdge(gpioId, "none") != RESULT_OK )
+            {
+                LOGGING(ERRORS, "ERROR disabling edges of GPIO# %d", gpioIdNumber_[gpioId]);
+                return RESULT_ERROR;
+            }
+        }
+    }
+    LOGGING(VERBOSE, "edges detected in GPIO mask 0x%x", edgeMask_);
+
+    return RESULT_OK;
+}
+
+Result GpioRaspberryPi2B::readEdges(GpioMask_T & edges, int64_t & timestampNs)
+{
+    edges = 0u;
+    timestampNs = 0;
+    if ( epollFd_ < 0 ) return RESULT_OK;
+
+    struct epoll_event events[MAX_NUM_GPIOS];
+    int numEvents = epoll_wait(epollFd_, events, MAX_NUM_GPIOS, 0);
+    if ( numEvents < 0 )
     {
-        LOGGING(ERRORS, "unable to set %s level in GPIO# %d", setLevel.c_str(), gpioIdNumber_[gpioId]);
+        if ( errno == EINTR ) return RESULT_OK;
+        LOGGING(ERRORS, "ERROR waiting for edges with errno %d", errno);
         return RESULT_ERROR;
     }
+    if ( numEvents == 0 ) return RESULT_OK;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    timestampNs = static_cast<int64_t>(now.tv_sec) * 1000000000ll + now.tv_nsec;
+    for ( int i=0; i < numEvents; i++ )
+    {
+        // Reading the value clears the flag
+        uint8_t gpioId = static_cast<uint8_t>(events[i].data.u32);
+        char value[8];
+        readAttribute(edgeFd_[gpioId], value, sizeof(value));
+        edges |= ( 1u << gpioId );
+    }
 
     return RESULT_OK;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-// PUBLIC METHODS
+// PRIVATE METHODS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GpioRaspberryPi2B::isGpioExported(uint8_t gpioId)
+bool GpioRaspberryPi2B::isGpioExported(uint8_t gpioNumber)
 {
-    char directionFileName[50];
+    std::string directionFileName = sysfsRoot_ + "/gpio" + std::to_string(gpioNumber) + "/direction";
 
-    sprintf(directionFileName, "/sys/class/gpio/gpio%d/direction", gpioId);
+    return access(directionFileName.c_str(), F_OK) == 0;
+}
 
-    std::ifstream directionFilePtr(directionFileName);
-    
-    if ( directionFilePtr.is_open() )
+bool GpioRaspberryPi2B::isGpioReady(uint8_t gpioNumber)
+{
+    std::string gpioDirName = sysfsRoot_ + "/gpio" + std::to_string(gpioNumber);
+
+    return access((gpioDirName + "/value").c_str(), R_OK | W_OK) == 0 && access((gpioDirName + "/direction").c_str(), R_OK | W_OK) == 0 &&
+           access((gpioDirName + "/active_low").c_str(), R_OK | W_OK) == 0;
+}
+
+Result GpioRaspberryPi2B::exportGpios()
+{
+    struct timespec begin;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+
+    // Request all exports first, so that the kernel and udev prepare the GPIO's concurrently
+    GpioMask_T pendingMask = 0u;
+    int fd = -1;
+    std::string exportFileName = sysfsRoot_ + "/export";
+    for ( unsigned int i=0; i < numGpios_; i++ )
     {
-        directionFilePtr.close();
-        return true;
+        if ( isGpioExported(gpioIdNumber_[i]) ) continue;
+        if ( fd < 0 ) fd = open(exportFileName.c_str(), O_WRONLY | O_CLOEXEC);
+        if ( fd < 0 )
+        {
+            LOGGING(ERRORS, "ERROR opening file %s with errno %d", exportFileName.c_str(), errno);
+            return RESULT_ERROR;
+        }
+        // One GPIO number per write, as the kernel expects
+        LOGGING(VERBOSE, "exporting GPIO# %d...", gpioIdNumber_[i]);
+        std::string number = std::to_string(gpioIdNumber_[i]) + "\n";
+        if ( write(fd, number.c_str(), number.size()) != static_cast<ssize_t>(number.size()) )
+        {
+            LOGGING(ERRORS, "ERROR writing GPIO# %d to file %s with errno %d", gpioIdNumber_[i], exportFileName.c_str(), errno);
+            close(fd);
+            return RESULT_ERROR;
+        }
+        pendingMask |= ( 1u << i );
     }
-    else return false;
+    if ( fd >= 0 ) close(fd);
+
+    // Wait for attribute files of all GPIO's, not a fixed time per GPIO
+    long elapsedUs = 0;
+    while ( true )
+    {
+        for ( unsigned int i=0; i < numGpios_; i++ )
+        {
+            if ( ( ( pendingMask >> i ) & 1u ) != 0u && isGpioReady(gpioIdNumber_[i]) ) pendingMask &= ~( 1u << i );
+        }
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsedUs = ( now.tv_sec - begin.tv_sec ) * 1000000l + ( now.tv_nsec - begin.tv_nsec ) / 1000l;
+        if ( pendingMask == 0u || elapsedUs >= static_cast<long>(GPIO_EXPORT_TIMEOUT_MS * 1000u) ) break;
+        usleep(GPIO_READY_POLL_US);
+    }
+    if ( pendingMask != 0u )
+    {
+        for ( unsigned int i=0; i < numGpios_; i++ )
+        {
+            if ( ( ( pendingMask >> i ) & 1u ) != 0u ) LOGGING(ERRORS, "ERROR exporting GPIO number %d, not ready after %d ms", gpioIdNumber_[i], GPIO_EXPORT_TIMEOUT_MS);
+        }
+        return RESULT_ERROR;
+    }
+    LOGGING(INFO, "GPIO's exported and ready in %ld us", elapsedUs);
+
+    return RESULT_OK;
 }
 
-Result GpioRaspberryPi2B::exportGpio(uint8_t gpioId)
+int GpioRaspberryPi2B::openAttribute(uint8_t gpioNumber, const char* attribute)
 {
-    char linuxCommand[50];
+    std::string fileName = sysfsRoot_ + "/gpio" + std::to_string(gpioNumber) + "/" + attribute;
+    int fd = open(fileName.c_str(), O_RDWR | O_CLOEXEC);
+    if ( fd < 0 )
+    {
+        LOGGING(ERRORS, "ERROR opening file %s with errno %d", fileName.c_str(), errno);
+    }
+
+    return fd;
+}
+
+Result GpioRaspberryPi2B::readAttribute(int fd, char* value, size_t size)
+{
+    ssize_t length = pread(fd, value, size - 1, 0);
+    if ( length <= 0 ) return RESULT_ERROR;
+    value[length] = '\0';
+    value[strcspn(value, " \t\n")] = '\0';
+
+    return RESULT_OK;
+}
 
-    sprintf(linuxCommand, "echo %d > /sys/class/gpio/export", gpioId);
-    LOGGING(VERBOSE, "executing linux command '%s'...", linuxCommand);
-    system(linuxCommand);
-    usleep(200000);
+Result GpioRaspberryPi2B::writeAttribute(int fd, const char* value)
+{
+    char line[16];
+    int length = snprintf(line, sizeof(line), "%s\n", value);
+    if ( pwrite(fd, line, length, 0) != length )
+    {
+        LOGGING(ERRORS, "ERROR writing GPIO attribute %s with errno %d", value, errno);
+        return RESULT_ERROR;
+    }
 
-    if ( isGpioExported(gpioId) ) return RESULT_OK;
-    else                          return RESULT_ERROR;
+    return RESULT_OK;
 }
 
+Result GpioRaspberryPi2B::writeEdge(uint8_t gpioId, const char* edge)
+{
+    int fd = openAttribute(gpioIdNumber_[gpioId], "edge");
+    if ( fd < 0 ) return RESULT_ERROR;
+    Result result = writeAttribute(fd, edge);
+    close(fd);
 
+    return result;
+}
@@ -8,13 +8,38 @@
  *  @date   November 2015
  *  @brief  Definition of GpioRaspberryPi2B
  *
- *  Function to be documented.
+ *  Digital GPIO's of the Raspberry Pi through the sysfs GPIO interface.
+ *
+ *  The value, direction and active_low attribute files of every GPIO are
+ *  opened once by initialize() and kept open: levels and modes are read
+ *  and written with pread/pwrite at offset 0, without spawning processes
+ *  or reopening files, so a read or write takes microseconds.
+ *
+ *  The sysfs root defaults to /sys/class/gpio and can be set to a fake
+ *  tree (e.g. in a tmpfs directory) for tests.
+ *
+ *  GPIO's not exported yet are all requested at once, then polled every
+ *  GPIO_READY_POLL_US until their attribute files are accessible (udev
+ *  sets their permissions after the export) or GPIO_EXPORT_TIMEOUT_MS
+ *  expires, instead of sleeping a fixed time per GPIO.
+ *
+ *  sysfs has no multi-line access: setLevels() and getLevels() loop over
+ *  the GPIO's of the mask (see GpioChardevRaspberryPi2B).
+ *
+ *  Edges are detected by writing "both" to the edge attribute: the kernel
+ *  then flags the value file with POLLPRI on every level change. A second
+ *  file descriptor of the value file of those GPIO's, so that level reads
+ *  do not clear the flag, is registered in one epoll instance, whose file
+ *  descriptor is returned by getEdgeFd(); reading it clears the flag.
+ *  sysfs gives no edge time: readEdges() timestamps edges when consumed.
  */
 /////////////////////////////////////////////////////////////////////////////
 
+#include <string>
 #include "LenamDevs_types.h"
 #include "IComponent.h"
 #include "IGpio.h"
+#include "IGpioBulk.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -23,30 +48,42 @@
 
 //extern const unsigned int NUM_CHANNELS;
 const char GPIO_EXPORT_CHECK_FILE_NAME[20] = "gpioExport.check";
+const char             GPIO_SYSFS_ROOT[20] = "/sys/class/gpio";
+const unsigned int      GPIO_EXPORT_TIMEOUT_MS = 1000u;     // Longest wait for exported GPIO's to be ready
+const unsigned int          GPIO_READY_POLL_US = 1000u;     // Period of checks of exported GPIO's
+
+// Designation of GPIO pin numbers, by GPIO Id
+//              Pin Numbers = {11, 13, 15, 19, 22, 21, 24, 23,   32, 31, 33, 36, 35, 38, 37, 40}
+//                 Function = {RY, RY, RY, RY, RY, RY, RY, RY,   IO, IO, IO, IO, IO, IO, IO, IO}
+const uint8_t GPIO_NUMBERS_RASPBERRY_PI_2B[] = {17, 27, 22, 10, 25,  9,  8, 11,   12,  6, 13, 16, 19, 20, 26, 21};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // CLASS DECLARATION
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-class GpioRaspberryPi2B : public IComponent, IGpio
+class GpioRaspberryPi2B : public IComponent, public IGpioBulk
 {
   public:
 
     /*
      * Class constructor 
+     * @param sysfsRoot directory with export file and gpioN directories
      */
-    GpioRaspberryPi2B(const char* instanceName);
+    GpioRaspberryPi2B(const char* instanceName, const char* sysfsRoot = GPIO_SYSFS_ROOT);
 
     /*
      * Class destructor 
      */
-    ~GpioRaspberryPi2B() {}
+    ~GpioRaspberryPi2B() { shutdown(); }
 
     Result initialize();
 
     Result start() { return RESULT_OK; }
 
-    void shutdown() {} 
+    /*
+     * Closes attribute files
+     */
+    void shutdown();
     
     Result setMode(uint8_t gpioId, GpioMode_T mode);
 
@@ -56,6 +93,19 @@ class GpioRaspberryPi2B : public IComponent, IGpio
 
     Result getVoltage(uint8_t id, float &voltage) { return RESULT_UNIMPLEMENTED; }
 
+    /**
+     * Writes the level of each GPIO in mask, one after the other, then verifies them
+     */
+    Result setLevels(GpioMask_T mask, GpioMask_T levels);
+
+    Result getLevels(GpioMask_T mask, GpioMask_T & levels) const;
+
+    Result setEdges(GpioMask_T mask);
+
+    int getEdgeFd() const { return epollFd_; }
+
+    Result readEdges(GpioMask_T & edges, int64_t & timestampNs);
+
   private:
 
     static const uint8_t MAX_NUM_GPIOS = 16u;
@@ -70,9 +120,69 @@ class GpioRaspberryPi2B : public IComponent, IGpio
      */
     uint8_t gpioIdNumber_[MAX_NUM_GPIOS];
 
-    bool isGpioExported(uint8_t gpioId);
+    std::string sysfsRoot_;
 
-    Result exportGpio(uint8_t gpioId);
+    /*
+     * Attribute files of GPIO Id kept open, -1 if closed
+     */
+    int valueFd_[MAX_NUM_GPIOS];
+    int directionFd_[MAX_NUM_GPIOS];
+    int activeLowFd_[MAX_NUM_GPIOS];
+
+    /*
+     * epoll instance of value files of GPIO's with edge detection, -1 if closed
+     */
+    int epollFd_ = -1;
+    int edgeFd_[MAX_NUM_GPIOS];
+    GpioMask_T edgeMask_ = 0u;
+
+    bool isGpioExported(uint8_t gpioNumber);
+
+    /**
+     * Checks attribute files of exported GPIO number can be read and written
+     * @param gpioNumber GPIO number
+     * @return bool true if ready
+     */
+    bool isGpioReady(uint8_t gpioNumber);
+
+    /**
+     * Requests export of all GPIO's not exported yet, then waits until all of them are ready
+     * @return Result RESULT_OK in case of correct execution; RESULT_ERROR if any is not ready in GPIO_EXPORT_TIMEOUT_MS
+     */
+    Result exportGpios();
+
+    /**
+     * Opens attribute file of GPIO number for reading and writing
+     * @param gpioNumber GPIO number
+     * @param attribute name of file in gpioN directory
+     * @return int file descriptor, -1 on error
+     */
+    int openAttribute(uint8_t gpioNumber, const char* attribute);
+
+    /**
+     * Reads attribute up to first white space
+     * @param fd of attribute file
+     * @param value read
+     * @param size of value buffer
+     * @return Result RESULT_OK in case of correct execution
+     */
+    static Result readAttribute(int fd, char* value, size_t size);
+
+    /**
+     * Writes attribute followed by new line, as echo does
+     * @param fd of attribute file
+     * @param value to write
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result writeAttribute(int fd, const char* value);
+
+    /**
+     * Writes edge attribute of GPIO Id; the file is not kept open as edges seldom change
+     * @param gpioId GPIO Id
+     * @param edge "none", "rising", "falling" or "both"
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result writeEdge(uint8_t gpioId, const char* edge);
 };
 
 #endif // _GPIORASPBERRYPI2B_H
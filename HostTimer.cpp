@@ -8,12 +8,17 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "HostTimer.h"
+#include "ConstantsServices.h"
 //#include "GpioRaspberryPi2B.h"
 #include <ctime>
 #include <unistd.h>
 #include <stdlib.h>
 #include <sstream>
 #include <numeric>
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+#include <cmath>
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,38 +30,240 @@
 // PUBLIC METHODS
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-HostTimer::HostTimer(const char* instanceName) : IComponent(instanceName)
+HostTimer::HostTimer(const char* instanceName, IClock* clock) : IComponent(instanceName), clock_(clock)
 {
     logChannels_ = Logger::INFO;
+    startupBegin_ = std::chrono::steady_clock::now();
+
+    if ( clock_ == nullptr )
+    {
+        systemClock_ = new SystemClock("SystemClock");
+        ASSERT( systemClock_ != nullptr );
+        clock_ = systemClock_;
+    }
 
     // Initialize digital GPIO's
-    gpio_ = new GpioRaspberryPi2B("GpioRaspberryPi2B");
-    ASSERT( gpio_ != nullptr );
-    if ( gpio_->initialize() != RESULT_OK )
     {
-        LOGMSG(ERRORS, "ERROR initializing GPIOs");
-        ASSERT(0);
+        int32_t gpioChardev = 0;
+        int32_t gpioMem = 0;
+        ConstantsServices constsServices(CONSTANTS_FILE_NAME);
+        if ( constsServices.readConstant("GPIO_CHARDEV", gpioChardev) != RESULT_OK ) gpioChardev = 0;
+        if ( constsServices.readConstant("GPIO_GPIOMEM", gpioMem) != RESULT_OK ) gpioMem = 0;
+
+        Result result;
+        if ( gpioMem != 0 )
+        {
+            GpioMemRaspberryPi2B * gpio = new GpioMemRaspberryPi2B("GpioMemRaspberryPi2B");
+            ASSERT( gpio != nullptr );
+            result = gpio->initialize();
+            gpio_ = gpio;
+        }
+        else if ( gpioChardev != 0 )
+        {
+            GpioChardevRaspberryPi2B * gpio = new GpioChardevRaspberryPi2B("GpioChardevRaspberryPi2B");
+            ASSERT( gpio != nullptr );
+            result = gpio->initialize();
+            gpio_ = gpio;
+        }
+        else
+        {
+            GpioRaspberryPi2B * gpio = new GpioRaspberryPi2B("GpioRaspberryPi2B");
+            ASSERT( gpio != nullptr );
+            result = gpio->initialize();
+            gpio_ = gpio;
+        }
+        if ( result != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR initializing GPIOs");
+            ASSERT(0);
+        }
+        for (uint8_t i=0; i < NUM_DRIVEN_RELAYS; i++) relayGpioMask_ |= ( 1u << gpioIdOf(i) );
+
+        // Relays are written on change only, and read back every RELAY_VERIFY_SECONDS
+        int32_t relayVerifySeconds = 60;
+        if ( constsServices.readConstant("RELAY_VERIFY_SECONDS", relayVerifySeconds) != RESULT_OK || relayVerifySeconds < 0 )
+        {
+            relayVerifySeconds = 60;
+            LOGGING(ERRORS, "WARNING reading constant RELAY_VERIFY_SECONDS, to use default value %d", relayVerifySeconds);
+        }
+        uint8_t relayGpioIds[NUM_DRIVEN_RELAYS];
+        for (uint8_t i=0; i < NUM_DRIVEN_RELAYS; i++) relayGpioIds[i] = gpioIdOf(i);
+        relayOutputs_ = new RelayOutputs("RelayOutputs", gpio_, relayGpioIds, NUM_DRIVEN_RELAYS, static_cast<unsigned int>(relayVerifySeconds));
+        ASSERT( relayOutputs_ != nullptr );
     }
 
     // Initialize Analog Inputs
-    gpioAnalog_ = new GpioAnalogRaspberryPi2BAds1115("GpioAnalogRaspberryPi2BAds1115");
-    ASSERT( gpioAnalog_ != nullptr );
-    if ( gpioAnalog_->initialize() != RESULT_OK )
     {
-        LOGMSG(ERRORS, "ERROR initializing analog inputs");
-        ASSERT(0);
+        i2cBus_ = new I2cRaspberryPi2B("I2cRaspberryPi2B");
+        ASSERT( i2cBus_ != nullptr );
+        if ( i2cBus_->initialize() != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR initializing I2C bus");
+            ASSERT(0);
+        }
+
+        // ADC full scale and data rate
+        int32_t fullScaleMv = 4096;
+        int32_t dataRateSps = 128;
+        ConstantsServices constsServices(CONSTANTS_FILE_NAME);
+        GpioAnalogRaspberryPi2BAds1115::Pga_T pga = GpioAnalogRaspberryPi2BAds1115::PGA_4_096V;
+        GpioAnalogRaspberryPi2BAds1115::DataRate_T dataRate = GpioAnalogRaspberryPi2BAds1115::DR_128_SPS;
+        if ( constsServices.readConstant("ADS1115_FULL_SCALE_MV", fullScaleMv) != RESULT_OK ||
+             GpioAnalogRaspberryPi2BAds1115::toPga(fullScaleMv, pga) != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "WARNING reading constant ADS1115_FULL_SCALE_MV, to use default value 4096");
+        }
+        if ( constsServices.readConstant("ADS1115_DATA_RATE_SPS", dataRateSps) != RESULT_OK ||
+             GpioAnalogRaspberryPi2BAds1115::toDataRate(dataRateSps, dataRate) != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "WARNING reading constant ADS1115_DATA_RATE_SPS, to use default value 128");
+        }
+
+        int32_t numChips = 1;
+        if ( constsServices.readConstant("ADS1115_CHIPS", numChips) != RESULT_OK ||
+             numChips < 1 || numChips > GpioAnalogFrontEnd::MAX_NUM_CHIPS )
+        {
+            LOGMSG(ERRORS, "WARNING reading constant ADS1115_CHIPS, to use default value 1");
+            numChips = 1;
+        }
+
+        gpioAnalog_ = new GpioAnalogFrontEnd("GpioAnalogFrontEnd", i2cBus_, static_cast<unsigned char>(numChips), pga, dataRate);
+        ASSERT( gpioAnalog_ != nullptr );
+        if ( gpioAnalog_->initialize() != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR initializing analog inputs");
+            ASSERT(0);
+        }
     }
 
-    // Map Analog Channels
+    // Map Analog Channels to front end inputs
     {
-        analogIdNumber_[16] = 0u; 
-        analogIdNumber_[17] = 1u; 
-        analogIdNumber_[18] = 2u; 
-        analogIdNumber_[19] = 3u; 
+        ConstantsServices constsServices(CONSTANTS_FILE_NAME);
+        int32_t vccInput = -1;
+        if ( constsServices.readConstant("NTC_VCC_INPUT", vccInput) == RESULT_OK && vccInput >= 0 )
+        {
+            if ( vccInput < gpioAnalog_->getNumInputs() ) ntcVccInput_ = static_cast<unsigned char>(vccInput);
+            else LOGGING(ERRORS, "WARNING NTC Vcc input %d out of %d inputs, to use %.2f V", vccInput, gpioAnalog_->getNumInputs(), NTC_VCC_VOLTS);
+        }
+        for ( unsigned int i=0; i < NUM_AIN_CHANNELS; i++ )
+        {
+            std::string constantName = "AIN_INPUT_" + std::to_string(i);
+            int32_t input = static_cast<int32_t>(i);
+            if ( constsServices.readConstant(constantName.c_str(), input) != RESULT_OK ) input = static_cast<int32_t>(i);
+            if ( input < 0 || input >= gpioAnalog_->getNumInputs() )
+            {
+                LOGGING(ERRORS, "WARNING analog channel %d mapped to input %d out of %d inputs, channel not mapped",
+                                i, input, gpioAnalog_->getNumInputs());
+                continue;
+            }
+            analogIdNumber_[NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS + i] = static_cast<uint8_t>(input);
+
+            // Oversampling and filter of channel
+            int32_t oversampling = 1;
+            constantName = "AIN_OVERSAMPLING_" + std::to_string(i);
+            if ( constsServices.readConstant(constantName.c_str(), oversampling) == RESULT_OK &&
+                 gpioAnalog_->setOversampling(static_cast<unsigned char>(input), static_cast<unsigned int>(oversampling)) != RESULT_OK )
+            {
+                LOGGING(ERRORS, "WARNING reading constant %s, to use default value 1", constantName.c_str());
+            }
+            int32_t filterType = ChannelFilter::NONE;
+            int32_t filterLength = 1;
+            constantName = "AIN_FILTER_" + std::to_string(i);
+            if ( constsServices.readConstant(constantName.c_str(), filterType) != RESULT_OK ) continue;
+            if ( filterType < ChannelFilter::NONE || filterType > ChannelFilter::IIR )
+            {
+                LOGGING(ERRORS, "ERROR constant %s of filter type %d out of range %d to %d", constantName.c_str(), filterType,
+                                ChannelFilter::NONE, ChannelFilter::IIR);
+                ASSERT(0);
+            }
+            std::string lengthName = "AIN_FILTER_LENGTH_" + std::to_string(i);
+            if ( constsServices.readConstant(lengthName.c_str(), filterLength) != RESULT_OK ||
+                 !filters_[NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS + i].configure(static_cast<ChannelFilter::Type_T>(filterType),
+                                                                               static_cast<unsigned int>(filterLength)) )
+            {
+                LOGGING(ERRORS, "WARNING reading constants %s and %s, channel not filtered", constantName.c_str(), lengthName.c_str());
+            }
+        }
     }
 
     timerStatus_ = new TimerStatus("HostTimerStatus");
 
+    programStorage_ = new ProgramStorage("ProgramStorage");
+    ASSERT( programStorage_ != nullptr );
+
+    engine_ = new ControlEngine("ControlEngine");
+    ASSERT( engine_ != nullptr );
+
+    // Anti-chatter tunings of guards and relays
+    {
+        ConstantsServices constsServices(CONSTANTS_FILE_NAME);
+        ControlTypes::GuardTuning_T tunings[MAX_NUM_GUARDS];
+        for ( unsigned int i=0; i < MAX_NUM_GUARDS; i++ )
+        {
+            int32_t hysteresisMilli = 0;
+            int32_t debounce = 0;
+            std::string constantName = "GUARD_HYSTERESIS_MILLI_" + std::to_string(i + 1);
+            if ( constsServices.readConstant(constantName.c_str(), hysteresisMilli) == RESULT_OK && hysteresisMilli < 0 )
+            {
+                LOGGING(ERRORS, "WARNING reading constant %s, to use default value 0", constantName.c_str());
+                hysteresisMilli = 0;
+            }
+            constantName = "GUARD_DEBOUNCE_" + std::to_string(i + 1);
+            if ( constsServices.readConstant(constantName.c_str(), debounce) == RESULT_OK && ( debounce < 0 || debounce > 255 ) )
+            {
+                LOGGING(ERRORS, "WARNING reading constant %s, to use default value 0", constantName.c_str());
+                debounce = 0;
+            }
+            tunings[i].hysteresis = hysteresisMilli * 1e-3f;
+            tunings[i].debounce = static_cast<uint8_t>(debounce);
+        }
+        engine_->setGuardTunings(tunings);
+
+        ControlTypes::RelayTiming_T timings[NUM_OUTPUT_RELAYS];
+        for ( unsigned int i=0; i < NUM_OUTPUT_RELAYS; i++ )
+        {
+            int32_t minOnSeconds = 0;
+            int32_t minOffSeconds = 0;
+            std::string onName = "RELAY_MIN_ON_SECONDS_" + std::to_string(i);
+            std::string offName = "RELAY_MIN_OFF_SECONDS_" + std::to_string(i);
+            if ( constsServices.readConstant(onName.c_str(), minOnSeconds) == RESULT_OK && minOnSeconds < 0 ) minOnSeconds = 0;
+            if ( constsServices.readConstant(offName.c_str(), minOffSeconds) == RESULT_OK && minOffSeconds < 0 ) minOffSeconds = 0;
+            timings[i].minOnSeconds = static_cast<uint32_t>(minOnSeconds);
+            timings[i].minOffSeconds = static_cast<uint32_t>(minOffSeconds);
+        }
+        engine_->setRelayTimings(timings);
+    }
+
+    // Initialize control loop tick scheduler
+    {
+        int32_t tickRateHz = MIN_TICK_RATE_HZ;
+        ConstantsServices constsServices(CONSTANTS_FILE_NAME);
+        if ( constsServices.readConstant("TICK_RATE_HZ", tickRateHz) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "WARNING reading constant TICK_RATE_HZ, to use default value %d", tickRateHz);
+        }
+        int32_t maxIdleMinutes = maxIdleMinutes_;
+        if ( constsServices.readConstant("MAX_IDLE_MINUTES", maxIdleMinutes) != RESULT_OK || maxIdleMinutes < 1 )
+        {
+            LOGGING(ERRORS, "WARNING reading constant MAX_IDLE_MINUTES, to use default value %d", maxIdleMinutes_);
+        }
+        else maxIdleMinutes_ = static_cast<unsigned int>(maxIdleMinutes);
+        int32_t sensorRateHz = MIN_TICK_RATE_HZ;
+        if ( constsServices.readConstant("SENSOR_RATE_HZ", sensorRateHz) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "WARNING reading constant SENSOR_RATE_HZ, to use default value %d", sensorRateHz);
+        }
+        sensorAcquisition_ = new SensorAcquisition("SensorAcquisition", static_cast<unsigned int>(sensorRateHz));
+        ASSERT( sensorAcquisition_ != nullptr );
+        tickScheduler_ = new TickScheduler("TickScheduler", static_cast<unsigned int>(tickRateHz), clock_);
+        ASSERT( tickScheduler_ != nullptr );
+        if ( tickScheduler_->initialize() != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR initializing tick scheduler");
+            ASSERT(0);
+        }
+    }
+
     // PROGRAM FILE UPDATE
     // Check if program update flag file exists and execute update
     if ( checkProgramUpdate(false) != RESULT_OK )
@@ -68,10 +275,16 @@ HostTimer::HostTimer(const char* instanceName) : IComponent(instanceName)
 
 HostTimer::~HostTimer()
 {
-    // Close program file
-    fclose(programFilePtr_);
-
+    // Acquisition thread reads the GPIO and analog drivers
+    delete sensorAcquisition_;
+    delete gpioAnalog_;
+    delete i2cBus_;
+    delete relayOutputs_;
+    delete tickScheduler_;
+    delete engine_;
+    delete programStorage_;
     delete timerStatus_;
+    delete systemClock_;
 }
 
 Result HostTimer::initialize()
@@ -83,9 +296,9 @@ Result HostTimer::initialize()
         ASSERT(0);
     }
 
-    // Open program file
+    // Map program file
     LOGGING(INFO, "opening program file %s...", programFileName_.c_str());
-    if ( (programFilePtr_ = fopen(programFileName_.c_str(), "r")) == NULL )
+    if ( loadProgramFile() != RESULT_OK )
     {
         LOGGING(ERRORS, "ERROR opening program file %s, waiting for program update...", programFileName_.c_str());
         // Continous check whether program update flag exists
@@ -97,6 +310,11 @@ Result HostTimer::initialize()
             LOGMSG(ERRORS, "ERROR updating program file");
             ASSERT(0);
         }
+        if ( readProgramSetFile() != RESULT_OK || loadProgramFile() != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR opening updated program file %s", programFileName_.c_str());
+            ASSERT(0);
+        }
     }
  
 #ifdef GENERATE_EXAMPLE_OF_CHANNELS_FILE
@@ -109,143 +327,22 @@ Result HostTimer::initialize()
 #endif
     
     // Open and read channels file into array channels_
+    sensorAcquisition_->stop();
+    if ( readChannelsFile(channels_) != RESULT_OK )
     {
-        //std::ifstream channelsFilePtr;
-        FILE * channelsFilePtr; 
-        LOGGING(INFO, "reading file %s...", CHANNELS_FILE_NAME);
-        if ( (channelsFilePtr = fopen(CHANNELS_FILE_NAME, "r")) == NULL )
-        {
-            LOGGING(ERRORS, "ERROR opening file %s ", CHANNELS_FILE_NAME);
-            ASSERT(0);        
-        }
-        //for ( unsigned int i=0; !channelsFilePtr.eof(); i++ )
-        for ( unsigned int i=0; i<=NUM_CHANNELS; i++ )
-        {
-            fread( &channels_[i], sizeof(Channel_T), 1, channelsFilePtr );         
-            if ( !feof(channelsFilePtr) )
-            {
-                if ( i < NUM_CHANNELS )
-                {
-                    LOGGING(INFO, "channel id:%02d name:%s type:%d model:%s dutyCycle:%d", channels_[i].id, channels_[i].name, channels_[i].type, channels_[i].model, channels_[i].dutyCycle);
-                }
-                else // ( i == NUM_CHANNELS)
-                {
-                    LOGGING(ERRORS, "WARNING more than %d channels found in file %s are discarded", NUM_CHANNELS, CHANNELS_FILE_NAME);
-                    break;
-                }
-            }
-            else if ( i < NUM_CHANNELS - 1 )
-            {
-                LOGGING(ERRORS, "ERROR missing definition of channels in file %s; only %d channels defined", CHANNELS_FILE_NAME, i+1);
-                ASSERT(0);                
-            }
-            else // ( i == NUM_CHANNELS - 1 )
-            {
-                LOGGING(VERBOSE, "total number of channels read is %d", i);
-                break;
-            }
-
-            // Check type of channels
-            if ( i < NUM_OUTPUT_RELAYS && channels_[i].type != OUTPUT_RELAY )
-            {
-                LOGGING(ERRORS, "ERROR channel %d must be of type output relay", i);
-                ASSERT(0);                
-            }
-            if ( i >= NUM_OUTPUT_RELAYS && i < (NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS)
-                 && channels_[i].type != INPUT_DIGITAL && channels_[i].type != OUTPUT_DIGITAL )
-            {
-                LOGGING(ERRORS, "ERROR channel %d must be of type either input digital or output digital", i);
-                ASSERT(0);                                
-            }
-            if ( i >= (NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS) && i < (NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS + NUM_AIN_CHANNELS)
-                 && channels_[i].type != INPUT_ANALOG && channels_[i].type != INPUT_NTC_THERMISTOR )
-            {
-                LOGGING(ERRORS, "ERROR channel %d must be of type either input analog or NTC thermistor", i);
-                ASSERT(0);                                
-            }
-        }
-        //channelsFilePtr.close();
-        fclose(channelsFilePtr);
+        LOGGING(ERRORS, "ERROR reading channels file %s", CHANNELS_FILE_NAME);
+        return RESULT_ERROR;
     }
     
     // Configure GPIO's and Analog Channels
     {
         // Clear NTC Thermistors Map
+        for ( auto & ntcThermistor : ntcThermistors_ ) delete ntcThermistor.second;
         ntcThermistors_.clear();
 
-        for (unsigned int i=0; i<NUM_CHANNELS; i++ )
+        for (unsigned int i=0; i<NUM_HOST_CHANNELS; i++ )
         {
-            switch (channels_[i].type)
-            {
-            case INPUT_DIGITAL:
-                if ( std::string(channels_[i].model) == "N.O." )
-                {
-                    if ( gpio_->setMode(i, IGpio::INPUT_DIGITAL_INVERTED) != RESULT_OK )
-                    {
-                        LOGGING(ERRORS, "ERROR setting mode input digital in GPIO id %d", i);
-                        return RESULT_ERROR;
-                    }
-                }
-                else if ( std::string(channels_[i].model) == "N.C." )
-                {
-                    if ( gpio_->setMode(i, IGpio::INPUT_DIGITAL) != RESULT_OK )
-                    {
-                        LOGGING(ERRORS, "ERROR setting mode input digital inverted in GPIO id %d", i);
-                        return RESULT_ERROR;
-                    }
-                }
-                else
-                {
-                    LOGGING(ERRORS, "ERROR: unexpected input digital model %s found", channels_[i].model);
-                    return RESULT_ERROR;
-                }
-                break;
-            case OUTPUT_DIGITAL:
-                if ( std::string(channels_[i].model) == "N.O." )
-                {
-                    if ( gpio_->setMode(i, IGpio::OUTPUT_DIGITAL) != RESULT_OK)
-                    {
-                        LOGGING(ERRORS, "ERROR setting mode output digital in GPIO id %d", i);
-                        return RESULT_ERROR;
-                    }
-                }
-                else if ( std::string(channels_[i].model) == "N.C." )
-                {
-                    if ( gpio_->setMode(i, IGpio::OUTPUT_DIGITAL_INVERTED) != RESULT_OK)
-                    {
-                        LOGGING(ERRORS, "ERROR setting mode output digital inverted in GPIO id %d", i);
-                        return RESULT_ERROR;
-                    }
-                }
-                else
-                {
-                    LOGGING(ERRORS, "ERROR: unexpected output digital model %s found", channels_[i].model);
-                    return RESULT_ERROR;
-                }
-                break;
-            case OUTPUT_RELAY:
-                if ( gpio_->setMode(i, IGpio::OUTPUT_DIGITAL) != RESULT_OK)
-                {
-                    LOGGING(ERRORS, "ERROR setting mode output digital in GPIO id %d", i);
-                    return RESULT_ERROR;
-                }
-                break;
-            case INPUT_ANALOG:
-                break;
-            case INPUT_NTC_THERMISTOR:
-                if ( ntcThermistors_.find( channels_[i].model ) == ntcThermistors_.end() )
-                {
-                    LOGGING(VERBOSE, "contructing new AnalogSensorNtcThermistor model %s", channels_[i].model);
-                    ntcThermistors_[channels_[i].model] = new AnalogSensorNtcThermistor("NtcThermistor", channels_[i].model);
-                    std::string ntcThermistorName = std::string("NtcThermistor") + channels_[i].model;
-                    LOGGING(VERBOSE, "setting interface IGpio for instance:%s", ntcThermistorName.c_str());
-                    ntcThermistors_[channels_[i].model]->setInterface(ntcThermistorName.c_str(), "IGpio", static_cast<IGpio *>(gpioAnalog_));
-                    LOGGING(VERBOSE, "initializing channel %d", i);
-                    ntcThermistors_[channels_[i].model]->initialize();
-                }
-                break;
-            }
-            usleep(200000);
+            if ( configureChannel(i) != RESULT_OK ) return RESULT_ERROR;
         }        
     }
 
@@ -259,46 +356,24 @@ Result HostTimer::initialize()
 #endif
 
     // Open and read guards file into array guards_
+    if ( readGuardsFile(guards_) != RESULT_OK )
     {
-        FILE * guardsFilePtr;
-        LOGGING(VERBOSE, "reading file %s...", GUARDS_FILE_NAME);
-        if ( (guardsFilePtr = fopen(GUARDS_FILE_NAME, "r")) == NULL )
-        {
-            LOGGING(ERRORS, "WARNING opening file %s", GUARDS_FILE_NAME);
-        }
-        else
-        {
-            //for ( unsigned int i=0; !guardsFilePtr.eof(); i++ )
-            for ( unsigned int i=0; i<=MAX_NUM_GUARDS; i++ )
-            {
-                fread( &guards_[i], sizeof(Guard_T), 1, guardsFilePtr );         
+        LOGGING(ERRORS, "ERROR reading guards file %s", GUARDS_FILE_NAME);
+        return RESULT_ERROR;
+    }
 
-                // Check if end of file is reached and set flag in next record if needed
-                if ( !feof(guardsFilePtr) ) 
-                {
-                    if ( i < MAX_NUM_GUARDS )
-                    {
-                        LOGGING(INFO, "guard %i is type:%d channelId:%02d, guardId:%d guardThreshold:%d, guardLevel:%.1f",
-                                i+1, guards_[i].type, guards_[i].channelId, guards_[i].guardId, guards_[i].guardThreshold, guards_[i].guardLevel);
-                    }
-                    else
-                    {
-                        LOGGING(ERRORS, "WARNING more than %d guards found in file %s are discarded", MAX_NUM_GUARDS, GUARDS_FILE_NAME);
-                        break;
-                    }
-                }
-                else // end of file is reached
-                {
-                    guards_[i].type = END_OF_GUARDS;
-                    {
-                        if ( i > 0 ) LOGGING(VERBOSE, "total number of guards found is %i", i);
-                        else         LOGMSG (ERRORS, "WARNING no guards defined");
-                    }
-                    break; 
-                }
-            }    
-            fclose(guardsFilePtr);
-        }
+    // Configure control engine with channels, guards and program
+    if ( configureEngine() != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR configuring control engine with program file %s", programFileName_.c_str());
+        return RESULT_ERROR;
+    }
+
+    // Sample input/output channels in acquisition thread
+    if ( startSensorAcquisition() != RESULT_OK )
+    {
+        LOGMSG(ERRORS, "ERROR starting sensor acquisition");
+        return RESULT_ERROR;
     }
     
     return RESULT_OK;
@@ -307,7 +382,6 @@ Result HostTimer::initialize()
 Result HostTimer::start()
 {
     // Initialization of variables requiring persistence interloops.
-    Byte_T manualTimeout, programSetpoints = 0x00;
     long prevWeekMinute;
 
     // Main execution loop
@@ -321,16 +395,42 @@ Result HostTimer::start()
         }
 
         // NORMAL PROGRAM EXECUTION
-        Byte_T dutyCyclesMask = 0xFF, conditionsMask = 0xFF, triggersMask = 0x00, relaySetpoints = 0x00;
+        ControlEngine::Outputs_T outputs;
         // Calculate week minute
-        time_t now = time(0);
-        tm * tmTime = localtime(&now);
-        long weekMinute = (tmTime->tm_wday==0 ? 6 : tmTime->tm_wday - 1)*24*60 + tmTime->tm_hour*60 + tmTime->tm_min;
+        struct timespec nowTime;
+        clock_->now(nowTime);
+        time_t now = nowTime.tv_sec;
+        long weekSecond = clock_->weekSecond(now);
+        long weekMinute = weekSecond / 60;
         if ( weekMinute != prevWeekMinute )
         {
             LOGGING(INFO, "weekMinute: address 0x%x = %d corresponding to weekDay:%d, hour:%d, minute:%d",
-                          weekMinute, weekMinute, (tmTime->tm_wday==0 ? 6 : tmTime->tm_wday), tmTime->tm_hour, tmTime->tm_min);
+                          weekMinute, weekMinute, weekMinute/(24*60) + 1, (weekMinute/60)%24, weekMinute%60);
+            LOGGING(INFO, "ticks:%llu overruns:%llu missedTicks:%llu relayIo:%llu relayTampers:%llu edges:%llu maxEdgeLatency:%lld us",
+                          static_cast<unsigned long long>(tickScheduler_->getTickCount()),
+                          static_cast<unsigned long long>(tickScheduler_->getOverrunCount()),
+                          static_cast<unsigned long long>(tickScheduler_->getMissedTickCount()),
+                          static_cast<unsigned long long>(relayOutputs_->getIoCount()),
+                          static_cast<unsigned long long>(relayOutputs_->getTamperCount()),
+                          static_cast<unsigned long long>(edgeCount_),
+                          static_cast<long long>(maxEdgeLatencyNs_ / 1000));
+            i2cBus_->logStats();
             prevWeekMinute = weekMinute;
+
+            // Relay transitions of every day, to tune guard hysteresis, debounce and relay minimum times
+            uint64_t switchCount = 0u;
+            for ( unsigned int i=0; i < NUM_DRIVEN_RELAYS; i++ ) switchCount += relayOutputs_->getSwitchCount(i);
+            long weekDay = weekMinute / (24*60);
+            if ( weekDay != prevWeekDay_ )
+            {
+                if ( prevWeekDay_ >= 0l )
+                {
+                    LOGGING(INFO, "relay transitions of weekDay:%ld: %llu", prevWeekDay_ + 1,
+                                  static_cast<unsigned long long>(switchCount - daySwitchCount_));
+                }
+                prevWeekDay_ = weekDay;
+                daySwitchCount_ = switchCount;
+            }
         }
 
         // Update week minute in status file
@@ -341,160 +441,109 @@ Result HostTimer::start()
             ASSERT(0);
         }
 
-	    // Compose duty cycles mask
-		if ( composeDutyCyclesMask(dutyCyclesMask) != RESULT_OK )
-		{
-			LOGMSG(ERRORS, "ERROR composing duty cycles mask");
-			return RESULT_ERROR;
-		}
-
-        // Read input/output channels
-        if ( readInputOutputChannels() != RESULT_OK )
+        // Latest samples of input/output channels, without waiting for acquisition thread
+        unsigned int staleChannels = sensorAcquisition_->readLatest(ioChannelValues_, MAX_SAMPLE_AGE_SECONDS*1000000000ll);
+        if ( staleChannels != 0u )
         {
-            LOGMSG(ERRORS, "ERROR reading input/output channels");
-            return RESULT_ERROR; 
+            LOGGING(ERRORS, "WARNING %d input/output channels without sample of last %d s", staleChannels, MAX_SAMPLE_AGE_SECONDS);
+        }
+        // Levels read on edges are newer than samples taken before them
+        for ( auto it = digitalEdges_.begin(); it != digitalEdges_.end(); )
+        {
+            SensorAcquisition::Sample_T sample;
+            if ( sensorAcquisition_->readLatest(it->first, sample) && sample.timestampNs > it->second.timestampNs ) it = digitalEdges_.erase(it);
+            else
+            {
+                ioChannelValues_[it->first] = it->second.value;
+                it++;
+            }
         }
         if ( ( timerStatus_->updateItem(TimerStatus::INPUTS_OUTPUTS, ioChannelValues_)) != RESULT_OK )
         {
             LOGMSG(ERRORS, "ERROR updating status of inputs/outputs");
         }
- 
-        if ( ( programFileName_ == "MANUAL.prog" ) )
+
+        // Compute relay set points
+        if ( engine_->step(weekSecond, ioChannelValues_, outputs) != RESULT_OK )
         {
-            if ( manualModeOn_ )
-            {
-				if ( manualStartMinute_ == -1l )
-				{
-					LOGMSG(VERBOSE, "starting of manual program");
-
-					// Set manual start minute the first loop
-					manualStartMinute_ = weekMinute;
-
-					// Read manual set point from Manual.prog file
-					if ( (fseek(programFilePtr_, 0l, SEEK_SET)) != 0 )
-					{
-						LOGMSG(ERRORS, "ERROR seeking program file pointer in position 0l");
-						ASSERT(0);
-					}
-					if ( (fread( &programSetpoints, sizeof(Byte_T), 1, programFilePtr_)) != 1 )
-					{
-						LOGMSG(ERRORS, "ERROR reading program set points in position 0l");
-						ASSERT(0);
-					}
-					LOGBIN(VERBOSE, "program set points: 0x%02x", programSetpoints);
-
-					// Read manual time out from Manual.prog file
-					if ( (fread( &manualTimeout, sizeof(Byte_T), 1, programFilePtr_)) != 1 )
-					{
-						LOGMSG(ERRORS, "ERROR reading time out in next position");
-						ASSERT(0);
-					}
-					LOGGING(VERBOSE, "manual timeout is %d minutes", manualTimeout);
-				}
-				else
-				{
-					// Check manual time out
-					bool overrun = ( weekMinute < manualStartMinute_ );
-					if
-					(
-						( !overrun && ( (weekMinute - manualStartMinute_) >= manualTimeout ) )
-						||
-						( overrun && ( ( ( 7*24*60 - 1) - manualStartMinute_ + weekMinute  ) >= manualTimeout ) )
-					)
-					{
-						programSetpoints = 0x00;
-						manualStartMinute_ = -1l;
-						manualModeOn_ = false;
-
-						LOGMSG(VERBOSE, "ending of manual program");
-					}
-				}
-
-				// Calculate masked relay set points
-				relaySetpoints = programSetpoints & dutyCyclesMask;
-				LOGBIN(VERBOSE, "relays set points: 0x%02x", relaySetpoints);
-            }
+            LOGGING(ERRORS, "ERROR computing relay set points of program file %s", programFileName_.c_str());
+            return RESULT_ERROR;
         }
-        else // This is the regular program operation
-        {
-
-			// Read relay set points from program file
-			if ( (fseek(programFilePtr_, weekMinute, SEEK_SET)) != 0 )
-			{
-				LOGGING(ERRORS, "ERROR seeking program file pointer in position %d", weekMinute);
-				ASSERT(0);
-			}
-			if ( (fread( &programSetpoints, sizeof(Byte_T), 1, programFilePtr_)) != 1 )
-			{
-				LOGGING(ERRORS, "ERROR reading program set points in position %d", weekMinute);
-				ASSERT(0);
-			}
-			LOGBIN(VERBOSE, "program set points: 0x%02x", programSetpoints);
-
-			// Compose conditions mask
-			LOGMSG(VERBOSE, "composing conditions mask...");
-			if ( composeConditionsMask(conditionsMask) != RESULT_OK )
-			{
-				LOGMSG(ERRORS, "ERROR composing conditions mask");
-				return RESULT_ERROR;
-			}
-			LOGBIN(VERBOSE, "conditions mask: 0x%02x", conditionsMask);
-
-			// Compose triggers mask
-			LOGMSG(VERBOSE, "composing triggers mask...");
-			if ( composeTriggersMask(triggersMask) != RESULT_OK )
-			{
-				LOGMSG(ERRORS, "ERROR composing triggers mask");
-				return RESULT_ERROR;
-			}
-			LOGBIN(VERBOSE, "triggers mask: 0x%02x", triggersMask);
-
-			// Calculate masked relay set points
-			relaySetpoints = ( triggersMask | ( conditionsMask & programSetpoints ) ) & dutyCyclesMask;
-			LOGBIN(VERBOSE, "relays set points: 0x%02x", relaySetpoints);
-        }     
-
-        // Set relay set points
+        LOGBIN(VERBOSE, "program set points: 0x%llx", outputs.programSetpoints);
+        LOGBIN(VERBOSE, "conditions mask: 0x%llx", outputs.conditionsMask);
+        LOGBIN(VERBOSE, "triggers mask: 0x%llx", outputs.triggersMask);
+        LOGBIN(VERBOSE, "relays set points: 0x%llx", outputs.relaySetpoints);
+
+        // Set relay set points; only changed relays are written
         LOGMSG(VERBOSE, "setting level to relay channels..."); 
-        for (uint8_t i=0; i < NUM_OUTPUT_RELAYS; i++)
+        if ( relayOutputs_->commit(outputs.relaySetpoints, now) != RESULT_OK )
         {
-            signed int level = static_cast<signed int>( ( (0x01 << i) & relaySetpoints ) >> i );
-            if( gpio_->setLevel(i, level) != RESULT_OK )
-            {
-                LOGGING(ERRORS, "ERROR setting level %d in channel id %d", level, i);
-                return RESULT_ERROR;
-            }
+            LOGBIN(ERRORS, "ERROR setting relay set points 0x%llx", outputs.relaySetpoints);
+            return RESULT_ERROR;
+        }
+        if ( !relaysCommitted_ )
+        {
+            LOGGING(INFO, "startup: first relay set points committed %lld ms after construction",
+                          static_cast<long long>( std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startupBegin_).count() ));
+            relaysCommitted_ = true;
         }
         // Update setpoints and masks in status file
-        if ( ( timerStatus_->updateItem(TimerStatus::PROGRAM_SETPOINTS, stringfo, programSetpoints, this) ) != RESULT_OK )
+        if ( ( timerStatus_->updateItem(TimerStatus::PROGRAM_SETPOINTS, stringfo, outputs.programSetpoints, this) ) != RESULT_OK )
         {
-            LOGGING(ERRORS, "ERROR updating programSetpoints status item %d with value %d", TimerStatus::PROGRAM_SETPOINTS, programSetpoints);
+            LOGGING(ERRORS, "ERROR updating programSetpoints status item %d with value %s", TimerStatus::PROGRAM_SETPOINTS, RelayMask::toString(outputs.programSetpoints).c_str());
             ASSERT(0);
         }
-        if ( ( timerStatus_->updateItem(TimerStatus::DUTY_CYCLES_MASK, stringfo, dutyCyclesMask, this) ) != RESULT_OK )
+        if ( ( timerStatus_->updateItem(TimerStatus::DUTY_CYCLES_MASK, stringfo, outputs.dutyCyclesMask, this) ) != RESULT_OK )
         {
-            LOGGING(ERRORS, "ERROR updating dutyCyclesMask status item %d with value %d", TimerStatus::DUTY_CYCLES_MASK, dutyCyclesMask);
+            LOGGING(ERRORS, "ERROR updating dutyCyclesMask status item %d with value %s", TimerStatus::DUTY_CYCLES_MASK, RelayMask::toString(outputs.dutyCyclesMask).c_str());
             ASSERT(0);
         }
-        if ( ( timerStatus_->updateItem(TimerStatus::TRIGGERS_MASK, stringfo, triggersMask, this) ) != RESULT_OK )
+        if ( ( timerStatus_->updateItem(TimerStatus::TRIGGERS_MASK, stringfo, outputs.triggersMask, this) ) != RESULT_OK )
         {
-            LOGGING(ERRORS, "ERROR updating triggersMask status item %d with value %d", TimerStatus::TRIGGERS_MASK, triggersMask);
+            LOGGING(ERRORS, "ERROR updating triggersMask status item %d with value %s", TimerStatus::TRIGGERS_MASK, RelayMask::toString(outputs.triggersMask).c_str());
             ASSERT(0);
         }
-        if ( ( timerStatus_->updateItem(TimerStatus::CONDITIONS_MASK, stringfo, conditionsMask, this) ) != RESULT_OK )
+        if ( ( timerStatus_->updateItem(TimerStatus::CONDITIONS_MASK, stringfo, outputs.conditionsMask, this) ) != RESULT_OK )
         {
-            LOGGING(ERRORS, "ERROR updating conditionsMask status item %d with value %d", TimerStatus::CONDITIONS_MASK, conditionsMask);
+            LOGGING(ERRORS, "ERROR updating conditionsMask status item %d with value %s", TimerStatus::CONDITIONS_MASK, RelayMask::toString(outputs.conditionsMask).c_str());
             ASSERT(0);
         }
-        if ( ( timerStatus_->updateItem(TimerStatus::RELAY_SETPOINTS, stringfo, relaySetpoints, this) ) != RESULT_OK )
+        if ( ( timerStatus_->updateItem(TimerStatus::RELAY_SETPOINTS, stringfo, outputs.relaySetpoints, this) ) != RESULT_OK )
         {
-            LOGGING(ERRORS, "ERROR updating relaySetpoints status item %d with value %d", TimerStatus::RELAY_SETPOINTS, relaySetpoints);
+            LOGGING(ERRORS, "ERROR updating relaySetpoints status item %d with value %s", TimerStatus::RELAY_SETPOINTS, RelayMask::toString(outputs.relaySetpoints).c_str());
             ASSERT(0);
         }
 
-        // Wait 1 second for next iteration
-        usleep(1000000);
+        // Wait for next tick aligned to wall-clock second boundaries
+        // Guards need their inputs sampled every tick; otherwise sleep until set points can next change
+        // Digital input edges cut the wait short and are processed at once; a deadline passed
+        // meanwhile releases the tick at once, so edges cannot starve it
         LOGRESS(INFO, "waiting for next minute", ".");
+        Result waitResult;
+        bool edge = false;
+        do
+        {
+            if ( edge && processDigitalEdges() != RESULT_OK )
+            {
+                // Edges left pending would wake up the wait again at once
+                LOGMSG(ERRORS, "ERROR processing digital input edges, inputs are only sampled from now on");
+                gpio_->setEdges(0u);
+                edgeFd_ = -1;
+            }
+            long idleSeconds = engine_->secondsToNextEvent(weekSecond);
+            if ( idleSeconds > 0 )
+            {
+                idleSeconds = std::min( idleSeconds, static_cast<long>(maxIdleMinutes_*60) - weekSecond % 60 );
+                waitResult = tickScheduler_->waitUntil(now + idleSeconds, edgeFd_, edge);
+            }
+            else waitResult = tickScheduler_->waitNextTick(edgeFd_, edge);
+        }
+        while ( waitResult == RESULT_OK && edge );
+        if ( waitResult != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR waiting for next tick");
+            return RESULT_ERROR;
+        }
     }
     
     return RESULT_OK;
@@ -503,10 +552,7 @@ Result HostTimer::start()
 void HostTimer::shutdown()
 {
     LOGMSG(VERBOSE, "executing...");
-    for (uint8_t i=0; i < NUM_OUTPUT_RELAYS; i++)
-    {
-        gpio_->setLevel(i, 0);
-    }
+    gpio_->setLevels(relayGpioMask_, 0u);
 }
 
 
@@ -552,18 +598,18 @@ Result HostTimer::checkProgramUpdate(bool reinitialize)
             return result;
         }
 
-        // Initialize HostTimer
+        // Reconfigure HostTimer with the updated files only
         if (reinitialize)
         {
-        	result = initialize();
+        	result = reconfigure();
             if ( result != RESULT_OK )
             {
-                LOGGING(ERRORS, "ERROR initializing with result %d", result);
+                LOGGING(ERRORS, "ERROR reconfiguring with result %d", result);
                 return result;
             }
 
             // Initialize in case of manual program
-            if ( programFileName_ == "MANUAL.prog" ) manualModeOn_ = true;
+            engine_->startManualProgram();
         }
     }
     
@@ -574,14 +620,10 @@ Result HostTimer::updateProgramFile()
 {
     char linuxCommand[50];
 
-    // Close current program file if exists
-    if ( programFilePtr_ != NULL )
-    {
-        LOGGING(INFO, "closing program file %s if exists...", programFileName_.c_str());
-        fclose(programFilePtr_);
-    }
+    // Current program file stays mapped until the new one is loaded by initialize()
 
     // Rename all _update files removing _update
+    updatedFiles_.clear();
     std::ifstream updateListFilePtr("Update.list");
     if ( !updateListFilePtr.is_open() )
     {
@@ -598,6 +640,7 @@ Result HostTimer::updateProgramFile()
             sprintf(linuxCommand, "mv -f %s %s", fileToUpdate.c_str(), updatedFile.c_str());
             LOGGING(INFO, "executing Linux command '%s'...", linuxCommand);
             system(linuxCommand);
+            updatedFiles_.insert(updatedFile);
             updateListFilePtr >> fileToUpdate; 
         }
         updateListFilePtr.close();
@@ -612,6 +655,274 @@ Result HostTimer::updateProgramFile()
     return RESULT_OK;
 }
 
+Result HostTimer::reconfigure()
+{
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    // Program set and program file
+    std::string prevProgramFileName = programFileName_;
+    if ( readProgramSetFile() != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR reading program set file %s", PROGRAM_SET_FILE_NAME);
+        return RESULT_ERROR;
+    }
+    bool programChanged = ( programFileName_ != prevProgramFileName ) || ( updatedFiles_.count(programFileName_) != 0 );
+    if ( programChanged && loadProgramFile() != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR opening program file %s, keeping program file %s", programFileName_.c_str(), prevProgramFileName.c_str());
+        programFileName_ = prevProgramFileName;
+        return RESULT_ERROR;
+    }
+
+    // Channels: only changed channels are configured again
+    unsigned int numChangedChannels = 0u;
+    if ( updatedFiles_.count(CHANNELS_FILE_NAME) != 0 )
+    {
+        Channel_T channels[NUM_HOST_CHANNELS];
+        if ( readChannelsFile(channels) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR reading channels file %s", CHANNELS_FILE_NAME);
+            return RESULT_ERROR;
+        }
+        for ( unsigned int i=0; i < NUM_HOST_CHANNELS; i++ )
+        {
+            if ( memcmp(&channels[i], &channels_[i], sizeof(Channel_T)) == 0 ) continue;
+
+            // Acquisition thread must not read channels being configured
+            if ( numChangedChannels == 0u ) sensorAcquisition_->stop();
+            LOGGING(INFO, "channel %d changed to name:%s type:%d model:%s dutyCycle:%d", i, channels[i].name, channels[i].type, channels[i].model, channels[i].dutyCycle);
+            channels_[i] = channels[i];
+            numChangedChannels++;
+            if ( configureChannel(i) != RESULT_OK )
+            {
+                startSensorAcquisition();
+                return RESULT_ERROR;
+            }
+        }
+
+        // Release NTC thermistor models no longer used
+        for ( auto it = ntcThermistors_.begin(); it != ntcThermistors_.end(); )
+        {
+            bool used = false;
+            for ( const Channel_T & channel : channels_ )
+            {
+                if ( channel.type == INPUT_NTC_THERMISTOR && it->first == channel.model ) used = true;
+            }
+            if ( used ) it++;
+            else
+            {
+                LOGGING(INFO, "releasing unused NTC thermistor model %s", it->first.c_str());
+                delete it->second;
+                it = ntcThermistors_.erase(it);
+            }
+        }
+        if ( numChangedChannels > 0u && startSensorAcquisition() != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR starting sensor acquisition");
+            return RESULT_ERROR;
+        }
+    }
+
+    // Guards
+    bool guardsChanged = false;
+    if ( updatedFiles_.count(GUARDS_FILE_NAME) != 0 )
+    {
+        Guard_T guards[MAX_NUM_GUARDS];
+        if ( readGuardsFile(guards) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR reading guards file %s", GUARDS_FILE_NAME);
+            return RESULT_ERROR;
+        }
+        for ( unsigned int i=0; i < MAX_NUM_GUARDS && !guardsChanged; i++ )
+        {
+            guardsChanged = ( memcmp(&guards[i], &guards_[i], sizeof(Guard_T)) != 0 );
+            if ( guards[i].type == END_OF_GUARDS ) break;
+        }
+        if ( guardsChanged ) memcpy(guards_, guards, sizeof(guards_));
+    }
+
+    // Engine; relays keep their levels until next tick
+    if ( programChanged || numChangedChannels > 0u || guardsChanged )
+    {
+        if ( configureEngine() != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR configuring control engine with program file %s", programFileName_.c_str());
+            return RESULT_ERROR;
+        }
+    }
+
+    LOGGING(INFO, "reconfigured in %lld us: program %s, %d channels changed, guards %s",
+                  static_cast<long long>( std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count() ),
+                  programChanged ? "changed" : "unchanged", numChangedChannels, guardsChanged ? "changed" : "unchanged");
+
+    return RESULT_OK;
+}
+
+Result HostTimer::readChannelsFile(Channel_T* channels)
+{
+    LOGGING(INFO, "reading file %s...", CHANNELS_FILE_NAME);
+    ControlFiles controlFiles("HostTimerChannels");
+    if ( controlFiles.readChannels(CHANNELS_FILE_NAME, channels) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR reading file %s", CHANNELS_FILE_NAME);
+        ASSERT(0);
+    }
+    for ( unsigned int i=0; i < NUM_HOST_CHANNELS; i++ )
+    {
+        LOGGING(INFO, "channel id:%02d name:%s type:%d model:%s dutyCycle:%d", channels[i].id, channels[i].name, channels[i].type, channels[i].model, channels[i].dutyCycle);
+    }
+
+    return RESULT_OK;
+}
+
+Result HostTimer::configureChannel(unsigned int i)
+{
+    switch (channels_[i].type)
+    {
+    case INPUT_DIGITAL:
+        if ( std::string(channels_[i].model) == "N.O." )
+        {
+            if ( gpio_->setMode(gpioIdOf(i), IGpio::INPUT_DIGITAL_INVERTED) != RESULT_OK )
+            {
+                LOGGING(ERRORS, "ERROR setting mode input digital in GPIO id %d", i);
+                return RESULT_ERROR;
+            }
+        }
+        else if ( std::string(channels_[i].model) == "N.C." )
+        {
+            if ( gpio_->setMode(gpioIdOf(i), IGpio::INPUT_DIGITAL) != RESULT_OK )
+            {
+                LOGGING(ERRORS, "ERROR setting mode input digital inverted in GPIO id %d", i);
+                return RESULT_ERROR;
+            }
+        }
+        else
+        {
+            LOGGING(ERRORS, "ERROR: unexpected input digital model %s found", channels_[i].model);
+            return RESULT_ERROR;
+        }
+        break;
+    case OUTPUT_DIGITAL:
+        if ( std::string(channels_[i].model) == "N.O." )
+        {
+            if ( gpio_->setMode(gpioIdOf(i), IGpio::OUTPUT_DIGITAL) != RESULT_OK)
+            {
+                LOGGING(ERRORS, "ERROR setting mode output digital in GPIO id %d", i);
+                return RESULT_ERROR;
+            }
+        }
+        else if ( std::string(channels_[i].model) == "N.C." )
+        {
+            if ( gpio_->setMode(gpioIdOf(i), IGpio::OUTPUT_DIGITAL_INVERTED) != RESULT_OK)
+            {
+                LOGGING(ERRORS, "ERROR setting mode output digital inverted in GPIO id %d", i);
+                return RESULT_ERROR;
+            }
+        }
+        else
+        {
+            LOGGING(ERRORS, "ERROR: unexpected output digital model %s found", channels_[i].model);
+            return RESULT_ERROR;
+        }
+        break;
+    case OUTPUT_RELAY:
+        if ( i >= NUM_DRIVEN_RELAYS )
+        {
+            LOGGING(ERRORS, "WARNING relay channel %d is on an expansion board without driver, it is not driven", i);
+            break;
+        }
+        if ( gpio_->setMode(gpioIdOf(i), IGpio::OUTPUT_DIGITAL) != RESULT_OK)
+        {
+            LOGGING(ERRORS, "ERROR setting mode output digital in GPIO id %d", i);
+            return RESULT_ERROR;
+        }
+        // setMode() leaves relay at level low: all relays are written at next commit
+        relayOutputs_->invalidate();
+        break;
+    case INPUT_ANALOG:
+        break;
+    case INPUT_NTC_THERMISTOR:
+        if ( ntcThermistors_.find( channels_[i].model ) == ntcThermistors_.end() )
+        {
+            LOGGING(VERBOSE, "contructing new AnalogSensorNtcThermistor model %s", channels_[i].model);
+            ntcThermistors_[channels_[i].model] = new AnalogSensorNtcThermistor("NtcThermistor", channels_[i].model);
+            std::string ntcThermistorName = std::string("NtcThermistor") + channels_[i].model;
+            LOGGING(VERBOSE, "setting interface IGpio for instance:%s", ntcThermistorName.c_str());
+            ntcThermistors_[channels_[i].model]->setInterface(ntcThermistorName.c_str(), "IGpio", static_cast<IGpio *>(gpioAnalog_));
+            LOGGING(VERBOSE, "initializing channel %d", i);
+            ntcThermistors_[channels_[i].model]->initialize();
+            ntcThermistors_[channels_[i].model]->setVccInput(ntcVccInput_);
+        }
+        if ( analogIdNumber_.find(channels_[i].id) != analogIdNumber_.end() )
+        {
+            // Calibration of the sensor of the channel
+            unsigned int analogChannel = i - ( NUM_OUTPUT_RELAYS + NUM_DIO_CHANNELS );
+            int32_t gainPpm = 1000000;
+            int32_t offsetMilliDegrees = 0;
+            ConstantsServices constsServices(CONSTANTS_FILE_NAME);
+            constsServices.readConstant(("AIN_CAL_GAIN_PPM_" + std::to_string(analogChannel)).c_str(), gainPpm);
+            constsServices.readConstant(("AIN_CAL_OFFSET_MDEGC_" + std::to_string(analogChannel)).c_str(), offsetMilliDegrees);
+            ntcThermistors_[channels_[i].model]->setCalibration(analogIdNumber_[channels_[i].id], gainPpm * 1e-6f, offsetMilliDegrees * 1e-3f);
+        }
+        break;
+    }
+
+    return RESULT_OK;
+}
+
+Result HostTimer::readGuardsFile(Guard_T* guards)
+{
+    LOGGING(VERBOSE, "reading file %s...", GUARDS_FILE_NAME);
+    ControlFiles controlFiles("HostTimerGuards");
+    if ( controlFiles.readGuards(GUARDS_FILE_NAME, guards) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "WARNING opening file %s", GUARDS_FILE_NAME);
+        guards[0].type = END_OF_GUARDS;
+    }
+    unsigned int i=0;
+    for ( ; i < MAX_NUM_GUARDS && guards[i].type != END_OF_GUARDS; i++ )
+    {
+        LOGGING(INFO, "guard %i is type:%d channelId:%02d, guardId:%d guardThreshold:%d, guardLevel:%.1f",
+                i+1, guards[i].type, guards[i].channelId, guards[i].guardId, guards[i].guardThreshold, guards[i].guardLevel);
+    }
+    if ( i > 0 ) LOGGING(VERBOSE, "total number of guards found is %i", i);
+    else         LOGMSG (ERRORS, "WARNING no guards defined");
+
+    return RESULT_OK;
+}
+
+Result HostTimer::loadProgramFile()
+{
+    // Manual.prog holds set points and time out; regular programs are in format v1 or v2
+    if ( programFileName_ == "MANUAL.prog" ) return programStorage_->load(programFileName_.c_str(), 2u);
+
+    return programStorage_->loadWeekProgram(programFileName_.c_str(), NUM_OUTPUT_RELAYS);
+}
+
+Result HostTimer::configureEngine()
+{
+    if ( engine_->configure(channels_, guards_) != RESULT_OK )
+    {
+        LOGMSG(ERRORS, "ERROR configuring channels and guards of control engine");
+        return RESULT_ERROR;
+    }
+
+    // Manual program is not indexed: set points and time out are read once from Manual.prog
+    if ( programFileName_ == "MANUAL.prog" )
+    {
+        Byte_T manualSetpoints, manualTimeout;
+        if ( programStorage_->readByte(0, manualSetpoints) != RESULT_OK || programStorage_->readByte(1, manualTimeout) != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR reading manual program set points and time out");
+            return RESULT_ERROR;
+        }
+        engine_->setManualProgram(manualSetpoints, manualTimeout);
+        return RESULT_OK;
+    }
+
+    return engine_->setProgram(programStorage_->getImage());
+}
+
 #ifdef GENERATE_EXAMPLE_OF_CHANNELS_FILE
 Result HostTimer::generateChannelsFile()
 {
@@ -694,192 +1005,213 @@ Result HostTimer::generateGuardsFile()
 }
 #endif
 
-Result HostTimer::readInputOutputChannels()
+Result HostTimer::startSensorAcquisition()
 {
-    for (auto channel : channels_)
+    std::vector<uint8_t> channelIds;
+    digitalGpioMask_ = 0u;
+    digitalInputGpioMask_ = 0u;
+    analogInputMask_ = 0u;
+    ntcBatches_.clear();
+    for ( const Channel_T & channel : channels_ )
     {
-        Result result = RESULT_OK;
-        signed int level = 0;
-        float floatBuffer = 0.0;
-
         switch ( channel.type )
         {
         case INPUT_DIGITAL:
+            digitalInputGpioMask_ |= ( 1u << gpioIdOf(channel.id) );
+            digitalGpioMask_ |= ( 1u << gpioIdOf(channel.id) );
+            channelIds.push_back(channel.id);
+            break;
         case OUTPUT_DIGITAL:
-            result = gpio_->getLevel(channel.id, level);
-            if ( result != RESULT_OK )
-            {
-                LOGGING(ERRORS, "ERROR getting level of Gpio ID %d with result %d", channel.id, result);
-                return result;
-            }
-            ioChannelValues_[channel.id] = static_cast<float>(level);
+            digitalGpioMask_ |= ( 1u << gpioIdOf(channel.id) );
+            channelIds.push_back(channel.id);
             break;
         case INPUT_ANALOG:
-            if ( analogIdNumber_.find(channel.id) == analogIdNumber_.end() )
-            {
-                LOGGING(ERRORS, "ERROR: channel id %d not found in analogIdNumber_ map", channel.id);
-                return RESULT_ERROR;
-            }
-            result = gpioAnalog_->getVoltage(analogIdNumber_[channel.id], floatBuffer);
-            if ( result != RESULT_OK )
-            {
-                LOGGING(ERRORS, "ERROR gettig voltage of gpio analog id %d", analogIdNumber_[channel.id]);
-                return result;
-            }
-            ioChannelValues_[channel.id] = floatBuffer;
-            break;
         case INPUT_NTC_THERMISTOR:
-            if ( analogIdNumber_.find(channel.id) == analogIdNumber_.end() )
+            if ( analogIdNumber_.find(channel.id) != analogIdNumber_.end() )
             {
-                LOGGING(ERRORS, "ERROR: channel id %d not found in analogIdNumber_ map", channel.id);
-                return RESULT_ERROR;
+                analogInputMask_ |= static_cast<GpioAnalogFrontEnd::InputMask_T>( 1u << analogIdNumber_[channel.id] );
             }
-            if ( ntcThermistors_.find(channel.model) == ntcThermistors_.end() )
+            if ( channel.type == INPUT_NTC_THERMISTOR && ntcVccInput_ != AnalogSensorNtcThermistor::NO_VCC_INPUT )
             {
-                LOGGING(ERRORS, "ERROR: NTC model %s not found in ntcThermistors_ map", channel.model);
-                return RESULT_ERROR;
+                analogInputMask_ |= static_cast<GpioAnalogFrontEnd::InputMask_T>( 1u << ntcVccInput_ );
             }
-            result = ntcThermistors_[channel.model]->readValue(analogIdNumber_[channel.id], floatBuffer);
-            if ( result != RESULT_OK )
+            if ( channel.type == INPUT_NTC_THERMISTOR && analogIdNumber_.find(channel.id) != analogIdNumber_.end() &&
+                 ntcThermistors_.find(channel.model) != ntcThermistors_.end() )
             {
-                LOGGING(ERRORS, "ERROR reading value of NTC Thermistor ID %d with result %d", analogIdNumber_[channel.id], result);
-                return result;
+                // One batch per model, found once here instead of every pass
+                AnalogSensorNtcThermistor * ntcThermistor = ntcThermistors_[channel.model];
+                auto batch = std::find_if(ntcBatches_.begin(), ntcBatches_.end(), [ntcThermistor] (const NtcBatch_T & ntcBatch)
+                {
+                    return ntcBatch.ntcThermistor == ntcThermistor;
+                });
+                if ( batch == ntcBatches_.end() ) batch = ntcBatches_.insert(ntcBatches_.end(), NtcBatch_T { ntcThermistor, {}, {} });
+                batch->inputs.push_back(analogIdNumber_[channel.id]);
+                batch->channelIds.push_back(channel.id);
             }
-            ioChannelValues_[channel.id] =  floatBuffer;
+            channelIds.push_back(channel.id);
+            break;
+        default:
             break;
-        default: continue;
         }
-        LOGGING(VERBOSE, "channel id:%d name:%s type:%d model:%s value:%.1f", channel.id, channel.name, channel.type, channel.model, ioChannelValues_[channel.id]);
     }
 
-    return RESULT_OK;
-}
-
-Result HostTimer::composeDutyCyclesMask(Byte_T & dutyCyclesMask)
-{
-    dutyCyclesMask = 0xFF;
-
-    time_t now = time(0);
-    tm * tmTime = localtime(&now);
-
-    for (unsigned int i=0; i < NUM_OUTPUT_RELAYS; i++ )
+    // Digital inputs also wake up the control loop on edges
+    digitalEdges_.clear();
+    Result result = gpio_->setEdges(digitalInputGpioMask_);
+    edgeFd_ = gpio_->getEdgeFd();
+    if ( result != RESULT_OK )
     {
-
-        if ( tmTime->tm_sec >= channels_[i].dutyCycle )
-	    {
-	        dutyCyclesMask &= ( 0xFF ^ ( 0x01 << channels_[i].id ) );
-
-            LOGGING(VERBOSE, "updating mask current second:%d dutyCycle:%d", tmTime->tm_sec, channels_[i].dutyCycle);
-	    }
+        LOGGING(ERRORS, "WARNING edges of digital inputs not detected with result %d, inputs are only sampled", result);
+        gpio_->setEdges(0u);
+        edgeFd_ = -1;
     }
 
-    return RESULT_OK;
-}
+    // Filters restart with the samples of the new channels
+    for ( ChannelFilter & filter : filters_ ) filter.reset();
+    std::fill(ntcValues_, ntcValues_ + NUM_HOST_CHANNELS, NAN);
 
-Result HostTimer::composeConditionsMask(Byte_T & conditionsMask)
-{
-    conditionsMask = 0xFF;
-    
-    for (unsigned int i=0; i < sizeof(guards_)/sizeof(Guard_T); i++ )
+    return sensorAcquisition_->start(channelIds, [this] (uint8_t channelId, float & value)
     {
-        if ( guards_[i].type == END_OF_GUARDS) break;
-        if ( guards_[i].type == CONDITION )
+        for ( const Channel_T & channel : channels_ )
         {
-        	float signalValue = ioChannelValues_[guards_[i].guardId];
-            LOGGING(VERBOSE, "value of guardId:%02d is %.1f", guards_[i].guardId, signalValue);
+            if ( channel.id != channelId ) continue;
+            Result result = readChannel(channel, value);
+            if ( result == RESULT_OK ) value = filters_[channelId].apply(value);
+            return result;
+        }
+        return RESULT_ERROR;
+    },
+    [this] ()
+    {
+        // Digital channels are read at once; analog inputs not sampled are converted one by one
+        digitalLevelsRead_ = ( digitalGpioMask_ == 0u ) || ( gpio_->getLevels(digitalGpioMask_, digitalLevels_) == RESULT_OK );
+        bool analogSampled = ( analogInputMask_ == 0u ) || ( gpioAnalog_->sampleInputs(analogInputMask_) == RESULT_OK );
 
-            switch (guards_[i].guardThreshold)
+        // NTC channels of a model are converted in one call
+        for ( const NtcBatch_T & batch : ntcBatches_ )
+        {
+            // Values left NAN are reported by readChannel(); a batch over MAX_IDS is rejected as a whole
+            float values[AnalogSensorNtcThermistor::MAX_IDS];
+            std::fill(values, values + AnalogSensorNtcThermistor::MAX_IDS, NAN);
+            batch.ntcThermistor->readValues(batch.inputs.data(), values, static_cast<unsigned int>(batch.inputs.size()));
+            for ( unsigned int i=0; i < batch.channelIds.size() && i < AnalogSensorNtcThermistor::MAX_IDS; i++ )
             {
-                case MAXIMUM:
-                    if ( signalValue > guards_[i].guardLevel ) conditionsMask &= ( 0xFF ^ ( 0x01 << guards_[i].channelId ) );
-                    break;
-                case MINIMUM:
-                    if ( signalValue < guards_[i].guardLevel ) conditionsMask &= ( 0xFF ^ ( 0x01 << guards_[i].channelId ) );
-                    break;
-                case HIGHER_THAN:
-                    if ( signalValue <= guards_[i].guardLevel ) conditionsMask &= ( 0xFF ^ ( 0x01 << guards_[i].channelId ) );
-                    break;
-                case LOWER_THAN:
-                    if ( signalValue >= guards_[i].guardLevel ) conditionsMask &= ( 0xFF ^ ( 0x01 << guards_[i].channelId ) );
-                    break;
-                case EQUAL_TO:
-                    if ( signalValue != guards_[i].guardLevel ) conditionsMask &= ( 0xFF ^ ( 0x01 << guards_[i].channelId ) );
-                    break;
-                case UNEQUAL_TO:
-                    if ( signalValue == guards_[i].guardLevel ) conditionsMask &= ( 0xFF ^ ( 0x01 << guards_[i].channelId ) );
-                    break;
-                default:
-                    ASSERT(0);
-                    break;
+                ntcValues_[batch.channelIds[i]] = values[i];
             }
         }
-    }
-    return RESULT_OK;
+        return ( digitalLevelsRead_ && analogSampled ) ? RESULT_OK : RESULT_ERROR;
+    });
 }
 
-Result HostTimer::composeTriggersMask(Byte_T & triggersMask)
+Result HostTimer::readChannel(const Channel_T & channel, float & value)
 {
-    triggersMask = 0x00;
-    
-    for (unsigned int i=0; i < sizeof(guards_)/sizeof(Guard_T); i++ )
+    Result result = RESULT_OK;
+
+    switch ( channel.type )
     {
-        if ( guards_[i].type == END_OF_GUARDS) break;
-        if ( guards_[i].type == TRIGGER )
+    case INPUT_DIGITAL:
+    case OUTPUT_DIGITAL:
+        // Level read by getLevels() at the beginning of the acquisition pass
+        if ( !digitalLevelsRead_ )
         {
-        	float signalValue = ioChannelValues_[guards_[i].guardId];
-            LOGGING(VERBOSE, "value of guardId:%02d is %.1f", guards_[i].guardId, signalValue);
-
-            switch (guards_[i].guardThreshold)
-            {
-                case MAXIMUM:
-                    if ( signalValue <= guards_[i].guardLevel ) triggersMask |= ( 0x01 << guards_[i].channelId );
-                    break;
-                case MINIMUM:
-                    if ( signalValue >= guards_[i].guardLevel ) triggersMask |= ( 0x01 << guards_[i].channelId );
-                    break;
-                case HIGHER_THAN:
-                    if ( signalValue > guards_[i].guardLevel ) triggersMask |= ( 0x01 << guards_[i].channelId );
-                    break;
-                case LOWER_THAN:
-                    if ( signalValue < guards_[i].guardLevel ) triggersMask |= ( 0x01 << guards_[i].channelId );
-                    break;
-                case EQUAL_TO:
-                    if ( signalValue == guards_[i].guardLevel ) triggersMask |= ( 0x01 << guards_[i].channelId );
-                    break;
-                case UNEQUAL_TO:
-                    if ( signalValue != guards_[i].guardLevel ) triggersMask |= ( 0x01 << guards_[i].channelId );
-                    break;
-                default:
-                    ASSERT(0);
-                    break;
-            }
+            LOGGING(ERRORS, "ERROR getting level of Gpio ID %d", gpioIdOf(channel.id));
+            return RESULT_ERROR;
+        }
+        value = static_cast<float>( ( digitalLevels_ >> gpioIdOf(channel.id) ) & 1u );
+        break;
+    case INPUT_ANALOG:
+        if ( analogIdNumber_.find(channel.id) == analogIdNumber_.end() )
+        {
+            LOGGING(ERRORS, "ERROR: channel id %d not found in analogIdNumber_ map", channel.id);
+            return RESULT_ERROR;
         }
+        result = gpioAnalog_->getVoltage(analogIdNumber_[channel.id], value);
+        if ( result != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR gettig voltage of gpio analog id %d", analogIdNumber_[channel.id]);
+            return result;
+        }
+        break;
+    case INPUT_NTC_THERMISTOR:
+        // Converted with the other channels of its model at the beginning of the acquisition pass;
+        // NAN if its input or model was not found, or its input could not be read
+        value = ntcValues_[channel.id];
+        if ( std::isnan(value) )
+        {
+            LOGGING(ERRORS, "ERROR reading value of NTC Thermistor of channel id %d model %s", channel.id, channel.model);
+            return RESULT_ERROR;
+        }
+        break;
+    default:
+        return RESULT_ERROR;
     }
+    LOGGING(VERBOSE, "channel id:%d name:%s type:%d model:%s value:%.1f", channel.id, channel.name, channel.type, channel.model, value);
+
     return RESULT_OK;
 }
 
-Result HostTimer::convertToStrByte(std::string & strByte, Byte_T byte)
+Result HostTimer::processDigitalEdges()
 {
-    char buffer[10];
-    
-    int numChars = sprintf(buffer, "%d%d%d%d%d%d%d%d",
-        (0x80&byte) == 0 ? 0 : 1,
-        (0x40&byte) == 0 ? 0 : 1,
-        (0x20&byte) == 0 ? 0 : 1,
-        (0x10&byte) == 0 ? 0 : 1,
-        (0x08&byte) == 0 ? 0 : 1,
-        (0x04&byte) == 0 ? 0 : 1,
-        (0x02&byte) == 0 ? 0 : 1,
-        (0x01&byte) == 0 ? 0 : 1);
-
-    if ( numChars != (int)8 )
+    IGpioBulk::GpioMask_T edges;
+    int64_t edgeTimeNs;
+    if ( gpio_->readEdges(edges, edgeTimeNs) != RESULT_OK ) return RESULT_ERROR;
+    edges &= digitalInputGpioMask_;
+    if ( edges == 0u ) return RESULT_OK;
+
+    // New levels of the digital inputs with edges
+    IGpioBulk::GpioMask_T levels;
+    if ( gpio_->getLevels(edges, levels) != RESULT_OK )
     {
-        LOGGING(ERRORS, "ERROR unexpected number of chars %d converted", numChars);
+        LOGGING(ERRORS, "ERROR getting levels of digital inputs with edges 0x%x", edges);
         return RESULT_ERROR;
     }
-    else strByte = buffer;
-    
-    return RESULT_OK;                
+    for ( const Channel_T & channel : channels_ )
+    {
+        if ( channel.type != INPUT_DIGITAL || ( ( edges >> gpioIdOf(channel.id) ) & 1u ) == 0u ) continue;
+        DigitalEdge_T & digitalEdge = digitalEdges_[channel.id];
+        digitalEdge.value = static_cast<float>( ( levels >> gpioIdOf(channel.id) ) & 1u );
+        digitalEdge.timestampNs = edgeTimeNs;
+        ioChannelValues_[channel.id] = digitalEdge.value;
+        LOGGING(VERBOSE, "edge of digital input channel id:%d name:%s to level %.0f", channel.id, channel.name, digitalEdge.value);
+    }
+
+    // Guards and relays with the new levels
+    ControlEngine::Outputs_T outputs;
+    struct timespec nowTime;
+    clock_->now(nowTime);
+    if ( engine_->step(clock_->weekSecond(nowTime.tv_sec), ioChannelValues_, outputs, false) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR computing relay set points of program file %s", programFileName_.c_str());
+        return RESULT_ERROR;
+    }
+    if ( relayOutputs_->commit(outputs.relaySetpoints, nowTime.tv_sec) != RESULT_OK )
+    {
+        LOGBIN(ERRORS, "ERROR setting relay set points 0x%llx", outputs.relaySetpoints);
+        return RESULT_ERROR;
+    }
+
+    int64_t latencyNs = SensorAcquisition::now() - edgeTimeNs;
+    edgeCount_++;
+    if ( latencyNs > maxEdgeLatencyNs_ ) maxEdgeLatencyNs_ = latencyNs;
+    LOGBIN(VERBOSE, "relays set points on edge: 0x%llx", outputs.relaySetpoints);
+    LOGGING(VERBOSE, "edge-to-relay latency %lld us", static_cast<long long>(latencyNs / 1000));
+
+    return RESULT_OK;
+}
+
+Result HostTimer::convertToStrMask(std::string & strMask, Mask_T mask)
+{
+    strMask = RelayMask::toString(mask);
+
+    return RESULT_OK;
+}
+
+uint8_t HostTimer::gpioIdOf(uint8_t channelId) const
+{
+    // On-board relays and digital inputs/outputs are consecutive GPIOs whatever the number of relays
+    if ( channelId < NUM_OUTPUT_RELAYS ) return channelId;
+
+    return static_cast<uint8_t>( channelId - NUM_OUTPUT_RELAYS + NUM_ONBOARD_RELAYS );
 }
 
 Result HostTimer::TimerStatus::updateItem(Item_T item, std::string & stringfo, long longifo)
@@ -931,7 +1263,7 @@ Result HostTimer::TimerStatus::updateItem(Item_T item, std::string & stringfo, l
     return RESULT_OK;
 }
 
-Result HostTimer::TimerStatus::updateItem(Item_T item, std::string & stringfo, Byte_T byteInfo, HostTimer * hostTimer)
+Result HostTimer::TimerStatus::updateItem(Item_T item, std::string & stringfo, Mask_T byteInfo, HostTimer * hostTimer)
 {
 	assert( hostTimer != nullptr );
 
@@ -943,19 +1275,27 @@ Result HostTimer::TimerStatus::updateItem(Item_T item, std::string & stringfo, B
         return RESULT_ERROR;
     }
 
+    // Headers aligned with the relay indices of the program set points header
+    const std::string setpointsLabel = "Program Setpoints [" + RelayMask::indexString() + "]";
+    auto header = [&setpointsLabel] (const char* label)
+    {
+        std::string str(label);
+        str.resize(setpointsLabel.length(), ' ');
+        return str + ": ";
+    };
     std::string itemHeader;
 
     switch (item)
     {
     case PROGRAM_SETPOINTS:
-        itemHeader = "Program Setpoints [76543210]: ";
-        if ( hostTimer->convertToStrByte(stringfo, static_cast<Byte_T>(byteInfo) ) != RESULT_OK );
+        itemHeader = setpointsLabel + ": ";
+        if ( hostTimer->convertToStrMask(stringfo, byteInfo) != RESULT_OK );
         if ( byteInfo == prevProgramSetpoints_ ) return RESULT_OK;
         else prevProgramSetpoints_ = byteInfo;
         break;
     case DUTY_CYCLES_MASK:
-        itemHeader = "Duty Cycles Mask            : ";
-        if ( hostTimer->convertToStrByte(stringfo, static_cast<Byte_T>(byteInfo) ) != RESULT_OK );
+        itemHeader = header("Duty Cycles Mask");
+        if ( hostTimer->convertToStrMask(stringfo, byteInfo) != RESULT_OK );
         if ( byteInfo == prevDutyCyclesMask_ ) return RESULT_OK;
         else
         {
@@ -964,20 +1304,20 @@ Result HostTimer::TimerStatus::updateItem(Item_T item, std::string & stringfo, B
         }
         break;
     case TRIGGERS_MASK:
-        itemHeader = "Triggers Mask               : ";
-        if ( hostTimer->convertToStrByte(stringfo, static_cast<Byte_T>(byteInfo) ) != RESULT_OK );
+        itemHeader = header("Triggers Mask");
+        if ( hostTimer->convertToStrMask(stringfo, byteInfo) != RESULT_OK );
         if ( byteInfo == prevTriggersMask_ ) return RESULT_OK;
         else prevTriggersMask_ = byteInfo;
         break;
     case CONDITIONS_MASK:
-        itemHeader = "Conditions Mask             : ";
-        if ( hostTimer->convertToStrByte(stringfo, static_cast<Byte_T>(byteInfo) ) != RESULT_OK );
+        itemHeader = header("Conditions Mask");
+        if ( hostTimer->convertToStrMask(stringfo, byteInfo) != RESULT_OK );
         if ( byteInfo == prevConditionsMask_ ) return RESULT_OK;
         else prevConditionsMask_ = byteInfo;
         break;
     case RELAY_SETPOINTS:
-        itemHeader = "Relay Setpoints             : ";
-        if ( hostTimer->convertToStrByte(stringfo, static_cast<Byte_T>(byteInfo) ) != RESULT_OK );
+        itemHeader = header("Relay Setpoints");
+        if ( hostTimer->convertToStrMask(stringfo, byteInfo) != RESULT_OK );
         if ( byteInfo == prevRelaySetpoints_ ) return RESULT_OK;
         else prevRelaySetpoints_ = byteInfo;
         break;
@@ -1058,8 +1398,8 @@ char Logger::logFileName_[] = "HostTimer.logs";
 
 int main()
 {
-    // Wait for 1 second for HostKeeper to report first process PID before any logs
-    usleep(1000000);
+    // Wait for HostKeeper to report first process PID before any logs
+    usleep(100000);
 
     Logger* logger = Logger::getInstance();
     logger->logging("main creating hostTimer instance...");
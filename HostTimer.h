@@ -8,7 +8,8 @@
  *  @date   September 2015
  *  @brief  Definition of Host Timer
  *
- *  Format definition of .prog file (result of parsing "program" element in Program.csv)
+ *  Format definition of .prog file v1 (result of parsing "program" element in Program.csv)
+ *      (Format v2 with versioned header and sub-minute resolution is defined in ProgramFormat.h.)
  *      Each minute represented by 1 byte (1 bit per output relay channel).
  *      Size of file is 7days (1week) x 24h x 60min x 1B = 10080 bytes.
  *      Address of 2nd hour is 60min = 60d = 0x3c.
@@ -23,11 +24,20 @@
  *      Total channels : 16.
  *      Channels 1 to 8 are output of type relay.
  *      Channels 8 to 16 are generals inputs or outputs. 
+ *      Builds with HOST_TIMER_NUM_OUTPUT_RELAYS > 8 (relay expansion boards, see RelayMask.h) take
+ *      NUM_OUTPUT_RELAYS relay channels first; set points and masks widen to Mask_T, and .prog v2
+ *      files carry the matching slot width. Relays beyond the on-board 8 are not driven by the
+ *      Raspberry Pi GPIOs.
  * 
  *  Guards : Conditions and Trigers:
  *      These only apply to channel output 1 to 8 of type relay.
  *      One channel is only activated if ALL conditions are satisfied.
  *      One channel is actiaved if ANY trigger is satisfied.
+ *      Against relay chatter (see ControlEngine.h), guard n (from 1, as numbered in the logs) can
+ *      have a hysteresis band GUARD_HYSTERESIS_MILLI_<n> in thousandths of its input unit and a
+ *      debounce of GUARD_DEBOUNCE_<n> ticks, and relay channel k minimum times RELAY_MIN_ON_SECONDS_<k>
+ *      and RELAY_MIN_OFF_SECONDS_<k> (HostTimer.consts, default 0). Relay transitions of every
+ *      day are logged, to compare them before and after tuning.
  *
  *  Program update/reload strategy:
  *      - HostKeeper UPDATE STEP 1: Check that the flag Program.update does not exist; if it does wait.
@@ -40,13 +50,73 @@
  *      - (DEPREDATED) UPDATE STEP 4: TSA raises a program update flag as an empty file named Program.update.
  *      - HostKeeper UPDATE STEP 4: Updater raises a program update flag as an empty fine named Program.update.
  *      - Every minute, after relay set points are set, the HostTimer checks if a Program.update file exists. If so continue next steps:
- *      - HostTimer closes current <ProgramName>.prog file.  
+ *      - HostTimer keeps current <ProgramName>.prog file mapped until the new one is mapped (see ProgramStorage).
  *      - (DEPRECATED) HostTimer moves old <ProgramName>.prog to <ProgramName>prog_old.
  *      - HostTimer renames all *_update files removing ending _update.
  *      - HostTimer reads the Program.set file.
  *      - HostTimer checks if new <ProgramName>.prog_update exists and moves to <ProgramName>.prog.
- *      - HostTimer opens new <ProgramName>.prog file.
+ *      - HostTimer maps new <ProgramName>.prog file and swaps it atomically with the current one.
+ *      - Only updated files are applied: changed channels are configured again, unchanged GPIOs and
+ *        NTC thermistors are left alone, so a program-only update does not stall the control loop.
  *      - HostTimer removes/deletes flag Program.update.:
+ *
+ *  Decision logic:
+ *      Set points and masks are computed by ControlEngine, which has no side effects; HostTimer
+ *      reads the files, samples the input/output channels, drives the relays and writes the status.
+ *
+ *  Control loop timing:
+ *      The main loop is paced by TickScheduler on absolute deadlines aligned to wall-clock seconds.
+ *      Week second and deadlines come from an IClock (SystemClock by default), so the loop and the
+ *      ControlEngine, whose duty cycles and manual program time out only use the week second they are
+ *      stepped with, can be run on a SimulatedClock.
+ *      Tick rate is read from HostTimer.consts as TICK_RATE_HZ (1 to 10 Hz, default 1 Hz).
+ *      Program set points are looked up in a ProgramTransitionIndex built when the .prog file is loaded.
+ *      Without guards or manual program, the loop sleeps until the next program transition or duty-cycle
+ *      boundary, for at most MAX_IDLE_MINUTES (HostTimer.consts, default 1) so that the Week Minute status
+ *      item (HostKeeper liveness check) and the Program.update flag keep being served.
+ *
+ *  GPIO backend:
+ *      Digital GPIO's are driven through sysfs (GpioRaspberryPi2B), with GPIO_CHARDEV:1 in
+ *      HostTimer.consts through the GPIO character device (GpioChardevRaspberryPi2B) or, with
+ *      GPIO_GPIOMEM:1, through the GPIO registers mapped from /dev/gpiomem (GpioMemRaspberryPi2B),
+ *      which has no edge detection. Digital channels are read with one getLevels() per pass.
+ *      Relays are written through RelayOutputs only when their set points change, and read back
+ *      every RELAY_VERIFY_SECONDS (default 60).
+ *
+ *  Startup:
+ *      GPIO's are exported all at once and polled until ready, channels are configured without
+ *      fixed sleeps, and the time from construction to the first relay commit is logged, so that
+ *      relays are correct within a fraction of a second after a power cut or watchdog restart.
+ *
+ *  Analog inputs:
+ *      ADS1115_CHIPS ADS1115 (HostTimer.consts, 1 to 4, default 1) at addresses 0x48 onwards are
+ *      driven through their registers on /dev/i2c-1, converting continuously with the full scale
+ *      ADS1115_FULL_SCALE_MV and data rate ADS1115_DATA_RATE_SPS (default 4096 mV and 128 SPS).
+ *      No GPIO is left for ALERT/RDY: conversion times are slept. Statistics of every I2C device
+ *      (transactions, bytes, errors, retries and latency) are logged every minute.
+ *      Builds with HOST_TIMER_NUM_AIN_CHANNELS > 4 (see ControlEngine.h) take more analog channels
+ *      after the digital ones. Analog channel k reads front end input AIN_INPUT_<k> (chip * 4 +
+ *      multiplexer input, default k). Every acquisition pass samples the analog inputs of the
+ *      channels at once, converting on all chips in parallel (see GpioAnalogFrontEnd.h).
+ *      Each sample of analog channel k averages AIN_OVERSAMPLING_<k> conversions (1 to 16, default
+ *      1) and goes through filter AIN_FILTER_<k> (0 none, 1 moving average, 2 median, 3 IIR; see
+ *      ChannelFilter.h) of AIN_FILTER_LENGTH_<k> samples before it reaches the control engine, so
+ *      noise does not make LOWER_THAN/HIGHER_THAN guards flap.
+ *      NTC thermistors convert the divider ratio to temperature with the model of their .consts file
+ *      (see AnalogSensorNtcThermistor.h). Vcc of the dividers is measured on front end input
+ *      NTC_VCC_INPUT if set (default 3.3 V fixed), and the temperature of analog channel k is
+ *      calibrated with gain AIN_CAL_GAIN_PPM_<k> (default 1000000) and offset AIN_CAL_OFFSET_MDEGC_<k>
+ *      (default 0), which NtcCalibration fits from reference temperatures. All NTC channels of
+ *      a model are converted in one readValues() call at the beginning of each acquisition pass.
+ *
+ *  Sensor acquisition:
+ *      Input/output channels are sampled by SensorAcquisition in its own thread at SENSOR_RATE_HZ
+ *      (HostTimer.consts, 1 to 10 Hz, default 1 Hz). The control loop takes the latest samples
+ *      without blocking, so a slow analog conversion does not delay the relays; samples older
+ *      than MAX_SAMPLE_AGE_SECONDS are reported. The thread is stopped while channels are configured.
+ *      Edges of digital inputs are detected by the GPIO backend: the tick wait polls the edge file
+ *      descriptor together with the timer, and an edge steps the engine and commits the relays at
+ *      once with the new levels. Edge count and maximum edge-to-relay latency are logged every minute.
  */
 /////////////////////////////////////////////////////////////////////////////
  
@@ -55,24 +125,35 @@
 #include <fstream>
 #include <unistd.h>
 #include <map>
+#include <set>
+#include <vector>
+#include <chrono>
 #include "CommonGlobalsWebTimer.h"
 #include "IComponent.h"
+#include "IGpioBulk.h"
 #include "GpioRaspberryPi2B.h"
+#include "GpioChardevRaspberryPi2B.h"
+#include "GpioMemRaspberryPi2B.h"
+#include "RelayOutputs.h"
+#include "I2cRaspberryPi2B.h"
 #include "GpioAnalogRaspberryPi2BAds1115.h"
+#include "GpioAnalogFrontEnd.h"
+#include "ChannelFilter.h"
 #include "AnalogSensorNtcThermistor.h"
+#include "IClock.h"
+#include "SystemClock.h"
+#include "TickScheduler.h"
+#include "ProgramStorage.h"
+#include "RelayMask.h"
+#include "ControlEngine.h"
+#include "SensorAcquisition.h"
 
 //#define GENERATE_EXAMPLE_OF_CHANNELS_FILE
 //#define GENERATE_EXAMPLE_OF_GUARDS_FILE
 
-#define LOGBIN(CHANNEL, MESSAGE, VARIABLE) LOGGING(CHANNEL, MESSAGE " = %d%d%d%d%d%d%d%db", VARIABLE, \
-                                                                        (0x80&VARIABLE) == 0 ? 0 : 1, \
-                                                                        (0x40&VARIABLE) == 0 ? 0 : 1, \
-                                                                        (0x20&VARIABLE) == 0 ? 0 : 1, \
-                                                                        (0x10&VARIABLE) == 0 ? 0 : 1, \
-                                                                        (0x08&VARIABLE) == 0 ? 0 : 1, \
-                                                                        (0x04&VARIABLE) == 0 ? 0 : 1, \
-                                                                        (0x02&VARIABLE) == 0 ? 0 : 1, \
-                                                                        (0x01&VARIABLE) == 0 ? 0 : 1)
+// MESSAGE formats VARIABLE with %llx
+#define LOGBIN(CHANNEL, MESSAGE, VARIABLE) LOGGING(CHANNEL, MESSAGE " = %sb", static_cast<unsigned long long>(VARIABLE), \
+                                                                        RelayMask::toString(VARIABLE).c_str())
 
 #define RETRY(ACTION_STATEMENT, CHANNEL, MESSAGE, ...)           \
     unsigned int i=0;                                            \
@@ -100,13 +181,15 @@
 //const char               GUARDS_FILE_NAME[20] = "Program.guards";      // Moved to CommonGlobalsWebTimer.h
 const char  PROGRAM_UPDATE_FLAG_FILE_NAME[20] = "Program.update";    
 const char               STATUS_FILE_NAME[20] = "HostTimer.status";    
+const char          CONSTANTS_FILE_NAME[20] = "HostTimer";           // Read by ConstantsServices as HostTimer.consts
 //const unsigned int               NUM_CHANNELS = 16u;                   // Moved to CommonGlobalsWebTimer.h
-const unsigned int          NUM_OUTPUT_RELAYS =  8u;
-const unsigned int           NUM_DIO_CHANNELS =  8u;
-const unsigned int           NUM_AIN_CHANNELS =  4u;
-const unsigned int             MAX_NUM_GUARDS = 16u;
+//const unsigned int          NUM_OUTPUT_RELAYS =  8u;                   // Moved to ControlEngine.h with channel and guard counts
+const unsigned int         NUM_ONBOARD_RELAYS =  8u;                            // Relays wired to Raspberry Pi GPIOs
+const unsigned int          NUM_DRIVEN_RELAYS = NUM_OUTPUT_RELAYS < NUM_ONBOARD_RELAYS ? NUM_OUTPUT_RELAYS : NUM_ONBOARD_RELAYS;
+const unsigned int     MAX_SAMPLE_AGE_SECONDS =  5u;                            // Older input/output samples are reported as stale
+static_assert( NUM_OUTPUT_RELAYS != 8u || NUM_AIN_CHANNELS != 4u || NUM_HOST_CHANNELS == NUM_CHANNELS,
+               "8 relays and 4 analog inputs build must match channels file of WebTimer" );
 //const unsigned int PROGRAM_FILE_SIZE_IN_BYTES = 10080u;                // Moved to CommonGlobalsWebTimer.h
-const unsigned int              MAX_CHAR_SIZE = 30u;
 //const unsigned int  STATUS_ITEM_SIZE_IN_BYTES = 30u;
 
 
@@ -114,7 +197,7 @@ const unsigned int              MAX_CHAR_SIZE = 30u;
 // CLASS DECLARATION
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-class HostTimer : public IComponent
+class HostTimer : public IComponent, public ControlTypes
 {
   public:
 
@@ -124,8 +207,9 @@ class HostTimer : public IComponent
   
     /*
      * Class constructor 
+     * @param clock time source of control loop, not owned; a SystemClock is used if nullptr
      */
-    HostTimer(const char* instanceName);
+    HostTimer(const char* instanceName, IClock* clock = nullptr);
 
     /*
      * Class destructor 
@@ -142,53 +226,8 @@ class HostTimer : public IComponent
     // Public Data Structures //
     //////////////////////////// 
 
-    enum ChannelType_T
-    {
-        INPUT_DIGITAL,
-        INPUT_ANALOG,
-        OUTPUT_RELAY,
-        OUTPUT_DIGITAL,
-        OUTPUT_ANALOG,
-        INPUT_NTC_THERMISTOR,
-        NOT_CONNECTED        
-    };
-    
-    enum GuardType_T
-    {
-        CONDITION,
-        TRIGGER,
-        END_OF_GUARDS
-    };
-    
-    struct Channel_T
-    {
-        uint8_t id;
-        char name[MAX_CHAR_SIZE];
-        ChannelType_T type;
-        char model[MAX_CHAR_SIZE];
-        uint8_t dutyCycle;
-    };
-    Channel_T channels_[NUM_CHANNELS];
-    
-    enum Threshold_T
-    {
-        MAXIMUM,
-        MINIMUM,
-        HIGHER_THAN,
-        LOWER_THAN,
-        EQUAL_TO,
-        UNEQUAL_TO
-    };
-
-    struct Guard_T
-    {
-        GuardType_T type;
-        uint8_t channelId;
-        uint8_t guardId;
-        Threshold_T guardThreshold;
-        float guardLevel;
-        // Pending to implement attribute "units" : char units[10];       
-    };
+    // ChannelType_T, GuardType_T, Threshold_T, Channel_T and Guard_T are defined in ControlTypes (ControlEngine.h)
+    Channel_T channels_[NUM_HOST_CHANNELS];
 
     friend class TimerStatus;
 
@@ -220,9 +259,11 @@ class HostTimer : public IComponent
          * Week Minute:                                9330 | Mon 00:00
          * Relay SetPoints [76543210]:                         00000000
          * Inputs/Outputs:    8:27.5|9:35.8|10:0.0|11:0.0|12:2.4|13:1.5
+         *
+         * Relay indices and masks have one digit per output relay, [76543210] for 8 relays
          */
 
-        static const unsigned int ITEM_SIZE_IN_BYTES = 64;
+        static const unsigned int ITEM_SIZE_IN_BYTES = ( NUM_OUTPUT_RELAYS <= 16 ) ? 64 : ( NUM_OUTPUT_RELAYS <= 32 ) ? 128 : 192;
 
         TimerStatus(const char* instanceName) : Logs(instanceName)
         {
@@ -246,7 +287,7 @@ class HostTimer : public IComponent
          */
         Result updateItem(Item_T item, std::string & stringfo, long longifo = 0);
 
-        Result updateItem(Item_T item, std::string & stringfo, Byte_T longifo, HostTimer * htPtr);
+        Result updateItem(Item_T item, std::string & stringfo, Mask_T longifo, HostTimer * htPtr);
 
         Result updateItem(Item_T item, const std::map<uint8_t, float> & ioChannelValues);
 
@@ -255,19 +296,31 @@ class HostTimer : public IComponent
 
         std::string prevProgramSet_  = "";
         std::string  prevWeekMinute_ = "";
-        Byte_T prevProgramSetpoints_ = 0x00;
-        Byte_T prevDutyCyclesMask_   = 0x00;
-        Byte_T prevTriggersMask_     = 0xFF;
-        Byte_T prevConditionsMask_   = 0x00;
-        Byte_T prevRelaySetpoints_   = 0x00;
+        Mask_T prevProgramSetpoints_ = 0u;
+        Mask_T prevDutyCyclesMask_   = 0u;
+        Mask_T prevTriggersMask_     = RelayMask::ALL;
+        Mask_T prevConditionsMask_   = 0u;
+        Mask_T prevRelaySetpoints_   = 0u;
         float  prevIOSum_            = 0.0;
     };
 
-    bool manualModeOn_ = false;
-    long manualStartMinute_ = -1l;
-    
     TimerStatus * timerStatus_;
 
+    IClock * clock_;
+    SystemClock * systemClock_ = nullptr;
+
+    /*
+     * Startup time, from construction to first relay commit, is logged once
+     */
+    std::chrono::steady_clock::time_point startupBegin_;
+    bool relaysCommitted_ = false;
+
+    TickScheduler * tickScheduler_;
+    unsigned int maxIdleMinutes_ = 1u;
+
+    ControlEngine * engine_;
+
+    SensorAcquisition * sensorAcquisition_;
     std::map<uint8_t, float> ioChannelValues_;
 
     std::string gpioName_;    
@@ -275,15 +328,74 @@ class HostTimer : public IComponent
     Guard_T guards_[MAX_NUM_GUARDS];
     
     std::string programFileName_;
-    FILE* programFilePtr_ = NULL;
+    std::set<std::string> updatedFiles_;
+    ProgramStorage * programStorage_;
 
-    GpioRaspberryPi2B * gpio_;
+    IGpioBulk * gpio_;
+    IGpioBulk::GpioMask_T relayGpioMask_ = 0u;
+    RelayOutputs * relayOutputs_;
+
+    /*
+     * Levels of digital channels read at once by every sensor acquisition pass
+     */
+    IGpioBulk::GpioMask_T digitalGpioMask_ = 0u;
+    IGpioBulk::GpioMask_T digitalLevels_ = 0u;
+    bool digitalLevelsRead_ = false;
+
+    /*
+     * Digital input levels read on edges, used until the acquisition thread samples them again
+     */
+    struct DigitalEdge_T
+    {
+        float value;
+        int64_t timestampNs;        // CLOCK_MONOTONIC time of edge
+    };
+    IGpioBulk::GpioMask_T digitalInputGpioMask_ = 0u;
+    std::map<uint8_t, DigitalEdge_T> digitalEdges_;
+    int edgeFd_ = -1;               // -1 if edges are not detected and digital inputs are only sampled
+    uint64_t edgeCount_ = 0u;
+    int64_t maxEdgeLatencyNs_ = 0;
+
+    /*
+     * Week day and relay switch count at its beginning, for the daily relay transitions
+     */
+    long prevWeekDay_ = -1l;
+    uint64_t daySwitchCount_ = 0u;
 
     std::map<uint8_t, uint8_t> analogIdNumber_;
-    GpioAnalogRaspberryPi2BAds1115 * gpioAnalog_;
+    I2cRaspberryPi2B * i2cBus_;
+    GpioAnalogFrontEnd * gpioAnalog_;
+
+    /*
+     * Front end inputs of analog channels, sampled at once by every sensor acquisition pass
+     */
+    GpioAnalogFrontEnd::InputMask_T analogInputMask_ = 0u;
+
+    /*
+     * Filters of channel samples, indexed by channel id, used by the acquisition thread only
+     */
+    ChannelFilter filters_[NUM_HOST_CHANNELS];
     AnalogSensorNtcThermistor * ntcThermistor_;
     std::map< std::string, AnalogSensorNtcThermistor *> ntcThermistors_;
 
+    /*
+     * Front end input wired to Vcc of the NTC dividers, NO_VCC_INPUT if not measured
+     */
+    unsigned char ntcVccInput_ = AnalogSensorNtcThermistor::NO_VCC_INPUT;
+
+    /*
+     * NTC channels of every model, converted at once by every sensor acquisition pass into
+     * ntcValues_, indexed by channel id (NAN if not read)
+     */
+    struct NtcBatch_T
+    {
+        AnalogSensorNtcThermistor * ntcThermistor;
+        std::vector<uint8_t> inputs;
+        std::vector<uint8_t> channelIds;
+    };
+    std::vector<NtcBatch_T> ntcBatches_;
+    float ntcValues_[NUM_HOST_CHANNELS];
+
     /**
      * Read program set file and sets value of programFileName_
      * @return Result RESULT_OK in case of correct execution
@@ -304,6 +416,46 @@ class HostTimer : public IComponent
      */
     Result updateProgramFile();
 
+    /**
+     * Apply updated files to the running timer: only a changed program is mapped again,
+     * only changed channels are configured again and the engine is reconfigured if anything changed
+     * @return Result RESULT_OK in case of correct execution; on error of program file the current one is kept
+     */
+    Result reconfigure();
+
+    /**
+     * Read and check channels file
+     * @param channels array of NUM_HOST_CHANNELS channels read
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result readChannelsFile(Channel_T* channels);
+
+    /**
+     * Configure GPIO mode or analog sensor of channels_[i]
+     * @param i channel number
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result configureChannel(unsigned int i);
+
+    /**
+     * Read guards file
+     * @param guards array of MAX_NUM_GUARDS guards read, ended by END_OF_GUARDS if fewer
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result readGuardsFile(Guard_T* guards);
+
+    /**
+     * Map program file programFileName_ into programStorage_
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result loadProgramFile();
+
+    /**
+     * Configure engine_ with channels, guards and the mapped program file
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result configureEngine();
+
     #ifdef GENERATE_EXAMPLE_OF_CHANNELS_FILE
     /**
      * Generate examples of channels and guards files for DEVELOPMENT purposes
@@ -316,39 +468,40 @@ class HostTimer : public IComponent
     #endif
 
     /**
-     * Read input/output channels
+     * Start sampling of input/output channels of channels_ in sensorAcquisition_
      * @return Result RESULT_OK in case of correct execution
      */
-    Result readInputOutputChannels();
- 
+    Result startSensorAcquisition();
+
     /**
-     * Composes duty cycles mask based on tm_sec and channels duty cycles
-     * @param Byte_T& resulted duty cycles mask
+     * Read value of one input/output channel; called from the sensor acquisition thread
+     * @param channel to read
+     * @param value read
      * @return Result RESULT_OK in case of correct execution
      */
-    Result composeDutyCyclesMask(Byte_T & mask);
+    Result readChannel(const Channel_T & channel, float & value);
 
     /**
-     * Composes conditions mask based on guards_ data and status of input/outputs
-     * @param Byte_T& resulted conditions mask
+     * Reads pending digital input edges and, if any, steps the control engine and commits the relays
+     * at once, outside the tick cadence; edge-to-relay latency is measured
      * @return Result RESULT_OK in case of correct execution
      */
-    Result composeConditionsMask(Byte_T & mask);
-
+    Result processDigitalEdges();
+ 
     /**
-     * Composes triggers mask based on guards_ data and status of input/outputs
-     * @param Byte_T& resulted triggers mask
-     * @return Result RESULT_OK in case of correct execution
+     * Converts relay mask to binary string, one character per output relay
+     * @param strMask converted mask
+     * @param mask to convert
+     * @result RESULT_OK if no errors
      */
-    Result composeTriggersMask(Byte_T & mask);
+    Result convertToStrMask(std::string & strMask, Mask_T mask);
 
     /**
-     * Converts
-     * @param item of status to update
-     * @param info of item to be updated
-     * @result RESULT_OK if no errors
+     * GPIO id of channel: relays beyond NUM_ONBOARD_RELAYS shift digital inputs/outputs
+     * @param channelId of relay or digital input/output channel
+     * @return uint8_t GPIO id
      */
-    Result convertToStrByte(std::string & strByte, Byte_T byte);
+    uint8_t gpioIdOf(uint8_t channelId) const;
 };
 
 #endif // _HOST_TIMER_H
@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   I2cRaspberryPi2B.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements I2cRaspberryPi2B class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "I2cRaspberryPi2B.h"
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+I2cRaspberryPi2B::I2cRaspberryPi2B(const char* instanceName, const char* deviceName, unsigned int maxRetries)
+:   IComponent(instanceName),
+    deviceName_(deviceName),
+    maxRetries_(maxRetries)
+{
+    logChannels_ = Logger::ERRORS;
+}
+
+Result I2cRaspberryPi2B::initialize()
+{
+    shutdown();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    fd_ = open(deviceName_.c_str(), O_RDWR | O_CLOEXEC);
+    if ( fd_ < 0 )
+    {
+        LOGGING(ERRORS, "ERROR opening I2C device %s with errno %d", deviceName_.c_str(), errno);
+        return RESULT_ERROR;
+    }
+
+    unsigned long functions = 0;
+    if ( ioctl(fd_, I2C_FUNCS, &functions) < 0 || ( functions & I2C_FUNC_I2C ) == 0 )
+    {
+        LOGGING(ERRORS, "ERROR I2C device %s does not support I2C_RDWR messages, errno %d", deviceName_.c_str(), errno);
+        close(fd_);
+        fd_ = -1;
+        return RESULT_ERROR;
+    }
+    LOGGING(INFO, "opened I2C device %s", deviceName_.c_str());
+
+    return RESULT_OK;
+}
+
+void I2cRaspberryPi2B::shutdown()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ( fd_ >= 0 )
+    {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+Result I2cRaspberryPi2B::write(uint8_t address, const uint8_t* data, size_t size)
+{
+    struct i2c_msg message;
+    message.addr  = address;
+    message.flags = 0;
+    message.len   = static_cast<__u16>(size);
+    message.buf   = const_cast<__u8 *>(data);
+
+    return runTransaction(&message, 1u);
+}
+
+Result I2cRaspberryPi2B::writeRead(uint8_t address, const uint8_t* writeData, size_t writeSize, uint8_t* readData, size_t readSize)
+{
+    struct i2c_msg messages[2];
+    messages[0].addr  = address;
+    messages[0].flags = 0;
+    messages[0].len   = static_cast<__u16>(writeSize);
+    messages[0].buf   = const_cast<__u8 *>(writeData);
+    messages[1].addr  = address;
+    messages[1].flags = I2C_M_RD;
+    messages[1].len   = static_cast<__u16>(readSize);
+    messages[1].buf   = readData;
+
+    return runTransaction(messages, 2u);
+}
+
+Result I2cRaspberryPi2B::transfer(Message_T* messages, unsigned int numMessages)
+{
+    if ( numMessages == 0u || numMessages > MAX_BATCH_MESSAGES )
+    {
+        LOGGING(ERRORS, "ERROR I2C batch of %d messages, must be 1 to %d", numMessages, MAX_BATCH_MESSAGES);
+        return RESULT_ERROR;
+    }
+
+    struct i2c_msg batch[MAX_BATCH_MESSAGES];
+    for ( unsigned int i=0; i < numMessages; i++ )
+    {
+        batch[i].addr  = messages[i].address;
+        batch[i].flags = messages[i].read ? I2C_M_RD : 0;
+        batch[i].len   = static_cast<__u16>(messages[i].size);
+        batch[i].buf   = messages[i].data;
+    }
+
+    return runTransaction(batch, numMessages);
+}
+
+void I2cRaspberryPi2B::getStats(uint8_t address, DeviceStats_T & stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<uint8_t, DeviceStats_T>::const_iterator it = stats_.find(address);
+    if ( it != stats_.end() ) stats = it->second;
+    else memset(&stats, 0, sizeof(stats));
+}
+
+void I2cRaspberryPi2B::logStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for ( const std::pair<const uint8_t, DeviceStats_T> & device : stats_ )
+    {
+        const DeviceStats_T & stats = device.second;
+
+        // Percentiles as upper bound of their latency bucket
+        unsigned int percentileUs[2] = { 0u, 0u };
+        const uint64_t ranks[2] = { ( stats.transactions + 1u ) / 2u, stats.transactions - stats.transactions / 100u };
+        for ( unsigned int p=0; p < 2u; p++ )
+        {
+            uint64_t count = 0u;
+            for ( unsigned int i=0; i < NUM_LATENCY_BUCKETS; i++ )
+            {
+                count += stats.latencies[i];
+                if ( count < ranks[p] ) continue;
+                percentileUs[p] = LATENCY_BUCKET_US << i;
+                break;
+            }
+        }
+        LOGGING(INFO, "device 0x%02x: %llu transactions, %llu bytes written, %llu bytes read, %llu errors, %llu retries, "
+                      "latency p50 < %u us, p99 < %u us, max %lld us",
+                      device.first, static_cast<unsigned long long>(stats.transactions),
+                      static_cast<unsigned long long>(stats.bytesWritten), static_cast<unsigned long long>(stats.bytesRead),
+                      static_cast<unsigned long long>(stats.errors), static_cast<unsigned long long>(stats.retries),
+                      percentileUs[0], percentileUs[1], static_cast<long long>(stats.maxLatencyUs));
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PROTECTED METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+int I2cRaspberryPi2B::rdwr(struct i2c_msg* messages, unsigned int numMessages)
+{
+    if ( fd_ < 0 ) return -EBADF;
+
+    struct i2c_rdwr_ioctl_data transaction;
+    transaction.msgs  = messages;
+    transaction.nmsgs = numMessages;
+    int result = ioctl(fd_, I2C_RDWR, &transaction);
+
+    return ( result < 0 ) ? -errno : result;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result I2cRaspberryPi2B::runTransaction(struct i2c_msg* messages, unsigned int numMessages)
+{
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    unsigned int backoffUs = I2C_RETRY_BACKOFF_US;
+    unsigned int retries = 0u;
+    int result = 0;
+
+    while ( true )
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            result = rdwr(messages, numMessages);
+            if ( result == static_cast<int>(numMessages) || retries >= maxRetries_ ||
+                 ( result != -ENXIO && result != -EREMOTEIO && result != -EAGAIN && result != -ETIMEDOUT ) )
+            {
+                int64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+                account(messages, numMessages, latencyUs, retries, result != static_cast<int>(numMessages));
+                break;
+            }
+        }
+        // Other threads get the bus while the device is busy
+        std::this_thread::sleep_for(std::chrono::microseconds(backoffUs));
+        backoffUs *= 2u;
+        retries++;
+    }
+
+    if ( result != static_cast<int>(numMessages) )
+    {
+        LOGGING(ERRORS, "ERROR I2C transaction of %d messages with device 0x%02x after %d retries, errno %d",
+                        numMessages, messages[0].addr, retries, ( result < 0 ) ? -result : 0);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+void I2cRaspberryPi2B::account(const struct i2c_msg* messages, unsigned int numMessages, int64_t latencyUs, unsigned int retries, bool failed)
+{
+    unsigned int bucket = 0u;
+    while ( bucket + 1u < NUM_LATENCY_BUCKETS && latencyUs >= static_cast<int64_t>(LATENCY_BUCKET_US << bucket) ) bucket++;
+
+    for ( unsigned int i=0; i < numMessages; i++ )
+    {
+        std::map<uint8_t, DeviceStats_T>::iterator it = stats_.find(static_cast<uint8_t>(messages[i].addr));
+        if ( it == stats_.end() )
+        {
+            DeviceStats_T stats;
+            memset(&stats, 0, sizeof(stats));
+            it = stats_.insert(std::make_pair(static_cast<uint8_t>(messages[i].addr), stats)).first;
+        }
+        DeviceStats_T & stats = it->second;
+        if ( messages[i].flags & I2C_M_RD ) stats.bytesRead += messages[i].len;
+        else stats.bytesWritten += messages[i].len;
+
+        // Once per device of the transaction
+        bool first = true;
+        for ( unsigned int j=0; j < i && first; j++ ) first = ( messages[j].addr != messages[i].addr );
+        if ( !first ) continue;
+        stats.transactions++;
+        stats.retries += retries;
+        if ( failed ) stats.errors++;
+        stats.latencies[bucket]++;
+        if ( latencyUs > stats.maxLatencyUs ) stats.maxLatencyUs = latencyUs;
+    }
+}
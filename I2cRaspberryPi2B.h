@@ -0,0 +1,160 @@
+#ifndef _I2C_RASPBERRYPI2B_H
+#define _I2C_RASPBERRYPI2B_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   I2cRaspberryPi2B.h
+ *  @author Manel González Farrera
+ *  @date   December 2016
+ *  @brief  Definition of I2cRaspberryPi2B
+ *
+ *  I2C bus of the Raspberry Pi through the i2c-dev interface (/dev/i2c-N),
+ *  shared by all I2C peripheral drivers (ADC's, expanders).
+ *
+ *  Every call is one I2C_RDWR ioctl, so a register pointer write and the
+ *  register read that follows it make one combined transaction with a
+ *  repeated start, and no I2C_SLAVE address selection is needed. transfer()
+ *  batches up to MAX_BATCH_MESSAGES messages, to any devices, in one ioctl.
+ *
+ *  Transactions of several threads are serialized by a mutex. A transaction
+ *  failing because a device did not acknowledge (ENXIO, EREMOTEIO), the bus
+ *  was busy (EAGAIN) or timed out (ETIMEDOUT) is retried up to maxRetries
+ *  times, waiting I2C_RETRY_BACKOFF_US doubled at every retry with the bus
+ *  released. Statistics of every device address (transactions, bytes,
+ *  errors, retries and a latency histogram) are kept and logged by
+ *  logStats(); a batch counts as one transaction of every device in it.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <mutex>
+#include "LenamDevs_types.h"
+#include "IComponent.h"
+#include "II2cBus.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// GLOBAL CONSTANTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char I2C_DEVICE_NAME[20] = "/dev/i2c-1";      // I2C1 on pins 3 (SDA) and 5 (SCL)
+const unsigned int I2C_MAX_RETRIES = 3u;
+const unsigned int I2C_RETRY_BACKOFF_US = 100u;     // First retry; doubled at every retry
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct i2c_msg;
+
+class I2cRaspberryPi2B : public IComponent, public II2cBus
+{
+  public:
+
+    static const unsigned int MAX_BATCH_MESSAGES = 42u;     // I2C_RDWR_IOCTL_MAX_MSGS of i2c-dev
+
+    /*
+     * Latency bucket i counts transactions taking less than LATENCY_BUCKET_US << i,
+     * the last one all slower transactions
+     */
+    static const unsigned int NUM_LATENCY_BUCKETS = 12u;
+    static const unsigned int LATENCY_BUCKET_US = 16u;
+
+    /*
+     * Statistics of a device address
+     */
+    struct DeviceStats_T
+    {
+        uint64_t transactions;
+        uint64_t bytesWritten;
+        uint64_t bytesRead;
+        uint64_t errors;            // Transactions failed after all retries
+        uint64_t retries;
+        uint64_t latencies[NUM_LATENCY_BUCKETS];
+        int64_t maxLatencyUs;       // Including retries
+    };
+
+    /*
+     * Class constructor
+     * @param deviceName i2c-dev device of the bus
+     * @param maxRetries of a transaction not acknowledged
+     */
+    I2cRaspberryPi2B(const char* instanceName, const char* deviceName = I2C_DEVICE_NAME, unsigned int maxRetries = I2C_MAX_RETRIES);
+
+    /*
+     * Class destructor
+     */
+    virtual ~I2cRaspberryPi2B() { shutdown(); }
+
+    /*
+     * Opens device and checks it supports plain I2C messages
+     */
+    Result initialize();
+
+    Result start() { return RESULT_OK; }
+
+    /*
+     * Closes device
+     */
+    void shutdown();
+
+    Result write(uint8_t address, const uint8_t* data, size_t size);
+
+    Result writeRead(uint8_t address, const uint8_t* writeData, size_t writeSize, uint8_t* readData, size_t readSize);
+
+    Result transfer(Message_T* messages, unsigned int numMessages);
+
+    /**
+     * Gets statistics of device
+     * @param address 7-bit address of device
+     * @param stats of device, all zero if it had no transaction
+     */
+    void getStats(uint8_t address, DeviceStats_T & stats) const;
+
+    /*
+     * Logs statistics of every device and latency percentiles
+     */
+    void logStats() const;
+
+  protected:
+
+    /**
+     * Runs messages as one I2C_RDWR ioctl
+     * @return int number of messages run, or -errno
+     */
+    virtual int rdwr(struct i2c_msg* messages, unsigned int numMessages);
+
+  private:
+
+    std::string deviceName_;
+    unsigned int maxRetries_;
+
+    /*
+     * File descriptor of device, -1 if closed
+     */
+    int fd_ = -1;
+
+    /*
+     * Serializes transactions and guards stats_
+     */
+    mutable std::mutex mutex_;
+    std::map<uint8_t, DeviceStats_T> stats_;
+
+    /**
+     * Runs messages as one transaction, retrying it if not acknowledged, and accounts it
+     * @param messages to run
+     * @param numMessages number of messages
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result runTransaction(struct i2c_msg* messages, unsigned int numMessages);
+
+    /*
+     * Accounts transaction to every device in it; mutex_ must be held
+     */
+    void account(const struct i2c_msg* messages, unsigned int numMessages, int64_t latencyUs, unsigned int retries, bool failed);
+};
+
+#endif // _I2C_RASPBERRYPI2B_H
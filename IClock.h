@@ -0,0 +1,67 @@
+#ifndef _ICLOCK_H
+#define _ICLOCK_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   IClock.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of IClock interface
+ *
+ *  Source of wall-clock time for the control loop. HostTimer and
+ *  TickScheduler take their time and sleep through an IClock, so that the
+ *  same loop runs on real time (SystemClock) or on simulated time
+ *  (SimulatedClock), where a week of ticks takes as long as the CPU needs.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <time.h>
+#include "LenamDevs_types.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class IClock
+{
+  public:
+
+    virtual ~IClock() {}
+
+    /**
+     * Current wall-clock time
+     * @param time current time, as CLOCK_REALTIME
+     */
+    virtual void now(struct timespec & time) = 0;
+
+    /**
+     * Second of the week of time, Monday 00:00:00 local time being 0
+     * @param time wall-clock second
+     * @return long from 0 to SECONDS_PER_WEEK - 1
+     */
+    virtual long weekSecond(time_t time) = 0;
+
+    /**
+     * Blocks until absolute wall-clock time deadline
+     * @param deadline absolute time to wait for
+     * @return Result RESULT_OK if deadline is reached, RESULT_CANCELLED if wall clock was stepped
+     */
+    virtual Result sleepUntil(const struct timespec & deadline) = 0;
+
+    /**
+     * Blocks until absolute wall-clock time deadline or until eventFd is readable
+     * Clocks that cannot wait on file descriptors ignore eventFd
+     * @param deadline absolute time to wait for
+     * @param eventFd file descriptor to wake up on, -1 for none; it is not read
+     * @param event true if woken up by eventFd
+     * @return Result RESULT_OK if deadline is reached or eventFd is readable, RESULT_CANCELLED if wall clock was stepped
+     */
+    virtual Result sleepUntil(const struct timespec & deadline, int /*eventFd*/, bool & event)
+    {
+        event = false;
+        return sleepUntil(deadline);
+    }
+};
+
+#endif // _ICLOCK_H
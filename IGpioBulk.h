@@ -0,0 +1,82 @@
+#ifndef _IGPIO_BULK_H
+#define _IGPIO_BULK_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   IGpioBulk.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of IGpioBulk interface
+ *
+ *  IGpio with multi-line operations: the levels of several GPIO's are set
+ *  or got at once, selected by a mask of GPIO Ids (bit i is GPIO Id i).
+ *  Backends with multi-line hardware access (GPIO character device) make
+ *  one system call per operation; others fall back to a loop.
+ *
+ *  Backends with edge detection signal level changes of input GPIO's on a
+ *  pollable file descriptor, so that inputs need not be sampled to notice
+ *  them. The defaults are for backends without edge detection.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include "LenamDevs_types.h"
+#include "IGpio.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class IGpioBulk : public IGpio
+{
+  public:
+
+    typedef uint32_t GpioMask_T;
+
+    virtual ~IGpioBulk() {}
+
+    /**
+     * Sets levels of GPIO's in mask and verifies them
+     * @param mask of GPIO Ids to set
+     * @param levels bit i is level of GPIO Id i; bits out of mask are ignored
+     * @return Result RESULT_OK in case of correct execution
+     */
+    virtual Result setLevels(GpioMask_T mask, GpioMask_T levels) = 0;
+
+    /**
+     * Gets levels of GPIO's in mask
+     * @param mask of GPIO Ids to get
+     * @param levels bit i is level of GPIO Id i; bits out of mask are 0
+     * @return Result RESULT_OK in case of correct execution
+     */
+    virtual Result getLevels(GpioMask_T mask, GpioMask_T & levels) const = 0;
+
+    /**
+     * Detects rising and falling edges of the input GPIO's in mask only
+     * @param mask of input GPIO Ids; 0 disables edge detection
+     * @return Result RESULT_OK in case of correct execution, RESULT_UNIMPLEMENTED without edge detection
+     */
+    virtual Result setEdges(GpioMask_T mask) { return ( mask == 0u ) ? RESULT_OK : RESULT_UNIMPLEMENTED; }
+
+    /**
+     * File descriptor readable (poll POLLIN) while edges are pending
+     * @return int file descriptor, -1 without edge detection
+     */
+    virtual int getEdgeFd() const { return -1; }
+
+    /**
+     * Consumes pending edges, without blocking
+     * @param edges bit i set if GPIO Id i had at least one edge
+     * @param timestampNs CLOCK_MONOTONIC time in nanoseconds of the first edge, 0 if none
+     * @return Result RESULT_OK in case of correct execution
+     */
+    virtual Result readEdges(GpioMask_T & edges, int64_t & timestampNs)
+    {
+        edges = 0u;
+        timestampNs = 0;
+        return RESULT_OK;
+    }
+};
+
+#endif // _IGPIO_BULK_H
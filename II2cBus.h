@@ -0,0 +1,95 @@
+#ifndef _II2C_BUS_H
+#define _II2C_BUS_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   II2cBus.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of II2cBus interface
+ *
+ *  Transport of I2C peripheral drivers: messages to and from a device
+ *  selected by its 7-bit address. Drivers only see this interface, so the
+ *  same driver runs on /dev/i2c-N (I2cRaspberryPi2B) or on a user-space
+ *  register-level stand-in of the device (e.g. SimulatedAds1115).
+ *  A device not acknowledging its address or data fails with RESULT_ERROR.
+ *
+ *  transfer() batches messages to one or more devices into one transaction
+ *  (e.g. switching the multiplexers of several ADC's at once). Buses
+ *  without batching run the messages one by one.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LenamDevs_types.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class II2cBus
+{
+  public:
+
+    /*
+     * Message of a transaction, written to or read from one device
+     */
+    struct Message_T
+    {
+        uint8_t address;        // 7-bit address of device
+        bool read;
+        uint8_t* data;
+        size_t size;            // of data in bytes
+    };
+
+    virtual ~II2cBus() {}
+
+    /**
+     * Writes bytes to device in one message
+     * @param address 7-bit address of device
+     * @param data to write
+     * @param size of data in bytes
+     * @return Result RESULT_OK in case of correct execution
+     */
+    virtual Result write(uint8_t address, const uint8_t* data, size_t size) = 0;
+
+    /**
+     * Writes bytes to device, then reads bytes from it after a repeated start
+     * (e.g. register pointer, then register value)
+     * @param address 7-bit address of device
+     * @param writeData to write
+     * @param writeSize of writeData in bytes
+     * @param readData read
+     * @param readSize of readData in bytes
+     * @return Result RESULT_OK in case of correct execution
+     */
+    virtual Result writeRead(uint8_t address, const uint8_t* writeData, size_t writeSize, uint8_t* readData, size_t readSize) = 0;
+
+    /**
+     * Runs messages as one transaction, with repeated starts between them
+     * @param messages to run; a read follows a write to the same device
+     * @param numMessages number of messages
+     * @return Result RESULT_OK in case of correct execution
+     */
+    virtual Result transfer(Message_T* messages, unsigned int numMessages)
+    {
+        for ( unsigned int i=0; i < numMessages; i++ )
+        {
+            Result result = RESULT_ERROR;
+            if ( messages[i].read ) return RESULT_ERROR;
+            if ( i + 1u < numMessages && messages[i + 1u].read && messages[i + 1u].address == messages[i].address )
+            {
+                result = writeRead(messages[i].address, messages[i].data, messages[i].size, messages[i + 1u].data, messages[i + 1u].size);
+                i++;
+            }
+            else result = write(messages[i].address, messages[i].data, messages[i].size);
+            if ( result != RESULT_OK ) return result;
+        }
+
+        return RESULT_OK;
+    }
+};
+
+#endif // _II2C_BUS_H
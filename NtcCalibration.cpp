@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   NtcCalibration.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements NtcCalibration class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NtcCalibration.h"
+#include <math.h>
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result NtcCalibration::fitSteinhartHart(const std::vector<Point_T> & points, double coefficients[3], double & maxError)
+{
+    if ( points.size() < 3u )
+    {
+        LOGGING(ERRORS, "ERROR %d points to fit Steinhart-Hart coefficients, 3 at least", static_cast<int>(points.size()));
+        return RESULT_ERROR;
+    }
+
+    // Normal equations of rows [ 1, Ln(R), Ln(R)^3 ] and 1/T
+    double matrix[3][3] = { { 0.0 } };
+    double vector[3] = { 0.0, 0.0, 0.0 };
+    for ( const Point_T & point : points )
+    {
+        if ( point.first <= 0.0 || point.second <= -273.15 )
+        {
+            LOGGING(ERRORS, "ERROR point of %f Ohm at %f degC", point.first, point.second);
+            return RESULT_ERROR;
+        }
+        double logResistance = log(point.first);
+        double row[3] = { 1.0, logResistance, logResistance * logResistance * logResistance };
+        for ( unsigned int i=0; i < 3u; i++ )
+        {
+            for ( unsigned int j=0; j < 3u; j++ ) matrix[i][j] += row[i] * row[j];
+            vector[i] += row[i] / ( point.second + 273.15 );
+        }
+    }
+    if ( solve(matrix, vector) != RESULT_OK )
+    {
+        LOGMSG(ERRORS, "ERROR points do not determine Steinhart-Hart coefficients: 3 different resistances at least");
+        return RESULT_ERROR;
+    }
+
+    maxError = 0.0;
+    for ( const Point_T & point : points )
+    {
+        double logResistance = log(point.first);
+        double temperature = 1.0 / ( vector[0] + vector[1] * logResistance + vector[2] * logResistance * logResistance * logResistance ) - 273.15;
+        maxError = fmax(maxError, fabs(temperature - point.second));
+    }
+    for ( unsigned int i=0; i < 3u; i++ ) coefficients[i] = vector[i];
+
+    return RESULT_OK;
+}
+
+Result NtcCalibration::fitOffsetGain(const std::vector<Point_T> & points, double & gain, double & offset, double & maxError)
+{
+    if ( points.empty() )
+    {
+        LOGMSG(ERRORS, "ERROR no point to fit gain and offset");
+        return RESULT_ERROR;
+    }
+
+    double meanMeasured = 0.0, meanReference = 0.0;
+    for ( const Point_T & point : points )
+    {
+        meanMeasured += point.first;
+        meanReference += point.second;
+    }
+    meanMeasured /= points.size();
+    meanReference /= points.size();
+
+    // Least squares line through the means; offset only if measures do not spread
+    double covariance = 0.0, variance = 0.0;
+    for ( const Point_T & point : points )
+    {
+        covariance += ( point.first - meanMeasured ) * ( point.second - meanReference );
+        variance += ( point.first - meanMeasured ) * ( point.first - meanMeasured );
+    }
+    gain = ( variance > 1e-9 ) ? covariance / variance : 1.0;
+    offset = meanReference - gain * meanMeasured;
+
+    maxError = 0.0;
+    for ( const Point_T & point : points ) maxError = fmax(maxError, fabs(gain * point.first + offset - point.second));
+
+    return RESULT_OK;
+}
+
+Result NtcCalibration::readPoints(const char* fileName, std::vector<Point_T> & points)
+{
+    std::ifstream file(fileName);
+    if ( !file.is_open() )
+    {
+        LOGGING(ERRORS, "ERROR opening points file %s", fileName);
+        return RESULT_ERROR;
+    }
+
+    std::string line;
+    unsigned int lineNumber = 0u;
+    while ( std::getline(file, line) )
+    {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if ( first == std::string::npos || line[first] == '#' ) continue;
+        std::istringstream stream(line);
+        Point_T point;
+        if ( !( stream >> point.first >> point.second ) )
+        {
+            LOGGING(ERRORS, "ERROR line %d of points file %s is not two numbers", lineNumber, fileName);
+            return RESULT_ERROR;
+        }
+        points.push_back(point);
+    }
+
+    return RESULT_OK;
+}
+
+Result NtcCalibration::fitSteinhartHartConstants(const char* fileName, int32_t constants[3], unsigned int & numPoints, double & maxError)
+{
+    std::vector<Point_T> points;
+    double coefficients[3];
+    if ( readPoints(fileName, points) != RESULT_OK || fitSteinhartHart(points, coefficients, maxError) != RESULT_OK ) return RESULT_ERROR;
+
+    for ( unsigned int i=0; i < 3u; i++ )
+    {
+        if ( toConstant(coefficients[i], 1e12, constants[i]) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR Steinhart-Hart coefficient %d of %g out of range of constants", i, coefficients[i]);
+            return RESULT_ERROR;
+        }
+    }
+    numPoints = static_cast<unsigned int>(points.size());
+
+    return RESULT_OK;
+}
+
+Result NtcCalibration::fitOffsetGainConstants(const char* fileName, int32_t & gainPpm, int32_t & offsetMdegC, unsigned int & numPoints, double & maxError)
+{
+    std::vector<Point_T> points;
+    double gain = 1.0, offset = 0.0;
+    if ( readPoints(fileName, points) != RESULT_OK || fitOffsetGain(points, gain, offset, maxError) != RESULT_OK ) return RESULT_ERROR;
+
+    if ( toConstant(gain, 1e6, gainPpm) != RESULT_OK || toConstant(offset, 1e3, offsetMdegC) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR gain %g or offset %g out of range of constants", gain, offset);
+        return RESULT_ERROR;
+    }
+    numPoints = static_cast<unsigned int>(points.size());
+
+    return RESULT_OK;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result NtcCalibration::solve(double matrix[3][3], double vector[3])
+{
+    for ( unsigned int column = 0; column < 3u; column++ )
+    {
+        unsigned int pivot = column;
+        for ( unsigned int row = column + 1u; row < 3u; row++ )
+        {
+            if ( fabs(matrix[row][column]) > fabs(matrix[pivot][column]) ) pivot = row;
+        }
+        if ( fabs(matrix[pivot][column]) < 1e-12 * fabs(matrix[0][0]) ) return RESULT_ERROR;
+        for ( unsigned int j=0; j < 3u; j++ ) std::swap(matrix[column][j], matrix[pivot][j]);
+        std::swap(vector[column], vector[pivot]);
+
+        for ( unsigned int row = column + 1u; row < 3u; row++ )
+        {
+            double factor = matrix[row][column] / matrix[column][column];
+            for ( unsigned int j = column; j < 3u; j++ ) matrix[row][j] -= factor * matrix[column][j];
+            vector[row] -= factor * vector[column];
+        }
+    }
+    for ( int row = 2; row >= 0; row-- )
+    {
+        for ( unsigned int j = row + 1; j < 3u; j++ ) vector[row] -= matrix[row][j] * vector[j];
+        vector[row] /= matrix[row][row];
+    }
+
+    return RESULT_OK;
+}
+
+Result NtcCalibration::toConstant(double value, double scale, int32_t & constant)
+{
+    double scaled = value * scale;
+    if ( !( fabs(scaled) < 2147483647.0 ) ) return RESULT_ERROR;
+    constant = static_cast<int32_t>( llround(scaled) );
+
+    return RESULT_OK;
+}
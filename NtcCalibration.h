@@ -0,0 +1,124 @@
+#ifndef _NTC_CALIBRATION_H
+#define _NTC_CALIBRATION_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   NtcCalibration.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of NtcCalibration
+ *
+ *  Fits the constants of AnalogSensorNtcThermistor from reference points,
+ *  in the formats of the .consts files that read them:
+ *      - Steinhart-Hart coefficients of a thermistor model from points of
+ *        resistance (Ohm) and temperature (degC), by least squares of
+ *        1/T = A + B * Ln(R) + C * Ln(R)^3 (3 points or more), as
+ *        SH_A_E12, SH_B_E12 and SH_C_E12 of NtcThermistor<model>.consts.
+ *      - Gain and offset of one sensor from points of temperature read by
+ *        HostTimer and reference temperature, by least squares of a line
+ *        (1 point fits the offset only), as AIN_CAL_GAIN_PPM_<k> and
+ *        AIN_CAL_OFFSET_MDEGC_<k> of HostTimer.consts.
+ *  Points files hold one point per line, two numbers separated by spaces;
+ *  empty lines and lines starting with # are skipped.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <vector>
+#include <utility>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class NtcCalibration : public Logs
+{
+  public:
+
+    /*
+     * Pair of numbers of a points file line
+     */
+    typedef std::pair<double, double> Point_T;
+
+    /*
+     * Class constructor
+     */
+    NtcCalibration(const char* instanceName) : Logs(instanceName)
+    {
+        logChannels_ = Logger::ERRORS;
+    }
+
+    /*
+     * Class destructor
+     */
+    ~NtcCalibration() {}
+
+    /**
+     * Fits Steinhart-Hart coefficients
+     * @param points resistance in Ohm and temperature in degC, at 3 different resistances at least
+     * @param coefficients A, B and C fitted
+     * @param maxError largest difference in degC between a point and the fitted model
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result fitSteinhartHart(const std::vector<Point_T> & points, double coefficients[3], double & maxError);
+
+    /**
+     * Fits gain and offset of reference = gain * measured + offset
+     * @param points measured and reference temperature in degC
+     * @param gain fitted, 1 with a single point
+     * @param offset fitted in degC
+     * @param maxError largest difference in degC between a reference and the calibrated measure
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result fitOffsetGain(const std::vector<Point_T> & points, double & gain, double & offset, double & maxError);
+
+    /**
+     * Reads points file
+     * @param fileName of points file
+     * @param points read
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result readPoints(const char* fileName, std::vector<Point_T> & points);
+
+    /**
+     * Fits Steinhart-Hart coefficients of points file as constants
+     * @param fileName of points file of resistance and temperature
+     * @param constants SH_A_E12, SH_B_E12 and SH_C_E12 fitted
+     * @param numPoints read from points file
+     * @param maxError largest difference in degC between a point and the fitted model
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result fitSteinhartHartConstants(const char* fileName, int32_t constants[3], unsigned int & numPoints, double & maxError);
+
+    /**
+     * Fits gain and offset of points file as constants of an analog channel
+     * @param fileName of points file of measured and reference temperature
+     * @param gainPpm AIN_CAL_GAIN_PPM_<k> fitted
+     * @param offsetMdegC AIN_CAL_OFFSET_MDEGC_<k> fitted
+     * @param numPoints read from points file
+     * @param maxError largest difference in degC between a reference and the calibrated measure
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result fitOffsetGainConstants(const char* fileName, int32_t & gainPpm, int32_t & offsetMdegC, unsigned int & numPoints, double & maxError);
+
+  private:
+
+    /**
+     * Solves 3 linear equations by Gaussian elimination with partial pivoting
+     * @param matrix of coefficients, overwritten
+     * @param vector of constants, overwritten by the solution
+     * @return Result RESULT_ERROR if matrix is singular
+     */
+    static Result solve(double matrix[3][3], double vector[3]);
+
+    /**
+     * Converts value to constant of 1/scale units
+     * @return Result RESULT_ERROR if it does not fit in int32_t
+     */
+    static Result toConstant(double value, double scale, int32_t & constant);
+};
+
+#endif // _NTC_CALIBRATION_H
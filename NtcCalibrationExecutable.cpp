@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   NtcCalibrationExecutable.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements NtcCalibrationExecutable to fit NTC thermistor constants from reference points
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NtcCalibration.h"
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "NtcCalibration.logs";
+
+int main( int argc, const char* argv[] )
+{
+    Result result = RESULT_ERROR;
+
+    NtcCalibration ntcCalibration("NtcCalibration");
+
+    std::string param = ( argc > 1 ) ? argv[1] : "";
+
+    unsigned int numPoints = 0u;
+    double maxError = 0.0;
+    if ( ( param == "-sh" || param == "--steinhartHart" ) && ( argc == 3 ) )
+    {
+        int32_t constants[3];
+        result = ntcCalibration.fitSteinhartHartConstants( argv[2], constants, numPoints, maxError );
+        if ( result == RESULT_OK )
+        {
+            std::cout << "# Steinhart-Hart fit of " << numPoints << " points, largest error " << maxError << " degC" << std::endl;
+            std::cout << "SH_A_E12:" << constants[0] << std::endl;
+            std::cout << "SH_B_E12:" << constants[1] << std::endl;
+            std::cout << "SH_C_E12:" << constants[2] << std::endl;
+        }
+    }
+    else if ( ( param == "-og" || param == "--offsetGain" ) && ( argc == 4 ) )
+    {
+        int32_t gainPpm = 0, offsetMdegC = 0;
+        unsigned int channel = static_cast<unsigned int>( atoi(argv[3]) );
+        result = ntcCalibration.fitOffsetGainConstants( argv[2], gainPpm, offsetMdegC, numPoints, maxError );
+        if ( result == RESULT_OK )
+        {
+            std::cout << "# Gain and offset fit of " << numPoints << " points, largest error " << maxError << " degC" << std::endl;
+            std::cout << "AIN_CAL_GAIN_PPM_" << channel << ":" << gainPpm << std::endl;
+            std::cout << "AIN_CAL_OFFSET_MDEGC_" << channel << ":" << offsetMdegC << std::endl;
+        }
+    }
+    else
+    {
+        std::cout << "ntcCalibration: invalid option " << param << std::endl;
+        std::cout << "usage: NtcCalibration -sh|--steinhartHart <points file of Ohm and degC>" << std::endl;
+        std::cout << "       NtcCalibration -og|--offsetGain <points file of measured and reference degC> <analog channel>" << std::endl;
+        return 2;
+    }
+
+    if ( result == RESULT_OK ) std::cout << "0" << std::endl;
+    else                       std::cout << "1" << std::endl;
+
+    return ( result == RESULT_OK ) ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramConverter.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ProgramConverter class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramConverter.h"
+#include "ProgramStorage.h"
+#include "ProgramTransitionIndex.h"
+#include <stdio.h>
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result ProgramConverter::convertToEventList(const char* inputFileName, const char* outputFileName)
+{
+    std::vector<uint32_t> starts;
+    std::vector<Mask_T> values;
+    uint16_t resolution;
+    uint8_t channelCount;
+
+    if ( readRuns(inputFileName, starts, values, resolution, channelCount) != RESULT_OK ) return RESULT_ERROR;
+
+    return writeEventList(outputFileName, starts, values, resolution, channelCount);
+}
+
+Result ProgramConverter::convertToDenseSlots(const char* inputFileName, const char* outputFileName, uint16_t resolution)
+{
+    std::vector<uint32_t> starts;
+    std::vector<Mask_T> values;
+    uint16_t inputResolution;
+    uint8_t channelCount;
+
+    if ( resolution == 0 || resolution > 60 || 60 % resolution != 0 )
+    {
+        LOGGING(ERRORS, "ERROR unsupported program resolution %d s", resolution);
+        return RESULT_ERROR;
+    }
+    if ( readRuns(inputFileName, starts, values, inputResolution, channelCount) != RESULT_OK ) return RESULT_ERROR;
+    if ( inputResolution % resolution != 0 )
+    {
+        LOGGING(ERRORS, "ERROR program %s of resolution %d s cannot be expressed in %d s slots", inputFileName, inputResolution, resolution);
+        return RESULT_ERROR;
+    }
+
+    // Expand runs into slots
+    std::vector<Mask_T> slots(SECONDS_PER_WEEK / resolution);
+    for ( unsigned int i=0; i < starts.size(); i++ )
+    {
+        uint32_t end = ( i + 1 < starts.size() ) ? starts[i+1] : SECONDS_PER_WEEK;
+        for ( uint32_t slot = starts[i] / resolution; slot < end / resolution; slot++ ) slots[slot] = values[i];
+    }
+
+    return writeDenseSlots(outputFileName, slots, resolution, channelCount);
+}
+
+Result ProgramConverter::writeEventList(const char* fileName, const std::vector<uint32_t> & starts, const std::vector<Mask_T> & values,
+                                        uint16_t resolution, uint8_t channelCount)
+{
+    if ( starts.empty() || starts.size() != values.size() || starts[0] != 0u )
+    {
+        LOGGING(ERRORS, "ERROR invalid event list of %d starts and %d values", starts.size(), values.size());
+        return RESULT_ERROR;
+    }
+
+    ProgramHeader_T header;
+    header.encoding     = EVENT_LIST;
+    header.channelCount = channelCount;
+    header.slotWidth    = programSlotWidth(channelCount);
+    header.resolution   = resolution;
+    header.numSlots     = starts.size();
+
+    std::vector<uint8_t> payload(starts.size() * sizeof(uint32_t));
+    memcpy(payload.data(), starts.data(), starts.size() * sizeof(uint32_t));
+    appendSetpoints(payload, values, header.slotWidth);
+
+    return writeProgram(fileName, header, payload);
+}
+
+Result ProgramConverter::writeDenseSlots(const char* fileName, const std::vector<Mask_T> & slots, uint16_t resolution, uint8_t channelCount)
+{
+    if ( resolution == 0 || slots.size() * resolution != SECONDS_PER_WEEK )
+    {
+        LOGGING(ERRORS, "ERROR %d slots of %d s do not cover a week", slots.size(), resolution);
+        return RESULT_ERROR;
+    }
+
+    ProgramHeader_T header;
+    header.encoding     = DENSE_SLOTS;
+    header.channelCount = channelCount;
+    header.slotWidth    = programSlotWidth(channelCount);
+    header.resolution   = resolution;
+    header.numSlots     = slots.size();
+
+    std::vector<uint8_t> payload;
+    appendSetpoints(payload, slots, header.slotWidth);
+
+    return writeProgram(fileName, header, payload);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result ProgramConverter::readRuns(const char* fileName, std::vector<uint32_t> & starts, std::vector<Mask_T> & values,
+                                  uint16_t & resolution, uint8_t & channelCount)
+{
+    ProgramStorage storage("ProgramConverterStorage");
+    if ( storage.loadWeekProgram(fileName, HOST_TIMER_NUM_OUTPUT_RELAYS) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR loading program file %s", fileName);
+        return RESULT_ERROR;
+    }
+
+    // The transition index holds the runs of any encoding
+    ProgramTransitionIndex index("ProgramConverterIndex");
+    if ( index.build(*storage.getImage(), nullptr, 0u) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR indexing program file %s", fileName);
+        return RESULT_ERROR;
+    }
+
+    starts.clear();
+    values.clear();
+    for ( const ProgramTransitionIndex::Transition_T & transition : index.getTransitions() )
+    {
+        starts.push_back(transition.weekSecond);
+        values.push_back(transition.setpoints);
+    }
+    resolution   = storage.getImage()->resolution;
+    channelCount = storage.getImage()->channelCount;
+
+    LOGGING(INFO, "read %d runs from program file %s", starts.size(), fileName);
+
+    return RESULT_OK;
+}
+
+void ProgramConverter::appendSetpoints(std::vector<uint8_t> & payload, const std::vector<Mask_T> & values, uint8_t slotWidth)
+{
+    size_t offset = payload.size();
+    payload.resize(offset + values.size() * slotWidth);
+    for ( Mask_T value : values )
+    {
+        for ( unsigned int i=0; i < slotWidth; i++, offset++ ) payload[offset] = static_cast<uint8_t>( static_cast<uint64_t>(value) >> (8*i) );
+    }
+}
+
+Result ProgramConverter::writeProgram(const char* fileName, ProgramHeader_T & header, const std::vector<uint8_t> & payload)
+{
+    memcpy(header.magic, PROGRAM_MAGIC, sizeof(PROGRAM_MAGIC));
+    header.version      = PROGRAM_VERSION_2;
+    header.reserved     = 0u;
+    header.crc32        = programCrc32(payload.data(), payload.size());
+
+    // Write to temporary file and rename, so a reader never sees a half-written program
+    std::string tmpFileName = std::string(fileName) + ".tmp";
+    FILE* filePtr = fopen(tmpFileName.c_str(), "w");
+    if ( filePtr == NULL )
+    {
+        LOGGING(ERRORS, "ERROR opening file %s", tmpFileName.c_str());
+        return RESULT_ERROR;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, filePtr) == 1
+                   && fwrite(payload.data(), 1, payload.size(), filePtr) == payload.size();
+    written = ( fclose(filePtr) == 0 ) && written;
+    if ( !written || rename(tmpFileName.c_str(), fileName) != 0 )
+    {
+        LOGGING(ERRORS, "ERROR writing program file %s", fileName);
+        remove(tmpFileName.c_str());
+        return RESULT_ERROR;
+    }
+
+    LOGGING(INFO, "written program file %s with encoding %d, %d slots, %d bytes",
+                  fileName, header.encoding, header.numSlots, sizeof(header) + payload.size());
+
+    return RESULT_OK;
+}
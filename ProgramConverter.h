@@ -0,0 +1,109 @@
+#ifndef _PROGRAM_CONVERTER_H
+#define _PROGRAM_CONVERTER_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramConverter.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of ProgramConverter
+ *
+ *  Converts week programs between the formats defined in ProgramFormat.h.
+ *  Any program accepted by ProgramStorage::loadWeekProgram() (v1, v2 dense
+ *  slots or v2 event list) can be written as v2 event list or v2 dense slots.
+ *  The channel count of the input program is kept and the slot width is the
+ *  narrowest one holding it.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <vector>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "ProgramFormat.h"
+#include "RelayMask.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ProgramConverter : public Logs
+{
+  public:
+
+    /*
+     * Class constructor
+     */
+    ProgramConverter(const char* instanceName) : Logs(instanceName)
+    {
+        logChannels_ = Logger::ERRORS;
+    }
+
+    /*
+     * Class destructor
+     */
+    ~ProgramConverter() {}
+
+    /**
+     * Converts a week program to v2 event list encoding
+     * @param inputFileName program in any supported format
+     * @param outputFileName program to write
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result convertToEventList(const char* inputFileName, const char* outputFileName);
+
+    /**
+     * Converts a week program to v2 dense slots encoding
+     * @param inputFileName program in any supported format
+     * @param outputFileName program to write
+     * @param resolution seconds per slot of the output program; must divide 60
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result convertToDenseSlots(const char* inputFileName, const char* outputFileName, uint16_t resolution);
+
+    /**
+     * Writes a v2 event list program
+     * @param fileName of program to write
+     * @param starts week second of each run, ascending and starting at 0
+     * @param values set points of each run
+     * @param resolution seconds granularity of starts
+     * @param channelCount number of relay channels in values
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result writeEventList(const char* fileName, const std::vector<uint32_t> & starts, const std::vector<Mask_T> & values,
+                          uint16_t resolution, uint8_t channelCount);
+
+    /**
+     * Writes a v2 dense slots program
+     * @param fileName of program to write
+     * @param slots set points of each slot, SECONDS_PER_WEEK / resolution slots
+     * @param resolution seconds per slot
+     * @param channelCount number of relay channels in slots
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result writeDenseSlots(const char* fileName, const std::vector<Mask_T> & slots, uint16_t resolution, uint8_t channelCount);
+
+  private:
+
+    /**
+     * Reads runs of a week program
+     * @param fileName of program in any supported format
+     * @param starts week second of each run
+     * @param values set points of each run
+     * @param resolution finest resolution of program in seconds
+     * @param channelCount number of relay channels of program
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result readRuns(const char* fileName, std::vector<uint32_t> & starts, std::vector<Mask_T> & values,
+                    uint16_t & resolution, uint8_t & channelCount);
+
+    /**
+     * Appends set points to payload in slotWidth little endian bytes
+     */
+    void appendSetpoints(std::vector<uint8_t> & payload, const std::vector<Mask_T> & values, uint8_t slotWidth);
+
+    Result writeProgram(const char* fileName, ProgramHeader_T & header, const std::vector<uint8_t> & payload);
+};
+
+#endif // _PROGRAM_CONVERTER_H
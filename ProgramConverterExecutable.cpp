@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramConverterExecutable.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ProgramConverterExecutable to convert .prog files between formats
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramConverter.h"
+#include <stdlib.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "ProgramConverter.logs";
+
+int main( int argc, const char* argv[] )
+{
+    Result result = RESULT_ERROR;
+
+    ProgramConverter programConverter("ProgramConverter");
+
+    std::string param = ( argc > 1 ) ? argv[1] : "";
+
+    if ( ( param == "-tel" || param == "--toEventList" ) && ( argc == 4 ) )
+    {
+        result = programConverter.convertToEventList( argv[2], argv[3] );
+    }
+    else if ( ( param == "-tds" || param == "--toDenseSlots" ) && ( argc == 5 ) )
+    {
+        result = programConverter.convertToDenseSlots( argv[2], argv[3], static_cast<uint16_t>( atoi(argv[4]) ) );
+    }
+    else
+    {
+        std::cout << "programConverter: invalid option " << param << std::endl;
+        std::cout << "usage: ProgramConverter -tel|--toEventList <input.prog> <output.prog>" << std::endl;
+        std::cout << "       ProgramConverter -tds|--toDenseSlots <input.prog> <output.prog> <resolution seconds>" << std::endl;
+        return 2;
+    }
+
+    if ( result == RESULT_OK ) std::cout << "0" << std::endl;
+    else                       std::cout << "1" << std::endl;
+
+    return ( result == RESULT_OK ) ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#ifndef _PROGRAM_FORMAT_H
+#define _PROGRAM_FORMAT_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramFormat.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of .prog file formats
+ *
+ *  Format v1 (legacy, no header):
+ *      Each minute represented by 1 byte (1 bit per output relay channel).
+ *      Size of file is 7days x 24h x 60min x 1B = 10080 bytes (see HostTimer.h).
+ *
+ *  Format v2:
+ *      ProgramHeader_T (20 bytes, little endian) followed by the payload.
+ *      - magic        : "HTPG".
+ *      - version      : 2.
+ *      - encoding     : layout of the payload (see ProgramEncoding_T).
+ *      - channelCount : number of relay channels, 1 bit per channel in each slot.
+ *      - slotWidth    : bytes per slot set points, 1, 2, 4 or 8 (see programSlotWidth()); little endian.
+ *      - resolution   : seconds per slot, from 1 to 60; must divide 60.
+ *      - numSlots     : number of slots (DENSE_SLOTS) or events (EVENT_LIST) in the payload.
+ *      - crc32        : CRC-32 (IEEE 802.3) of the payload.
+ *
+ *      DENSE_SLOTS encoding: numSlots = 604800 / resolution slots of slotWidth bytes,
+ *      slot N holds the set points from week second N x resolution.
+ *      E.g. resolution 15 allows 15 seconds irrigation pulses in 40320 bytes.
+ *
+ *      EVENT_LIST encoding: run-length compressed program of numSlots events,
+ *      stored as uint32_t run starts (week seconds, sorted ascending, first is 0)
+ *      followed by the set points of each run (slotWidth bytes per event).
+ *      Size is proportional to the number of transitions, not to resolution;
+ *      run starts must be multiples of resolution.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// GLOBAL CONSTANTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const long                 MINUTES_PER_WEEK = 7l*24l*60l;
+const long                 SECONDS_PER_WEEK = MINUTES_PER_WEEK*60l;
+
+const char                 PROGRAM_MAGIC[4] = { 'H', 'T', 'P', 'G' };
+const uint8_t             PROGRAM_VERSION_1 = 1u;
+const uint8_t             PROGRAM_VERSION_2 = 2u;
+const unsigned int PROGRAM_V1_SIZE_IN_BYTES = 10080u;
+const uint16_t        PROGRAM_V1_RESOLUTION = 60u;
+
+enum ProgramEncoding_T
+{
+    DENSE_SLOTS = 0,
+    EVENT_LIST  = 1
+};
+
+struct ProgramHeader_T
+{
+    char     magic[4];
+    uint8_t  version;
+    uint8_t  encoding;
+    uint8_t  channelCount;
+    uint8_t  slotWidth;
+    uint16_t resolution;
+    uint16_t reserved;
+    uint32_t numSlots;
+    uint32_t crc32;
+};
+static_assert( sizeof(ProgramHeader_T) == 20, "ProgramHeader_T must be packed in 20 bytes" );
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// GLOBAL FUNCTIONS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) used in the program header
+ * @param data to checksum
+ * @param size of data in bytes
+ * @param crc previous value to continue a running checksum
+ * @return uint32_t checksum
+ */
+inline uint32_t programCrc32(const uint8_t* data, size_t size, uint32_t crc = 0u)
+{
+    crc = ~crc;
+    for ( size_t i=0; i < size; i++ )
+    {
+        crc ^= data[i];
+        for ( unsigned int bit=0; bit < 8; bit++ ) crc = ( crc >> 1 ) ^ ( 0xEDB88320u & ( 0u - ( crc & 1u ) ) );
+    }
+    return ~crc;
+}
+
+/**
+ * Bytes per slot set points of a program of channelCount relay channels
+ * @param channelCount number of relay channels, from 1 to 64
+ * @return uint8_t slot width of 1, 2, 4 or 8 bytes
+ */
+inline uint8_t programSlotWidth(unsigned int channelCount)
+{
+    return ( channelCount <= 8 ) ? 1u : ( channelCount <= 16 ) ? 2u : ( channelCount <= 32 ) ? 4u : 8u;
+}
+
+#endif // _PROGRAM_FORMAT_H
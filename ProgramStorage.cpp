@@ -0,0 +1,262 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramStorage.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ProgramStorage class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramStorage.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+ProgramStorage::~ProgramStorage()
+{
+    release(active_.exchange(nullptr));
+    release(retired_);
+}
+
+Result ProgramStorage::load(const char* fileName, size_t expectedSize)
+{
+    ProgramImage* image = new ProgramImage;
+    if ( map(fileName, *image) != RESULT_OK )
+    {
+        delete image;
+        return RESULT_ERROR;
+    }
+    if ( expectedSize != 0 && image->size != expectedSize )
+    {
+        LOGGING(ERRORS, "ERROR program file %s size is %zu bytes, expected %zu", fileName, image->size, expectedSize);
+        release(image);
+        return RESULT_ERROR;
+    }
+
+    publish(image);
+
+    return RESULT_OK;
+}
+
+Result ProgramStorage::loadWeekProgram(const char* fileName, unsigned int maxChannels)
+{
+    ProgramImage* image = new ProgramImage;
+    if ( map(fileName, *image) != RESULT_OK )
+    {
+        delete image;
+        return RESULT_ERROR;
+    }
+    if ( parseWeekProgram(*image, maxChannels) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR program file %s is not a valid week program", fileName);
+        release(image);
+        return RESULT_ERROR;
+    }
+
+    LOGGING(INFO, "program file %s is format v%d, resolution %d s, %d slots, %d channels",
+                  fileName, image->version, image->resolution, image->numSlots, image->channelCount);
+
+    publish(image);
+
+    return RESULT_OK;
+}
+
+Result ProgramStorage::readByte(size_t offset, Byte_T & byte) const
+{
+    const ProgramImage* image = getImage();
+    if ( image == nullptr || offset >= image->size )
+    {
+        LOGGING(ERRORS, "ERROR reading program byte in position %zu", offset);
+        return RESULT_ERROR;
+    }
+    byte = image->data[offset];
+
+    return RESULT_OK;
+}
+
+Mask_T ProgramStorage::ProgramImage::lookup(long weekSecond) const
+{
+    if ( encoding == DENSE_SLOTS ) return slot(weekSecond / resolution);
+
+    // Last run starting at or before weekSecond; first run always starts at 0
+    const uint32_t* run = std::upper_bound(eventStarts, eventStarts + numSlots, static_cast<uint32_t>(weekSecond));
+    return slot(run - eventStarts - 1);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result ProgramStorage::map(const char* fileName, ProgramImage & image)
+{
+    int fd = open(fileName, O_RDONLY | O_CLOEXEC);
+    if ( fd < 0 )
+    {
+        LOGGING(ERRORS, "ERROR opening program file %s with errno %d", fileName, errno);
+        return RESULT_ERROR;
+    }
+
+    struct stat fileStat;
+    if ( fstat(fd, &fileStat) != 0 || fileStat.st_size == 0 )
+    {
+        LOGGING(ERRORS, "ERROR program file %s is empty or not readable", fileName);
+        close(fd);
+        return RESULT_ERROR;
+    }
+    size_t size = static_cast<size_t>(fileStat.st_size);
+
+    // Populate pages now so lookups never fault on the SD card
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if ( mapping == MAP_FAILED )
+    {
+        LOGGING(ERRORS, "ERROR mapping program file %s with errno %d", fileName, errno);
+        return RESULT_ERROR;
+    }
+
+    image.fileName     = fileName;
+    image.data         = static_cast<const Byte_T*>(mapping);
+    image.size         = size;
+    image.version      = 0u;
+    image.encoding     = DENSE_SLOTS;
+    image.channelCount = 8u;
+    image.slotWidth    = 1u;
+    image.resolution   = 1u;
+    image.numSlots     = size;
+    image.payload      = image.data;
+    image.eventStarts  = nullptr;
+    image.eventValues  = nullptr;
+
+    LOGGING(INFO, "mapped program file %s of %zu bytes", fileName, size);
+
+    return RESULT_OK;
+}
+
+Result ProgramStorage::parseWeekProgram(ProgramImage & image, unsigned int maxChannels)
+{
+    // Format v2: versioned header
+    if ( image.size >= sizeof(ProgramHeader_T) && memcmp(image.data, PROGRAM_MAGIC, sizeof(PROGRAM_MAGIC)) == 0 )
+    {
+        ProgramHeader_T header;
+        memcpy(&header, image.data, sizeof(header));
+
+        if ( header.version != PROGRAM_VERSION_2 )
+        {
+            LOGGING(ERRORS, "ERROR unsupported program version %d", header.version);
+            return RESULT_ERROR;
+        }
+        if ( header.resolution == 0 || header.resolution > 60 || 60 % header.resolution != 0 )
+        {
+            LOGGING(ERRORS, "ERROR unsupported program resolution %d s", header.resolution);
+            return RESULT_ERROR;
+        }
+        if ( header.channelCount == 0 || header.channelCount > maxChannels
+             || header.slotWidth != programSlotWidth(header.channelCount) || header.slotWidth > sizeof(Mask_T) )
+        {
+            LOGGING(ERRORS, "ERROR unsupported program with %d channels in %d bytes slots", header.channelCount, header.slotWidth);
+            return RESULT_ERROR;
+        }
+
+        const Byte_T* payload = image.data + sizeof(ProgramHeader_T);
+        size_t payloadSize = image.size - sizeof(ProgramHeader_T);
+
+        uint32_t crc = programCrc32(payload, payloadSize);
+        if ( crc != header.crc32 )
+        {
+            LOGGING(ERRORS, "ERROR program CRC 0x%08x does not match header CRC 0x%08x", crc, header.crc32);
+            return RESULT_ERROR;
+        }
+
+        switch ( header.encoding )
+        {
+        case DENSE_SLOTS:
+            if ( header.numSlots != SECONDS_PER_WEEK / header.resolution ||
+                 static_cast<uint64_t>(payloadSize) != static_cast<uint64_t>(header.numSlots) * header.slotWidth )
+            {
+                LOGGING(ERRORS, "ERROR program payload of %zu bytes does not hold %d slots", payloadSize, header.numSlots);
+                return RESULT_ERROR;
+            }
+            break;
+        case EVENT_LIST:
+            // Bounded before sizes are computed, in 64 bits so they cannot wrap on 32-bit targets
+            if ( header.numSlots == 0 || header.numSlots > SECONDS_PER_WEEK / header.resolution ||
+                 static_cast<uint64_t>(payloadSize) != static_cast<uint64_t>(header.numSlots) * ( sizeof(uint32_t) + header.slotWidth ) )
+            {
+                LOGGING(ERRORS, "ERROR program payload of %zu bytes does not hold %d events", payloadSize, header.numSlots);
+                return RESULT_ERROR;
+            }
+            image.eventStarts = reinterpret_cast<const uint32_t*>(payload);
+            image.eventValues = payload + header.numSlots * sizeof(uint32_t);
+            if ( image.eventStarts[0] != 0u )
+            {
+                LOGMSG(ERRORS, "ERROR program first event does not start at week second 0");
+                return RESULT_ERROR;
+            }
+            for ( uint32_t i=1; i < header.numSlots; i++ )
+            {
+                if ( image.eventStarts[i] <= image.eventStarts[i-1] || image.eventStarts[i] >= SECONDS_PER_WEEK
+                     || image.eventStarts[i] % header.resolution != 0 )
+                {
+                    LOGGING(ERRORS, "ERROR program event %d starting at week second %d is out of order", i, image.eventStarts[i]);
+                    return RESULT_ERROR;
+                }
+            }
+            break;
+        default:
+            LOGGING(ERRORS, "ERROR unsupported program encoding %d", header.encoding);
+            return RESULT_ERROR;
+        }
+
+        image.version      = header.version;
+        image.encoding     = header.encoding;
+        image.channelCount = header.channelCount;
+        image.slotWidth    = header.slotWidth;
+        image.resolution   = header.resolution;
+        image.numSlots     = header.numSlots;
+        image.payload      = payload;
+
+        return RESULT_OK;
+    }
+
+    // Format v1: one byte per week minute without header
+    if ( image.size == PROGRAM_V1_SIZE_IN_BYTES )
+    {
+        image.version      = PROGRAM_VERSION_1;
+        image.encoding     = DENSE_SLOTS;
+        image.channelCount = 8u;
+        image.slotWidth    = 1u;
+        image.resolution   = PROGRAM_V1_RESOLUTION;
+        image.numSlots     = PROGRAM_V1_SIZE_IN_BYTES;
+        image.payload      = image.data;
+
+        return RESULT_OK;
+    }
+
+    LOGGING(ERRORS, "ERROR program of %zu bytes has no v2 header and is not a v1 program", image.size);
+    return RESULT_ERROR;
+}
+
+void ProgramStorage::publish(ProgramImage* image)
+{
+    // Publish new image, the previous one is retired until next load
+    release(retired_);
+    retired_ = active_.exchange(image, std::memory_order_acq_rel);
+}
+
+void ProgramStorage::release(ProgramImage* image)
+{
+    if ( image == nullptr ) return;
+
+    munmap(const_cast<Byte_T*>(image->data), image->size);
+    delete image;
+}
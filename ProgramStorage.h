@@ -0,0 +1,165 @@
+#ifndef _PROGRAM_STORAGE_H
+#define _PROGRAM_STORAGE_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramStorage.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of ProgramStorage
+ *
+ *  Holds the active .prog file memory-mapped read-only; lookups read
+ *  directly from the mapping without any file I/O in the control loop.
+ *
+ *  Program swap:
+ *      - load() maps and validates the new file completely before publishing it.
+ *      - The active image pointer is then swapped atomically, so a reader
+ *        sees either the old or the new program, never a mix of both.
+ *      - The previous image stays mapped until the following load(), so a
+ *        reader still holding it when the swap happens is never left with
+ *        an unmapped pointer.
+ *      - HostKeeper replaces files with mv, so the mapped inode is never
+ *        written while mapped.
+ *
+ *  Week programs are accepted in format v1 (10080 bytes, no header) and
+ *  v2 (versioned header, see ProgramFormat.h); both are served through
+ *  ProgramImage::lookup() by week second. Slots of v2 programs are 1 to
+ *  sizeof(Mask_T) bytes wide, so a build with more relays also runs the
+ *  narrower programs of smaller hosts.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <string>
+#include <string.h>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "ProgramFormat.h"
+#include "RelayMask.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ProgramStorage : public Logs
+{
+  public:
+
+    struct ProgramImage
+    {
+        std::string fileName;
+        const Byte_T* data;
+        size_t size;
+
+        // Week program layout, resolved at load time
+        uint8_t version;
+        uint8_t encoding;
+        uint8_t channelCount;
+        uint8_t slotWidth;
+        uint16_t resolution;
+        uint32_t numSlots;
+        const Byte_T* payload;
+
+        // Run starts and set points of EVENT_LIST programs
+        const uint32_t* eventStarts;
+        const Byte_T* eventValues;
+
+        /**
+         * Set points in force at weekSecond, binary searched in EVENT_LIST programs
+         * @param weekSecond from 0 to SECONDS_PER_WEEK - 1
+         * @return Mask_T set points
+         */
+        Mask_T lookup(long weekSecond) const;
+
+        /**
+         * Set points of slot (DENSE_SLOTS) or event (EVENT_LIST)
+         * @param index of slot or event, from 0 to numSlots - 1
+         * @return Mask_T set points
+         */
+        Mask_T slot(uint32_t index) const
+        {
+            const Byte_T* slots = ( encoding == EVENT_LIST ) ? eventValues : payload;
+            if ( slotWidth == 1u ) return slots[index];
+
+            Mask_T setpoints = 0u;
+            memcpy(&setpoints, slots + index * slotWidth, slotWidth);
+            return setpoints;
+        }
+    };
+
+    /*
+     * Class constructor
+     */
+    ProgramStorage(const char* instanceName) : Logs(instanceName)
+    {
+        logChannels_ = Logger::ERRORS;
+    }
+
+    /*
+     * Class destructor
+     */
+    ~ProgramStorage();
+
+    /**
+     * Maps program file and makes it the active program
+     * @param fileName of program file
+     * @param expectedSize of program file in bytes, 0 to accept any size
+     * @return Result RESULT_OK in case of correct execution; on error the active program is kept
+     */
+    Result load(const char* fileName, size_t expectedSize = 0);
+
+    /**
+     * Maps week program file in format v1 or v2, validates it and makes it the active program
+     * @param fileName of program file
+     * @param maxChannels number of relay channels supported by the host, at most NUM_OUTPUT_RELAYS
+     * @return Result RESULT_OK in case of correct execution; on error the active program is kept
+     */
+    Result loadWeekProgram(const char* fileName, unsigned int maxChannels);
+
+    /**
+     * Active program image
+     * @return const ProgramImage* active image or nullptr if no program is loaded
+     */
+    const ProgramImage* getImage() const { return active_.load(std::memory_order_acquire); }
+
+    bool isLoaded() const { return getImage() != nullptr; }
+
+    /**
+     * Reads one byte of the active program
+     * @param offset of byte in program
+     * @param byte read
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result readByte(size_t offset, Byte_T & byte) const;
+
+  private:
+
+    std::atomic<ProgramImage*> active_ { nullptr };
+
+    ProgramImage* retired_ = nullptr;
+
+    /**
+     * Maps file read-only
+     * @param fileName of file
+     * @param image filled with mapping; layout fields describe a raw byte array
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result map(const char* fileName, ProgramImage & image);
+
+    /**
+     * Resolves layout fields of a mapped week program
+     * @param image mapped week program
+     * @param maxChannels number of relay channels supported by the host
+     * @return Result RESULT_OK in case of valid program
+     */
+    Result parseWeekProgram(ProgramImage & image, unsigned int maxChannels);
+
+    void publish(ProgramImage* image);
+
+    void release(ProgramImage* image);
+};
+
+#endif // _PROGRAM_STORAGE_H
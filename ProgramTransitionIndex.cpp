@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramTransitionIndex.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ProgramTransitionIndex class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramTransitionIndex.h"
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result ProgramTransitionIndex::build(const ProgramStorage::ProgramImage & program, const uint8_t* dutyCycles, unsigned int numRelays)
+{
+    clear();
+
+    // Program transitions: the first slot is always an entry so lookups never fall before the index
+    switch ( program.encoding )
+    {
+    case DENSE_SLOTS:
+        if ( program.resolution == 0 || program.numSlots * program.resolution != SECONDS_PER_WEEK )
+        {
+            LOGGING(ERRORS, "ERROR unexpected program of %d slots of %d s, expected %ld s", program.numSlots, program.resolution, SECONDS_PER_WEEK);
+            return RESULT_ERROR;
+        }
+        transitions_.push_back( { 0u, program.slot(0) } );
+        for ( unsigned int i=1; i < program.numSlots; i++ )
+        {
+            Mask_T setpoints = program.slot(i);
+            if ( setpoints != transitions_.back().setpoints )
+            {
+                transitions_.push_back( { static_cast<uint32_t>(i * program.resolution), setpoints } );
+            }
+        }
+        break;
+    case EVENT_LIST:
+        // Already run-length encoded: copy runs, merging consecutive runs with equal set points
+        transitions_.reserve(program.numSlots);
+        transitions_.push_back( { 0u, program.slot(0) } );
+        for ( unsigned int i=1; i < program.numSlots; i++ )
+        {
+            Mask_T setpoints = program.slot(i);
+            if ( setpoints != transitions_.back().setpoints )
+            {
+                transitions_.push_back( { program.eventStarts[i], setpoints } );
+            }
+        }
+        break;
+    default:
+        LOGGING(ERRORS, "ERROR unsupported program encoding %d", program.encoding);
+        return RESULT_ERROR;
+    }
+
+    // Duty-cycle boundaries: relays are enabled while tm_sec < dutyCycle
+    for ( unsigned int i=0; i < numRelays; i++ )
+    {
+        if ( dutyCycles[i] > 0 && dutyCycles[i] < 60 ) dutyCycleBoundaries_.push_back(dutyCycles[i]);
+    }
+    std::sort(dutyCycleBoundaries_.begin(), dutyCycleBoundaries_.end());
+    dutyCycleBoundaries_.erase(std::unique(dutyCycleBoundaries_.begin(), dutyCycleBoundaries_.end()), dutyCycleBoundaries_.end());
+
+    LOGGING(INFO, "built index of %zu program transitions and %zu duty-cycle boundaries", transitions_.size(), dutyCycleBoundaries_.size());
+
+    return RESULT_OK;
+}
+
+void ProgramTransitionIndex::clear()
+{
+    cursor_ = 0u;
+    transitions_.clear();
+    dutyCycleBoundaries_.clear();
+}
+
+Mask_T ProgramTransitionIndex::lookup(long weekSecond) const
+{
+    assert( !transitions_.empty() );
+
+    // Steady state: weekSecond is in the cursor run or in the next one
+    unsigned int size = transitions_.size();
+    for ( unsigned int step=0; step < 2 && cursor_ + step < size; step++ )
+    {
+        unsigned int run = cursor_ + step;
+        if ( transitions_[run].weekSecond <= weekSecond && ( run + 1 == size || weekSecond < transitions_[run + 1].weekSecond ) )
+        {
+            cursor_ = run;
+            return transitions_[run].setpoints;
+        }
+    }
+
+    // Jump: last transition at or before weekSecond
+    auto it = std::upper_bound(transitions_.begin(), transitions_.end(), weekSecond,
+                               [] (long time, const Transition_T & transition) { return time < transition.weekSecond; });
+    cursor_ = (--it) - transitions_.begin();
+    return it->setpoints;
+}
+
+long ProgramTransitionIndex::secondsToNextEvent(long weekSecond) const
+{
+    assert( !transitions_.empty() );
+
+    long second = weekSecond % 60;
+
+    // Next program transition, or the start of next week where the program wraps around
+    long nextSecond = SECONDS_PER_WEEK;
+    auto it = std::upper_bound(transitions_.begin(), transitions_.end(), weekSecond,
+                               [] (long time, const Transition_T & transition) { return time < transition.weekSecond; });
+    if ( it != transitions_.end() ) nextSecond = it->weekSecond;
+    long seconds = nextSecond - weekSecond;
+
+    // Next duty-cycle boundary, or the start of next minute where duty cycles restart
+    if ( !dutyCycleBoundaries_.empty() )
+    {
+        long boundary = 60;
+        auto bit = std::upper_bound(dutyCycleBoundaries_.begin(), dutyCycleBoundaries_.end(), static_cast<uint8_t>(second));
+        if ( bit != dutyCycleBoundaries_.end() ) boundary = *bit;
+        seconds = std::min(seconds, boundary - second);
+    }
+
+    return std::max(seconds, 1l);
+}
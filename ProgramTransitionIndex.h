@@ -0,0 +1,109 @@
+#ifndef _PROGRAM_TRANSITION_INDEX_H
+#define _PROGRAM_TRANSITION_INDEX_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramTransitionIndex.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of ProgramTransitionIndex
+ *
+ *  Sorted index of the week seconds where the program set points change,
+ *  built once when a .prog file is loaded. It replaces the per-second read
+ *  of the program file and lets the control loop compute when the relay
+ *  set points can next change:
+ *      - program transitions  : (weekSecond, newSetpoints) pairs, wrapping at the end of the week.
+ *      - duty-cycle boundaries: seconds within every minute where Channel_T::dutyCycle switches a relay off.
+ *
+ *  Lookups keep a cursor on the last transition found: as the control loop
+ *  moves forward in time the cursor advances in O(1), and only a jump
+ *  (program swap, clock step) falls back to an O(log n) binary search.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <vector>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "ProgramFormat.h"
+#include "ProgramStorage.h"
+#include "RelayMask.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ProgramTransitionIndex : public Logs
+{
+  public:
+
+    struct Transition_T
+    {
+        uint32_t weekSecond;
+        Mask_T setpoints;
+    };
+
+    /*
+     * Class constructor
+     */
+    ProgramTransitionIndex(const char* instanceName) : Logs(instanceName)
+    {
+        logChannels_ = Logger::ERRORS;
+    }
+
+    /*
+     * Class destructor
+     */
+    ~ProgramTransitionIndex() {}
+
+    /**
+     * Builds the index from a week program in any format and encoding
+     * @param program mapped and validated week program
+     * @param dutyCycles duty cycle in seconds of each output relay
+     * @param numRelays number of elements in dutyCycles
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result build(const ProgramStorage::ProgramImage & program, const uint8_t* dutyCycles, unsigned int numRelays);
+
+    /**
+     * Clears the index
+     */
+    void clear();
+
+    bool isEmpty() const { return transitions_.empty(); }
+
+    unsigned int getNumTransitions() const { return transitions_.size(); }
+
+    const std::vector<Transition_T> & getTransitions() const { return transitions_; }
+
+    /**
+     * Program set points in force at weekSecond
+     * @param weekSecond from 0 to SECONDS_PER_WEEK - 1
+     * @return Mask_T set points
+     */
+    Mask_T lookup(long weekSecond) const;
+
+    /**
+     * Seconds from weekSecond until the next program transition or duty-cycle boundary
+     * @param weekSecond from 0 to SECONDS_PER_WEEK - 1
+     * @return long number of seconds, at least 1
+     */
+    long secondsToNextEvent(long weekSecond) const;
+
+  private:
+
+    std::vector<Transition_T> transitions_;
+
+    /*
+     * Position of last transition found by lookup()
+     */
+    mutable unsigned int cursor_ = 0u;
+
+    /*
+     * Sorted seconds within the minute (1..59) where any duty cycle ends
+     */
+    std::vector<uint8_t> dutyCycleBoundaries_;
+};
+
+#endif // _PROGRAM_TRANSITION_INDEX_H
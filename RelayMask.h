@@ -0,0 +1,88 @@
+#ifndef _RELAY_MASK_H
+#define _RELAY_MASK_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   RelayMask.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of relay masks
+ *
+ *  Relay set points and masks hold 1 bit per output relay channel. The
+ *  number of relays is fixed at compile time with HOST_TIMER_NUM_OUTPUT_RELAYS
+ *  (default 8, up to 64, e.g. -DHOST_TIMER_NUM_OUTPUT_RELAYS=16 for one
+ *  relay expansion board) and Mask_T is the narrowest unsigned integer
+ *  holding them, so every relay count gets single-register mask code.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// BUILD FLAGS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HOST_TIMER_NUM_OUTPUT_RELAYS
+#define HOST_TIMER_NUM_OUTPUT_RELAYS 8
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// TEMPLATE DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <unsigned int NUM_RELAYS>
+struct RelayMaskTraits
+{
+    static_assert( NUM_RELAYS >= 1 && NUM_RELAYS <= 64, "number of output relays must be from 1 to 64" );
+
+    typedef typename std::conditional< NUM_RELAYS <=  8, uint8_t,
+            typename std::conditional< NUM_RELAYS <= 16, uint16_t,
+            typename std::conditional< NUM_RELAYS <= 32, uint32_t,
+                                                         uint64_t >::type >::type >::type Type;
+
+    /*
+     * Mask with all relay bits set
+     */
+    static constexpr Type ALL = ( NUM_RELAYS == 8*sizeof(Type) ) ? static_cast<Type>(~static_cast<Type>(0))
+                                                                 : static_cast<Type>( ( static_cast<Type>(1) << ( NUM_RELAYS % (8*sizeof(Type)) ) ) - 1u );
+
+    /*
+     * Mask with bit of relay channel set
+     */
+    static constexpr Type bit(unsigned int channel) { return static_cast<Type>( static_cast<Type>(1) << channel ); }
+
+    /**
+     * Converts mask to binary string, most significant relay first
+     * @param mask to convert
+     * @return std::string of NUM_RELAYS characters '0' or '1'
+     */
+    static std::string toString(Type mask)
+    {
+        std::string str(NUM_RELAYS, '0');
+        for ( unsigned int i=0; i < NUM_RELAYS; i++ )
+        {
+            if ( ( mask >> i ) & 1u ) str[NUM_RELAYS - 1 - i] = '1';
+        }
+        return str;
+    }
+
+    /**
+     * Relay indices in the layout of toString(), last digit of each
+     * @return std::string of NUM_RELAYS digits, "76543210" for 8 relays
+     */
+    static std::string indexString()
+    {
+        std::string str(NUM_RELAYS, '0');
+        for ( unsigned int i=0; i < NUM_RELAYS; i++ ) str[NUM_RELAYS - 1 - i] = static_cast<char>( '0' + i % 10u );
+        return str;
+    }
+};
+
+typedef RelayMaskTraits<HOST_TIMER_NUM_OUTPUT_RELAYS> RelayMask;
+typedef RelayMask::Type Mask_T;
+
+#endif // _RELAY_MASK_H
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   RelayOutputs.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements RelayOutputs class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RelayOutputs.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+RelayOutputs::RelayOutputs(const char* instanceName, IGpioBulk* gpio, const uint8_t* gpioIds, unsigned int numRelays, unsigned int verifyPeriodSeconds)
+:   Logs(instanceName),
+    gpio_(gpio),
+    numRelays_(numRelays),
+    verifyPeriodSeconds_(verifyPeriodSeconds)
+{
+    logChannels_ = Logger::ERRORS;
+
+    ASSERT( gpio_ != nullptr && numRelays_ <= MAX_NUM_RELAYS );
+    for ( unsigned int i=0; i < MAX_NUM_RELAYS; i++ )
+    {
+        gpioIds_[i] = ( i < numRelays_ ) ? gpioIds[i] : 0u;
+        if ( i < numRelays_ ) gpioMask_ |= ( 1u << gpioIds_[i] );
+        switchCount_[i] = 0u;
+    }
+}
+
+Result RelayOutputs::commit(Mask_T setpoints, time_t now)
+{
+    Mask_T relaysMask = static_cast<Mask_T>( ( 1ull << numRelays_ ) - 1u );
+    setpoints &= relaysMask;
+
+    // Only relays whose set point changed are written
+    Mask_T changed = valid_ ? ( setpoints ^ shadow_ ) : relaysMask;
+    if ( changed != 0u )
+    {
+        if ( valid_ )
+        {
+            for ( unsigned int i=0; i < numRelays_; i++ ) if ( ( changed >> i ) & 1u ) switchCount_[i]++;
+        }
+        if ( write(changed, setpoints) != RESULT_OK ) return RESULT_ERROR;
+        // Writing all relays verifies them all
+        if ( !valid_ ) lastVerifyTime_ = now;
+        valid_ = true;
+    }
+
+    // Low rate read back of all relays
+    if ( verifyPeriodSeconds_ > 0u && now - lastVerifyTime_ >= static_cast<time_t>(verifyPeriodSeconds_) )
+    {
+        lastVerifyTime_ = now;
+        if ( verify() != RESULT_OK ) return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result RelayOutputs::write(Mask_T mask, Mask_T setpoints)
+{
+    IGpioBulk::GpioMask_T gpioMask = toGpioMask(mask, RelayMask::ALL);
+    IGpioBulk::GpioMask_T gpioLevels = toGpioMask(mask, setpoints);
+
+    // setLevels() verifies the written relays in one batch
+    ioCount_++;
+    if ( gpio_->setLevels(gpioMask, gpioLevels) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR setting levels 0x%x of relay GPIO mask 0x%x", gpioLevels, gpioMask);
+        valid_ = false;
+        return RESULT_ERROR;
+    }
+    shadow_ = ( shadow_ & ~mask ) | ( setpoints & mask );
+
+    return RESULT_OK;
+}
+
+Result RelayOutputs::verify()
+{
+    if ( !valid_ ) return RESULT_OK;
+
+    IGpioBulk::GpioMask_T gpioLevels;
+    ioCount_++;
+    if ( gpio_->getLevels(gpioMask_, gpioLevels) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR getting levels of relay GPIO mask 0x%x", gpioMask_);
+        return RESULT_ERROR;
+    }
+
+    Mask_T tampered = 0u;
+    for ( unsigned int i=0; i < numRelays_; i++ )
+    {
+        Mask_T level = ( gpioLevels >> gpioIds_[i] ) & 1u;
+        if ( level != ( ( shadow_ >> i ) & 1u ) ) tampered |= RelayMask::bit(i);
+    }
+    if ( tampered == 0u ) return RESULT_OK;
+
+    for ( unsigned int i=0; i < numRelays_; i++ ) if ( ( tampered >> i ) & 1u ) tamperCount_++;
+    LOGGING(ERRORS, "WARNING relays %s found different from committed levels %s, writing them again",
+                    RelayMask::toString(tampered).c_str(), RelayMask::toString(shadow_).c_str());
+
+    return write(tampered, shadow_);
+}
+
+IGpioBulk::GpioMask_T RelayOutputs::toGpioMask(Mask_T mask, Mask_T setpoints) const
+{
+    IGpioBulk::GpioMask_T gpioMask = 0u;
+    for ( unsigned int i=0; i < numRelays_; i++ )
+    {
+        if ( ( ( mask & setpoints ) >> i ) & 1u ) gpioMask |= ( 1u << gpioIds_[i] );
+    }
+
+    return gpioMask;
+}
@@ -0,0 +1,128 @@
+#ifndef _RELAY_OUTPUTS_H
+#define _RELAY_OUTPUTS_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   RelayOutputs.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of RelayOutputs
+ *
+ *  Relay output layer between the control loop and the GPIO's, keeping a
+ *  shadow of the relay levels last committed to the hardware:
+ *      - commit() writes only the relays whose set point changed, with one
+ *        setLevels() that verifies them in one batch; unchanged set points
+ *        cost no I/O.
+ *      - Every verifyPeriodSeconds all relays are read back in one
+ *        getLevels(); relays found different from the shadow (external
+ *        tampering, driver reset) are counted and written again.
+ *      - invalidate() forces all relays to be written at next commit, e.g.
+ *        after setMode() has reset a relay GPIO.
+ *  Per relay switch counters and I/O counters are kept for reporting.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <time.h>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "IGpioBulk.h"
+#include "RelayMask.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class RelayOutputs : public Logs
+{
+  public:
+
+    static const unsigned int MAX_NUM_RELAYS = 32u;
+
+    /*
+     * Class constructor
+     * @param gpio GPIO's driving the relays, not owned
+     * @param gpioIds GPIO Id of each relay
+     * @param numRelays number of relays, up to MAX_NUM_RELAYS
+     * @param verifyPeriodSeconds period of read back of all relays, 0 to disable
+     */
+    RelayOutputs(const char* instanceName, IGpioBulk* gpio, const uint8_t* gpioIds, unsigned int numRelays, unsigned int verifyPeriodSeconds);
+
+    /*
+     * Class destructor
+     */
+    ~RelayOutputs() {}
+
+    /**
+     * Commits relay set points: writes changed relays and, if due, verifies all relays
+     * @param setpoints bit i is set point of relay i
+     * @param now current wall-clock second, to schedule verification
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result commit(Mask_T setpoints, time_t now);
+
+    /**
+     * Forces all relays to be written at next commit
+     */
+    void invalidate() { valid_ = false; }
+
+    /**
+     * Relay levels last committed
+     */
+    Mask_T getShadow() const { return shadow_; }
+
+    uint64_t getSwitchCount(unsigned int relay) const { return switchCount_[relay]; }
+
+    /*
+     * Number of setLevels() and getLevels() calls to the GPIO's
+     */
+    uint64_t getIoCount() const { return ioCount_; }
+
+    /*
+     * Number of relays found different from shadow at verification
+     */
+    uint64_t getTamperCount() const { return tamperCount_; }
+
+  private:
+
+    IGpioBulk * gpio_;
+
+    unsigned int numRelays_;
+    uint8_t gpioIds_[MAX_NUM_RELAYS];
+    IGpioBulk::GpioMask_T gpioMask_ = 0u;
+
+    unsigned int verifyPeriodSeconds_;
+    time_t lastVerifyTime_ = 0;
+
+    Mask_T shadow_ = 0u;
+    bool valid_ = false;
+
+    uint64_t switchCount_[MAX_NUM_RELAYS];
+    uint64_t ioCount_ = 0u;
+    uint64_t tamperCount_ = 0u;
+
+    /**
+     * Writes relays of mask and updates shadow
+     * @param mask of relays to write
+     * @param setpoints bit i is set point of relay i
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result write(Mask_T mask, Mask_T setpoints);
+
+    /**
+     * Reads back all relays and rewrites those different from shadow
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result verify();
+
+    /**
+     * GPIO levels of relays
+     * @param mask of relays
+     * @param setpoints bit i is level of relay i
+     * @return IGpioBulk::GpioMask_T bit of GPIO Id of relay i is level of relay i
+     */
+    IGpioBulk::GpioMask_T toGpioMask(Mask_T mask, Mask_T setpoints) const;
+};
+
+#endif // _RELAY_OUTPUTS_H
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ScheduleReplay.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ScheduleReplay class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ScheduleReplay.h"
+#include <string.h>
+#include <chrono>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScheduleReplay::ScheduleReplay(const char* instanceName, unsigned int tickRateHz) : Logs(instanceName)
+{
+    logChannels_ = Logger::ERRORS;
+
+    tickRateHz_ = tickRateHz;
+
+    ControlFiles::setDefaultChannels(channels_);
+    guards_[0].type = END_OF_GUARDS;
+    memset(guardTunings_, 0, sizeof(guardTunings_));
+    memset(relayTimings_, 0, sizeof(relayTimings_));
+
+    programStorage_ = new ProgramStorage("ScheduleReplayProgram");
+    ASSERT( programStorage_ != nullptr );
+}
+
+ScheduleReplay::~ScheduleReplay()
+{
+    delete programStorage_;
+}
+
+Result ScheduleReplay::loadChannels(const char* fileName)
+{
+    ControlFiles controlFiles("ScheduleReplayChannels");
+    return controlFiles.readChannels(fileName, channels_);
+}
+
+Result ScheduleReplay::loadGuards(const char* fileName)
+{
+    ControlFiles controlFiles("ScheduleReplayGuards");
+    return controlFiles.readGuards(fileName, guards_);
+}
+
+Result ScheduleReplay::setTunings(const GuardTuning_T* tunings, const RelayTiming_T* timings)
+{
+    for ( unsigned int i=0; tunings != nullptr && i < MAX_NUM_GUARDS; i++ )
+    {
+        if ( !( tunings[i].hysteresis >= 0.0f ) )
+        {
+            LOGGING(ERRORS, "ERROR hysteresis %.3f of guard %d must not be negative", tunings[i].hysteresis, i+1);
+            return RESULT_ERROR;
+        }
+    }
+
+    if ( tunings == nullptr ) memset(guardTunings_, 0, sizeof(guardTunings_));
+    else memcpy(guardTunings_, tunings, sizeof(guardTunings_));
+    if ( timings == nullptr ) memset(relayTimings_, 0, sizeof(relayTimings_));
+    else memcpy(relayTimings_, timings, sizeof(relayTimings_));
+
+    return RESULT_OK;
+}
+
+Result ScheduleReplay::loadProgram(const char* fileName)
+{
+    if ( programStorage_->loadWeekProgram(fileName, NUM_OUTPUT_RELAYS) != RESULT_OK )
+    {
+        LOGGING(ERRORS, "ERROR loading program file %s", fileName);
+        return RESULT_ERROR;
+    }
+
+    return RESULT_OK;
+}
+
+Result ScheduleReplay::run(unsigned int weeks, Stats_T & stats, FILE* transitionsFile)
+{
+    ControlEngine engine("ScheduleReplayEngine");
+    if ( engine.configure(channels_, guards_) != RESULT_OK || engine.setGuardTunings(guardTunings_) != RESULT_OK ||
+         engine.setProgram(programStorage_->getImage()) != RESULT_OK )
+    {
+        LOGMSG(ERRORS, "ERROR configuring control engine");
+        return RESULT_ERROR;
+    }
+    engine.setRelayTimings(relayTimings_);
+
+    SimulatedClock clock;
+    TickScheduler scheduler("ScheduleReplayScheduler", tickRateHz_, &clock);
+    if ( scheduler.initialize() != RESULT_OK )
+    {
+        LOGMSG(ERRORS, "ERROR initializing tick scheduler");
+        return RESULT_ERROR;
+    }
+
+    stats.weeks = weeks;
+    stats.tickRateHz = scheduler.getTickRateHz();
+    stats.ticks = 0u;
+    stats.relaySwitches = 0u;
+
+    Result result = RESULT_OK;
+    Mask_T relaySetpoints = 0u;
+    time_t endTime = static_cast<time_t>(weeks) * SECONDS_PER_WEEK;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for ( ;; )
+    {
+        struct timespec now;
+        clock.now(now);
+        if ( now.tv_sec >= endTime ) break;
+        long weekSecond = clock.weekSecond(now.tv_sec);
+
+        ControlEngine::Outputs_T outputs;
+        if ( engine.step(weekSecond, ioValues_, outputs) != RESULT_OK )
+        {
+            LOGGING(ERRORS, "ERROR computing relay set points at week second %ld", weekSecond);
+            result = RESULT_ERROR;
+            break;
+        }
+        if ( outputs.relaySetpoints != relaySetpoints || stats.ticks == 0u )
+        {
+            if ( stats.ticks != 0u ) stats.relaySwitches++;
+            relaySetpoints = outputs.relaySetpoints;
+            if ( transitionsFile != nullptr )
+            {
+                fprintf(transitionsFile, "%ld,%ld,%s\n", static_cast<long>(now.tv_sec / SECONDS_PER_WEEK), weekSecond,
+                                                         RelayMask::toString(relaySetpoints).c_str());
+            }
+        }
+        stats.ticks++;
+
+        if ( scheduler.waitNextTick() != RESULT_OK )
+        {
+            LOGMSG(ERRORS, "ERROR waiting for next tick");
+            result = RESULT_ERROR;
+            break;
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    stats.wallSeconds = std::chrono::duration<double>(end - begin).count();
+    stats.weeksPerSecond = ( stats.wallSeconds > 0.0 ) ? weeks / stats.wallSeconds : 0.0;
+    stats.ticksPerSecond = ( stats.wallSeconds > 0.0 ) ? stats.ticks / stats.wallSeconds : 0.0;
+
+    LOGGING(INFO, "replayed %d weeks at %d Hz: %llu ticks, %llu relay switches in %.3f s, %.2f weeks/s",
+                  weeks, stats.tickRateHz, static_cast<unsigned long long>(stats.ticks),
+                  static_cast<unsigned long long>(stats.relaySwitches), stats.wallSeconds, stats.weeksPerSecond);
+
+    return result;
+}
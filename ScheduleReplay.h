@@ -0,0 +1,122 @@
+#ifndef _SCHEDULE_REPLAY_H
+#define _SCHEDULE_REPLAY_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ScheduleReplay.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of ScheduleReplay
+ *
+ *  Replays a week program through the Host Timer control loop on a
+ *  SimulatedClock, to check a weekly program without waiting a week and
+ *  to benchmark the loop in simulated weeks per second.
+ *
+ *  Unlike FleetSimulator, the loop is not allowed to skip to the next
+ *  program transition: a TickScheduler on the simulated clock releases
+ *  every tick of the week (604800 at 1 Hz) and the ControlEngine is stepped
+ *  at each of them, as HostTimer does when guards are configured.
+ *
+ *  Every change of the relay set points can be written to a transitions
+ *  file, one "week,weekSecond,relays" line each, to diff two runs.
+ *  Input/output values are constant, 0.0 unless set with setInputValue().
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdint.h>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "ControlEngine.h"
+#include "ProgramStorage.h"
+#include "SimulatedClock.h"
+#include "TickScheduler.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ScheduleReplay : public Logs, public ControlTypes
+{
+  public:
+
+    struct Stats_T
+    {
+        unsigned int weeks;
+        unsigned int tickRateHz;
+        uint64_t ticks;             // Engine control steps
+        uint64_t relaySwitches;     // Changes of relay set points
+        double wallSeconds;
+        double weeksPerSecond;      // Simulated weeks per second of wall time
+        double ticksPerSecond;
+    };
+
+    /*
+     * Class constructor
+     * @param tickRateHz ticks per simulated second, from MIN_TICK_RATE_HZ to MAX_TICK_RATE_HZ
+     */
+    ScheduleReplay(const char* instanceName, unsigned int tickRateHz = MIN_TICK_RATE_HZ);
+
+    /*
+     * Class destructor
+     */
+    ~ScheduleReplay();
+
+    /**
+     * Reads channels file; without it all relays have no duty cycle (see FleetSimulator)
+     * Type of every channel is checked against its position (see ControlFiles::readChannels)
+     * @param fileName of channels file (format of Program.channels)
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result loadChannels(const char* fileName);
+
+    /**
+     * Reads guards file; without it there are no guards
+     * @param fileName of guards file (format of Program.guards)
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result loadGuards(const char* fileName);
+
+    /**
+     * Sets anti-chatter tunings of guards and minimum on/off times of relays (see FleetSimulator)
+     * @param tunings array of MAX_NUM_GUARDS tunings, or nullptr for none
+     * @param timings array of NUM_OUTPUT_RELAYS timings, or nullptr for none
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result setTunings(const GuardTuning_T* tunings, const RelayTiming_T* timings);
+
+    /**
+     * Maps week program to replay
+     * @param fileName week program in format v1 or v2
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result loadProgram(const char* fileName);
+
+    void setInputValue(uint8_t channelId, float value) { ioValues_[channelId] = value; }
+
+    /**
+     * Replays the program from Monday 00:00:00
+     * @param weeks number of simulated weeks
+     * @param stats statistics of the run
+     * @param transitionsFile file where relay set point changes are written, or nullptr
+     * @return Result RESULT_OK in case all control steps succeeded
+     */
+    Result run(unsigned int weeks, Stats_T & stats, FILE* transitionsFile = nullptr);
+
+  private:
+
+    unsigned int tickRateHz_;
+
+    Channel_T channels_[NUM_HOST_CHANNELS];
+
+    Guard_T guards_[MAX_NUM_GUARDS];
+    GuardTuning_T guardTunings_[MAX_NUM_GUARDS];
+    RelayTiming_T relayTimings_[NUM_OUTPUT_RELAYS];
+
+    ProgramStorage * programStorage_;
+
+    ControlEngine::IoValues_T ioValues_;
+};
+
+#endif // _SCHEDULE_REPLAY_H
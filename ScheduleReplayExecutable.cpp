@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ScheduleReplayExecutable.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ScheduleReplayExecutable to replay week programs in simulated time
+ *
+ *  usage: ScheduleReplay -p <program.prog> [-w <weeks>] [-r <tick rate Hz>]
+ *                        [-c <Program.channels>] [-g <Program.guards>] [-o <transitions.csv>]
+ *                        [-y <hysteresis milli>] [-b <debounce ticks>] [-m <relay minimum on/off seconds>]
+ *
+ *  Hysteresis and debounce apply to all guards, minimum on/off times to all relays,
+ *  as in FleetSimulator. Prints the statistics of the run, simulated weeks per second included,
+ *  and 0 on success or 1 on error as last line.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ScheduleReplay.h"
+#include <stdlib.h>
+#include <string>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "ScheduleReplay.logs";
+
+int main( int argc, const char* argv[] )
+{
+    std::string programFileName, channelsFileName, guardsFileName, transitionsFileName;
+    unsigned int weeks = 1u, tickRateHz = MIN_TICK_RATE_HZ;
+    long hysteresisMilli = 0l, debounce = 0l, minSeconds = 0l;
+
+    for ( int i=1; i + 1 < argc; i += 2 )
+    {
+        std::string param = argv[i];
+        if      ( param == "-p" ) programFileName = argv[i+1];
+        else if ( param == "-w" ) weeks = atoi(argv[i+1]);
+        else if ( param == "-r" ) tickRateHz = atoi(argv[i+1]);
+        else if ( param == "-c" ) channelsFileName = argv[i+1];
+        else if ( param == "-g" ) guardsFileName = argv[i+1];
+        else if ( param == "-o" ) transitionsFileName = argv[i+1];
+        else if ( param == "-y" ) hysteresisMilli = atol(argv[i+1]);
+        else if ( param == "-b" ) debounce = atol(argv[i+1]);
+        else if ( param == "-m" ) minSeconds = atol(argv[i+1]);
+        else
+        {
+            programFileName.clear();
+            break;
+        }
+    }
+    if ( programFileName.empty() || weeks == 0u || argc % 2 == 0 ||
+         hysteresisMilli < 0l || debounce < 0l || debounce > 255l || minSeconds < 0l )
+    {
+        std::cout << "usage: ScheduleReplay -p <program.prog> [-w <weeks>] [-r <tick rate Hz>]" << std::endl;
+        std::cout << "                      [-c <Program.channels>] [-g <Program.guards>] [-o <transitions.csv>]" << std::endl;
+        std::cout << "                      [-y <hysteresis milli>] [-b <debounce ticks>] [-m <relay minimum on/off seconds>]" << std::endl;
+        return 2;
+    }
+
+    ScheduleReplay scheduleReplay("ScheduleReplay", tickRateHz);
+
+    Result result = RESULT_OK;
+    if ( !channelsFileName.empty() && scheduleReplay.loadChannels(channelsFileName.c_str()) != RESULT_OK ) result = RESULT_ERROR;
+    if ( !guardsFileName.empty() && scheduleReplay.loadGuards(guardsFileName.c_str()) != RESULT_OK ) result = RESULT_ERROR;
+
+    ControlTypes::GuardTuning_T tunings[MAX_NUM_GUARDS];
+    for ( ControlTypes::GuardTuning_T & tuning : tunings ) tuning = { hysteresisMilli * 1e-3f, static_cast<uint8_t>(debounce) };
+    ControlTypes::RelayTiming_T timings[NUM_OUTPUT_RELAYS];
+    for ( ControlTypes::RelayTiming_T & timing : timings ) timing = { static_cast<uint32_t>(minSeconds), static_cast<uint32_t>(minSeconds) };
+    if ( result == RESULT_OK && scheduleReplay.setTunings(tunings, timings) != RESULT_OK ) result = RESULT_ERROR;
+    if ( result == RESULT_OK ) result = scheduleReplay.loadProgram(programFileName.c_str());
+
+    FILE* transitionsFile = nullptr;
+    if ( result == RESULT_OK && !transitionsFileName.empty() )
+    {
+        transitionsFile = fopen(transitionsFileName.c_str(), "w");
+        if ( transitionsFile == nullptr )
+        {
+            std::cout << "ERROR opening file " << transitionsFileName << std::endl;
+            result = RESULT_ERROR;
+        }
+    }
+
+    ScheduleReplay::Stats_T stats;
+    if ( result == RESULT_OK )
+    {
+        result = scheduleReplay.run(weeks, stats, transitionsFile);
+
+        std::cout << "simulated weeks: " << stats.weeks << std::endl;
+        std::cout << "tick rate Hz: " << stats.tickRateHz << std::endl;
+        std::cout << "engine ticks: " << stats.ticks << std::endl;
+        std::cout << "relay switches: " << stats.relaySwitches << std::endl;
+        std::cout << "wall seconds: " << stats.wallSeconds << std::endl;
+        std::cout << "simulated weeks/s: " << stats.weeksPerSecond << std::endl;
+        std::cout << "ticks/s: " << stats.ticksPerSecond << std::endl;
+    }
+    if ( transitionsFile != nullptr ) fclose(transitionsFile);
+
+    if ( result == RESULT_OK ) std::cout << "0" << std::endl;
+    else                       std::cout << "1" << std::endl;
+
+    return ( result == RESULT_OK ) ? 0 : 1;
+}
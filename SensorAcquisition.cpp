@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SensorAcquisition.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements SensorAcquisition class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SensorAcquisition.h"
+#include <time.h>
+#include <unistd.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+SensorAcquisition::SensorAcquisition(const char* instanceName, unsigned int sampleRateHz) : Logs(instanceName)
+{
+    logChannels_ = Logger::INFO;
+
+    sampleRateHz_ = sampleRateHz;
+}
+
+SensorAcquisition::~SensorAcquisition()
+{
+    stop();
+}
+
+Result SensorAcquisition::start(const std::vector<uint8_t> & channelIds, const Reader_T & reader, const PassReader_T & passReader)
+{
+    if ( isRunning() )
+    {
+        LOGMSG(ERRORS, "ERROR sensor acquisition already running");
+        return RESULT_ERROR;
+    }
+
+    channelIds_ = channelIds;
+    reader_ = reader;
+    passReader_ = passReader;
+
+    // First samples are taken before the control loop needs them
+    samplePass();
+
+    running_ = true;
+    thread_ = std::thread(&SensorAcquisition::acquisitionLoop, this);
+
+    LOGGING(INFO, "sampling %zu channels at %d Hz", channelIds_.size(), sampleRateHz_);
+
+    return RESULT_OK;
+}
+
+void SensorAcquisition::stop()
+{
+    if ( !isRunning() ) return;
+
+    running_ = false;
+    thread_.join();
+
+    LOGGING(INFO, "stopped after %llu passes, %llu read errors, longest pass %lld us",
+                  static_cast<unsigned long long>(passCount_.load()), static_cast<unsigned long long>(errorCount_.load()),
+                  static_cast<long long>(maxPassNs_.load() / 1000));
+}
+
+unsigned int SensorAcquisition::readLatest(std::map<uint8_t, float> & values, int64_t maxAgeNs) const
+{
+    unsigned int staleChannels = 0u;
+    int64_t timeNs = now();
+
+    for ( uint8_t id : channelIds_ )
+    {
+        Sample_T sample;
+        if ( !snapshots_[id].read(sample) || sample.sampleCount == 0u )
+        {
+            staleChannels++;
+            continue;
+        }
+        values[id] = sample.value;
+        if ( timeNs - sample.timestampNs > maxAgeNs ) staleChannels++;
+    }
+
+    return staleChannels;
+}
+
+int64_t SensorAcquisition::now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return static_cast<int64_t>(time.tv_sec) * 1000000000ll + time.tv_nsec;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SensorAcquisition::acquisitionLoop()
+{
+    TickScheduler scheduler("SensorTickScheduler", sampleRateHz_);
+    if ( scheduler.initialize() != RESULT_OK )
+    {
+        LOGMSG(ERRORS, "ERROR initializing sensor tick scheduler");
+    }
+
+    while ( running_ )
+    {
+        Result result = scheduler.waitNextTick();
+        if ( result == RESULT_ERROR ) usleep(1000000 / sampleRateHz_);
+        if ( !running_ ) break;
+
+        samplePass();
+    }
+
+    scheduler.shutdown();
+}
+
+void SensorAcquisition::samplePass()
+{
+    int64_t begin = now();
+
+    // A failed pass read is left to the channel reads to report
+    if ( passReader_ && passReader_() != RESULT_OK ) errorCount_++;
+
+    for ( uint8_t id : channelIds_ )
+    {
+        float value;
+        if ( reader_(id, value) != RESULT_OK )
+        {
+            // Previous sample is kept; its timestamp tells its age
+            errorCount_++;
+            continue;
+        }
+        Sample_T sample;
+        snapshots_[id].read(sample);
+        sample.value = value;
+        sample.sampleCount++;
+        sample.timestampNs = now();
+        snapshots_[id].write(sample);
+    }
+
+    int64_t passNs = now() - begin;
+    if ( passNs > maxPassNs_.load() ) maxPassNs_ = passNs;
+    passCount_++;
+}
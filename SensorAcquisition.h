@@ -0,0 +1,147 @@
+#ifndef _SENSOR_ACQUISITION_H
+#define _SENSOR_ACQUISITION_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SensorAcquisition.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of SensorAcquisition
+ *
+ *  Samples input/output channels in a dedicated thread, so that a slow
+ *  ADS1115 conversion or NTC read never delays relay actuation, and at a
+ *  rate independent of the control loop (SENSOR_RATE_HZ in HostTimer.consts).
+ *
+ *  Each channel publishes its latest timestamped sample in a SeqlockSnapshot:
+ *  the control loop reads it without blocking and without ever waiting for
+ *  the acquisition thread. A failed read keeps the previous sample, whose
+ *  timestamp shows how old it is.
+ *
+ *  The reader function is only called from the acquisition thread while it
+ *  runs; stop() must be called before the channels it reads are reconfigured.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <thread>
+#include <vector>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+#include "SeqlockSnapshot.h"
+#include "TickScheduler.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SensorAcquisition : public Logs
+{
+  public:
+
+    static const unsigned int MAX_CHANNEL_IDS = 256u;
+
+    struct Sample_T
+    {
+        float value;
+        uint32_t sampleCount;       // Successful reads of channel
+        int64_t timestampNs;        // CLOCK_MONOTONIC time of read
+    };
+
+    /*
+     * Reads value of channel id; called from acquisition thread
+     */
+    typedef std::function<Result(uint8_t channelId, float & value)> Reader_T;
+
+    /*
+     * Called at the beginning of every pass, before the reader, e.g. to read several channels at once
+     */
+    typedef std::function<Result()> PassReader_T;
+
+    /*
+     * Class constructor
+     * @param sampleRateHz passes over all channels per second, from MIN_TICK_RATE_HZ to MAX_TICK_RATE_HZ
+     */
+    SensorAcquisition(const char* instanceName, unsigned int sampleRateHz);
+
+    /*
+     * Class destructor; stops acquisition thread
+     */
+    ~SensorAcquisition();
+
+    /**
+     * Samples all channels once and starts acquisition thread
+     * @param channelIds channels to sample
+     * @param reader function reading one channel
+     * @param passReader function called before the channels of every pass are read, or nullptr
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result start(const std::vector<uint8_t> & channelIds, const Reader_T & reader, const PassReader_T & passReader = nullptr);
+
+    /**
+     * Stops acquisition thread; latest samples stay readable
+     */
+    void stop();
+
+    bool isRunning() const { return thread_.joinable(); }
+
+    /**
+     * Latest sample of channel, without blocking
+     * @param channelId of channel
+     * @param sample latest sample
+     * @return bool false if channel was never sampled
+     */
+    bool readLatest(uint8_t channelId, Sample_T & sample) const { return snapshots_[channelId].read(sample); }
+
+    /**
+     * Latest values of all sampled channels, without blocking
+     * @param values by channel id
+     * @param maxAgeNs age from which a sample is reported as stale
+     * @return unsigned int number of channels never sampled or with stale sample
+     */
+    unsigned int readLatest(std::map<uint8_t, float> & values, int64_t maxAgeNs) const;
+
+    uint64_t getPassCount() const { return passCount_.load(); }
+
+    uint64_t getErrorCount() const { return errorCount_.load(); }
+
+    /*
+     * Longest time to sample all channels in nanoseconds
+     */
+    int64_t getMaxPassNs() const { return maxPassNs_.load(); }
+
+    /*
+     * CLOCK_MONOTONIC time in nanoseconds
+     */
+    static int64_t now();
+
+  private:
+
+    unsigned int sampleRateHz_;
+
+    std::vector<uint8_t> channelIds_;
+
+    Reader_T reader_;
+    PassReader_T passReader_;
+
+    SeqlockSnapshot<Sample_T> snapshots_[MAX_CHANNEL_IDS];
+
+    std::thread thread_;
+    std::atomic<bool> running_ { false };
+
+    std::atomic<uint64_t> passCount_ { 0u };
+    std::atomic<uint64_t> errorCount_ { 0u };
+    std::atomic<int64_t> maxPassNs_ { 0 };
+
+    void acquisitionLoop();
+
+    /**
+     * Samples all channels once
+     */
+    void samplePass();
+};
+
+#endif // _SENSOR_ACQUISITION_H
@@ -0,0 +1,91 @@
+#ifndef _SEQLOCK_SNAPSHOT_H
+#define _SEQLOCK_SNAPSHOT_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SeqlockSnapshot.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of SeqlockSnapshot
+ *
+ *  Latest value of a trivially copyable type shared by one writer thread
+ *  and any number of reader threads without locks:
+ *      - The writer never waits: it makes the sequence odd, stores the
+ *        value and makes the sequence even again.
+ *      - A reader copies the value and retries only if the sequence was
+ *        odd or changed meanwhile, i.e. if it overlapped a write.
+ *  The value is stored in atomic words so that concurrent copies are not
+ *  data races.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// TEMPLATE DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class SeqlockSnapshot
+{
+  public:
+
+    SeqlockSnapshot()
+    {
+        sequence_.store(0u, std::memory_order_relaxed);
+        for ( std::atomic<uint64_t> & word : words_ ) word.store(0u, std::memory_order_relaxed);
+    }
+
+    /**
+     * Publishes value; only one thread may write
+     * @param value to publish
+     */
+    void write(const T & value)
+    {
+        uint64_t buffer[NUM_WORDS] = { 0u };
+        memcpy(buffer, &value, sizeof(T));
+
+        uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1u, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for ( unsigned int i=0; i < NUM_WORDS; i++ ) words_[i].store(buffer[i], std::memory_order_relaxed);
+        sequence_.store(sequence + 2u, std::memory_order_release);
+    }
+
+    /**
+     * Copies latest value
+     * @param value copied
+     * @return bool false if nothing was ever written
+     */
+    bool read(T & value) const
+    {
+        uint64_t buffer[NUM_WORDS];
+        uint32_t before, after;
+        do
+        {
+            before = sequence_.load(std::memory_order_acquire);
+            for ( unsigned int i=0; i < NUM_WORDS; i++ ) buffer[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        }
+        while ( ( before & 1u ) != 0u || before != after );
+
+        memcpy(&value, buffer, sizeof(T));
+        return before != 0u;
+    }
+
+  private:
+
+    static_assert( std::is_trivially_copyable<T>::value, "SeqlockSnapshot type must be trivially copyable" );
+
+    static const unsigned int NUM_WORDS = ( sizeof(T) + sizeof(uint64_t) - 1 ) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> sequence_;
+    std::atomic<uint64_t> words_[NUM_WORDS];
+};
+
+#endif // _SEQLOCK_SNAPSHOT_H
@@ -0,0 +1,242 @@
+#ifndef _SIMULATED_ADS1115_H
+#define _SIMULATED_ADS1115_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SimulatedAds1115.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of SimulatedAds1115
+ *
+ *  Register-level stand-in of an ADS1115 on an II2cBus, so that the
+ *  ADS1115 driver runs without the chip (tests, simulation host):
+ *      - The pointer, config, threshold and conversion registers are kept
+ *        as the chip does; messages to another address are not
+ *        acknowledged (RESULT_ERROR).
+ *      - Conversions run on real time at the configured data rate.
+ *        Writing the config register restarts the conversion, so the
+ *        conversion register holds the previous result until one
+ *        conversion period of the new input has elapsed.
+ *      - Single-shot conversions are started by the OS bit, which reads 0
+ *        while converting.
+ *      - waitReady() returns at the next conversion end not waited for
+ *        yet, as a wait on the latched edges of a GPIO wired to ALERT/RDY
+ *        would, if the thresholds and comparator queue configure the pin
+ *        as conversion ready signal.
+ *  Input voltages are set by the test; codes are clipped to full scale.
+ *  setNoise() adds to every conversion a pseudo-random error uniform in
+ *  +/- the given LSB, the same whenever that conversion is read.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <math.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "LenamDevs_types.h"
+#include "II2cBus.h"
+#include "GpioAnalogRaspberryPi2BAds1115.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SimulatedAds1115 : public II2cBus
+{
+  public:
+
+    /*
+     * Class constructor, with registers at their reset values
+     * @param address 7-bit I2C address the stand-in answers to
+     */
+    SimulatedAds1115(uint8_t address = ADS1115_ADDRESS) : address_(address)
+    {
+        for ( unsigned int i=0; i < 4u; i++ ) inputs_[i] = 0.0f;
+        conversionStart_ = std::chrono::steady_clock::now();
+    }
+
+    Result write(uint8_t address, const uint8_t* data, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if ( address != address_ || size == 0u || data[0] > ADS1115_REG_HI_THRESH || ( size != 1u && size != 3u ) ) return RESULT_ERROR;
+        numWrites_++;
+        pointer_ = data[0];
+        if ( size == 1u ) return RESULT_OK;
+
+        uint16_t value = static_cast<uint16_t>( ( data[1] << 8 ) | data[2] );
+        switch ( pointer_ )
+        {
+        case ADS1115_REG_CONFIG:
+            update();
+            conversion_ = latestConversion();
+            config_ = value & ~ADS1115_CONFIG_OS;
+            if ( ( value & ADS1115_CONFIG_MODE_SINGLE ) == 0u || ( value & ADS1115_CONFIG_OS ) != 0u )
+            {
+                converting_ = true;
+                conversionStart_ = std::chrono::steady_clock::now();
+                readyPulses_ = 0u;
+            }
+            break;
+        case ADS1115_REG_LO_THRESH:
+            loThresh_ = value;
+            break;
+        case ADS1115_REG_HI_THRESH:
+            hiThresh_ = value;
+            break;
+        default:
+            return RESULT_ERROR;
+        }
+
+        return RESULT_OK;
+    }
+
+    Result writeRead(uint8_t address, const uint8_t* writeData, size_t writeSize, uint8_t* readData, size_t readSize)
+    {
+        if ( writeSize != 1u || write(address, writeData, writeSize) != RESULT_OK || readSize != 2u ) return RESULT_ERROR;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        numReads_++;
+        update();
+        uint16_t value = 0u;
+        switch ( pointer_ )
+        {
+        case ADS1115_REG_CONVERSION: value = latestConversion();                                 break;
+        case ADS1115_REG_CONFIG:     value = config_ | ( converting_ ? 0u : ADS1115_CONFIG_OS ); break;
+        case ADS1115_REG_LO_THRESH:  value = loThresh_;                                          break;
+        case ADS1115_REG_HI_THRESH:  value = hiThresh_;                                          break;
+        }
+        readData[0] = static_cast<uint8_t>(value >> 8);
+        readData[1] = static_cast<uint8_t>(value & 0xFFu);
+
+        return RESULT_OK;
+    }
+
+    /**
+     * Waits for a conversion end, as a wait on a GPIO wired to ALERT/RDY with latched edges:
+     * conversion ends not waited for yet since the last config write are returned at once
+     * @param timeoutUs longest wait
+     * @return Result RESULT_OK at conversion end; RESULT_ERROR if the pin does not pulse
+     */
+    Result waitReady(unsigned int timeoutUs)
+    {
+        std::chrono::steady_clock::time_point conversionEnd;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            update();
+            bool readyPin = ( hiThresh_ & 0x8000u ) != 0u && ( loThresh_ & 0x8000u ) == 0u &&
+                            ( config_ & ADS1115_CONFIG_COMP_QUE_DISABLE ) != ADS1115_CONFIG_COMP_QUE_DISABLE;
+            if ( !readyPin || !converting_ ) return RESULT_ERROR;
+            readyPulses_++;
+            conversionEnd = conversionStart_ + conversionPeriod() * readyPulses_;
+        }
+        if ( conversionEnd > std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs) ) return RESULT_ERROR;
+        std::this_thread::sleep_until(conversionEnd);
+
+        return RESULT_OK;
+    }
+
+    /**
+     * Sets voltage of input against GND
+     * @param id of input, 0 to 3
+     * @param volts input voltage
+     */
+    void setInput(unsigned int id, float volts)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        update();
+        if ( id < 4u ) inputs_[id] = volts;
+    }
+
+    /**
+     * Sets noise of conversions
+     * @param lsb maximum error of a conversion in codes, 0 for none
+     */
+    void setNoise(unsigned int lsb) { std::lock_guard<std::mutex> lock(mutex_); noiseLsb_ = lsb; }
+
+    uint16_t getConfig() { std::lock_guard<std::mutex> lock(mutex_); return config_; }
+
+    uint16_t getLoThresh() { std::lock_guard<std::mutex> lock(mutex_); return loThresh_; }
+
+    uint16_t getHiThresh() { std::lock_guard<std::mutex> lock(mutex_); return hiThresh_; }
+
+    /*
+     * Messages acknowledged, writes of register pointer included
+     */
+    uint64_t getNumWrites() { std::lock_guard<std::mutex> lock(mutex_); return numWrites_; }
+
+    uint64_t getNumReads() { std::lock_guard<std::mutex> lock(mutex_); return numReads_; }
+
+  private:
+
+    std::mutex mutex_;
+    uint8_t address_;
+    uint8_t pointer_ = ADS1115_REG_CONVERSION;
+    uint16_t config_ = 0x8583u & ~ADS1115_CONFIG_OS;        // Reset value: single-shot, powered down
+    uint16_t loThresh_ = 0x8000u;
+    uint16_t hiThresh_ = 0x7FFFu;
+    uint16_t conversion_ = 0u;
+    bool converting_ = false;
+    std::chrono::steady_clock::time_point conversionStart_;
+    unsigned long long readyPulses_ = 0u;           // Conversion ends waited for since conversion start
+    float inputs_[4];
+    uint64_t numWrites_ = 0u;
+    uint64_t numReads_ = 0u;
+    unsigned int noiseLsb_ = 0u;
+
+    std::chrono::nanoseconds conversionPeriod() const
+    {
+        static const unsigned int SAMPLES_PER_SECOND[8] = { 8u, 16u, 32u, 64u, 128u, 250u, 475u, 860u };
+
+        return std::chrono::nanoseconds( 1000000000ll / SAMPLES_PER_SECOND[( config_ >> ADS1115_CONFIG_DR_SHIFT ) & 0x7u] );
+    }
+
+    /**
+     * Ends single-shot conversion once its period has elapsed
+     */
+    void update()
+    {
+        if ( !converting_ || ( config_ & ADS1115_CONFIG_MODE_SINGLE ) == 0u ) return;
+        if ( std::chrono::steady_clock::now() - conversionStart_ < conversionPeriod() ) return;
+        conversion_ = codeOfInput(1u);
+        converting_ = false;
+    }
+
+    /**
+     * Conversion register: code of the input once a conversion of it has completed
+     */
+    uint16_t latestConversion() const
+    {
+        if ( !converting_ || std::chrono::steady_clock::now() - conversionStart_ < conversionPeriod() ) return conversion_;
+
+        return codeOfInput( static_cast<uint64_t>( ( std::chrono::steady_clock::now() - conversionStart_ ) / conversionPeriod() ) );
+    }
+
+    /**
+     * Code of input of conversion number since conversion start
+     */
+    uint16_t codeOfInput(uint64_t conversion) const
+    {
+        static const float FULL_SCALE_VOLTS[8] = { 6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f, 0.256f, 0.256f };
+
+        unsigned int mux = ( config_ & ADS1115_CONFIG_MUX_MASK ) >> ADS1115_CONFIG_MUX_SHIFT;
+        if ( mux < ADS1115_MUX_SINGLE_AIN0 ) return 0u;     // Differential inputs are not simulated
+        float code = roundf( inputs_[mux - ADS1115_MUX_SINGLE_AIN0] / FULL_SCALE_VOLTS[( config_ >> ADS1115_CONFIG_PGA_SHIFT ) & 0x7u] * 32768.0f );
+        if ( noiseLsb_ > 0u )
+        {
+            // Hash of conversion start and number (splitmix64)
+            uint64_t hash = static_cast<uint64_t>( conversionStart_.time_since_epoch().count() ) + conversion * 0x9E3779B97F4A7C15ull;
+            hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+            hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBull;
+            hash ^= hash >> 31;
+            code += static_cast<float>( static_cast<int64_t>( hash % ( 2u * noiseLsb_ + 1u ) ) - noiseLsb_ );
+        }
+        if ( code > 32767.0f )  code = 32767.0f;
+        if ( code < -32768.0f ) code = -32768.0f;
+
+        return static_cast<uint16_t>( static_cast<int16_t>(code) );
+    }
+};
+
+#endif // _SIMULATED_ADS1115_H
@@ -0,0 +1,69 @@
+#ifndef _SIMULATED_CLOCK_H
+#define _SIMULATED_CLOCK_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SimulatedClock.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of SimulatedClock
+ *
+ *  IClock on simulated time for schedule regression runs and benchmarks:
+ *  sleepUntil() returns at once after moving the time to the deadline, so
+ *  a TickScheduler on this clock ticks as fast as the CPU allows.
+ *  Simulated second 0 is Monday 00:00:00; there is no time zone.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include "IClock.h"
+#include "ProgramFormat.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SimulatedClock : public IClock
+{
+  public:
+
+    /*
+     * Class constructor
+     * @param startTime simulated second to start at
+     */
+    SimulatedClock(time_t startTime = 0)
+    {
+        time_.tv_sec  = startTime;
+        time_.tv_nsec = 0;
+    }
+
+    void now(struct timespec & time) { time = time_; }
+
+    long weekSecond(time_t time) { return static_cast<long>( time % SECONDS_PER_WEEK ); }
+
+    using IClock::sleepUntil;
+
+    Result sleepUntil(const struct timespec & deadline)
+    {
+        if ( deadline.tv_sec > time_.tv_sec || ( deadline.tv_sec == time_.tv_sec && deadline.tv_nsec > time_.tv_nsec ) ) time_ = deadline;
+
+        return RESULT_OK;
+    }
+
+    /**
+     * Moves simulated time forward, e.g. to model time spent by the loop
+     * @param nanoseconds to add
+     */
+    void advance(long long nanoseconds)
+    {
+        long long nsec = time_.tv_nsec + nanoseconds;
+        time_.tv_sec  += static_cast<time_t>( nsec / 1000000000ll );
+        time_.tv_nsec  = static_cast<long>( nsec % 1000000000ll );
+    }
+
+  private:
+
+    struct timespec time_;
+};
+
+#endif // _SIMULATED_CLOCK_H
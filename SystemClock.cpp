@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SystemClock.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements SystemClock class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SystemClock.h"
+#include <sys/timerfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+SystemClock::SystemClock(const char* instanceName) : Logs(instanceName)
+{
+    logChannels_ = Logger::ERRORS;
+
+    timerFd_ = timerfd_create(CLOCK_REALTIME, TFD_CLOEXEC);
+    if ( timerFd_ < 0 )
+    {
+        LOGGING(ERRORS, "WARNING timerfd_create failed with errno %d, falling back to clock_nanosleep", errno);
+    }
+}
+
+SystemClock::~SystemClock()
+{
+    if ( timerFd_ >= 0 ) close(timerFd_);
+}
+
+void SystemClock::now(struct timespec & time)
+{
+    clock_gettime(CLOCK_REALTIME, &time);
+}
+
+long SystemClock::weekSecond(time_t time)
+{
+    struct tm tmTime;
+    localtime_r(&time, &tmTime);
+
+    return ( ( (tmTime.tm_wday == 0 ? 6 : tmTime.tm_wday - 1)*24 + tmTime.tm_hour )*60 + tmTime.tm_min )*60 + tmTime.tm_sec;
+}
+
+Result SystemClock::sleepUntil(const struct timespec & deadline)
+{
+    if ( timerFd_ >= 0 )
+    {
+        struct itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        spec.it_value = deadline;
+        if ( timerfd_settime(timerFd_, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, NULL) != 0 )
+        {
+            LOGGING(ERRORS, "ERROR arming timerfd with errno %d", errno);
+            return RESULT_ERROR;
+        }
+
+        uint64_t expirations = 0u;
+        while ( read(timerFd_, &expirations, sizeof(expirations)) < 0 )
+        {
+            if ( errno == ECANCELED ) return RESULT_CANCELLED;
+            if ( errno != EINTR )
+            {
+                LOGGING(ERRORS, "ERROR reading timerfd with errno %d", errno);
+                return RESULT_ERROR;
+            }
+        }
+    }
+    else
+    {
+        int error;
+        while ( ( error = clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &deadline, NULL) ) == EINTR );
+        if ( error != 0 )
+        {
+            LOGGING(ERRORS, "ERROR in clock_nanosleep with error %d", error);
+            return RESULT_ERROR;
+        }
+    }
+
+    return RESULT_OK;
+}
+
+Result SystemClock::sleepUntil(const struct timespec & deadline, int eventFd, bool & event)
+{
+    event = false;
+    if ( eventFd < 0 ) return sleepUntil(deadline);
+
+    struct pollfd fds[2];
+    fds[0].fd = eventFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = timerFd_;
+    fds[1].events = POLLIN;
+    if ( timerFd_ >= 0 )
+    {
+        struct itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        spec.it_value = deadline;
+        if ( timerfd_settime(timerFd_, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, NULL) != 0 )
+        {
+            LOGGING(ERRORS, "ERROR arming timerfd with errno %d", errno);
+            return RESULT_ERROR;
+        }
+    }
+
+    while (1)
+    {
+        // Without timerfd, poll with the time left to deadline
+        int timeoutMs = -1;
+        if ( timerFd_ < 0 )
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_REALTIME, &now);
+            long long leftNs = static_cast<long long>(deadline.tv_sec - now.tv_sec) * 1000000000ll + (deadline.tv_nsec - now.tv_nsec);
+            if ( leftNs <= 0 ) return RESULT_OK;
+            timeoutMs = static_cast<int>( ( leftNs + 999999ll ) / 1000000ll );
+        }
+
+        int ready = poll(fds, ( timerFd_ >= 0 ) ? 2 : 1, timeoutMs);
+        if ( ready < 0 )
+        {
+            if ( errno == EINTR ) continue;
+            LOGGING(ERRORS, "ERROR polling timerfd and event fd %d with errno %d", eventFd, errno);
+            return RESULT_ERROR;
+        }
+        // Deadline is checked first, so an event fd that stays readable cannot hide it
+        if ( timerFd_ >= 0 && fds[1].revents != 0 )
+        {
+            uint64_t expirations = 0u;
+            if ( read(timerFd_, &expirations, sizeof(expirations)) < 0 )
+            {
+                if ( errno == ECANCELED ) return RESULT_CANCELLED;
+                if ( errno != EINTR && errno != EAGAIN )
+                {
+                    LOGGING(ERRORS, "ERROR reading timerfd with errno %d", errno);
+                    return RESULT_ERROR;
+                }
+            }
+            else return RESULT_OK;
+        }
+        if ( timerFd_ < 0 )
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_REALTIME, &now);
+            if ( now.tv_sec > deadline.tv_sec || ( now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec ) ) return RESULT_OK;
+        }
+        if ( fds[0].revents != 0 )
+        {
+            // Event fd is left to be read by its owner
+            event = true;
+            return RESULT_OK;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef _SYSTEM_CLOCK_H
+#define _SYSTEM_CLOCK_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SystemClock.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of SystemClock
+ *
+ *  IClock on the real CLOCK_REALTIME and local time zone.
+ *
+ *  Deadlines are armed on a CLOCK_REALTIME timerfd with TFD_TIMER_ABSTIME;
+ *  if the timerfd cannot be created, clock_nanosleep(TIMER_ABSTIME) is used.
+ *  A wall-clock step (NTP, RTC sync) cancels the timerfd. The timerfd can
+ *  be polled together with an event file descriptor (e.g. GPIO edges), so
+ *  that the control loop wakes up on whichever comes first.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include "IClock.h"
+#include "Logs.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SystemClock : public Logs, public IClock
+{
+  public:
+
+    /*
+     * Class constructor
+     */
+    SystemClock(const char* instanceName);
+
+    /*
+     * Class destructor
+     */
+    ~SystemClock();
+
+    void now(struct timespec & time);
+
+    long weekSecond(time_t time);
+
+    Result sleepUntil(const struct timespec & deadline);
+
+    /*
+     * Polls the timerfd together with eventFd
+     */
+    Result sleepUntil(const struct timespec & deadline, int eventFd, bool & event);
+
+  private:
+
+    int timerFd_ = -1;
+};
+
+#endif // _SYSTEM_CLOCK_H
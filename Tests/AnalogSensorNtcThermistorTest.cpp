@@ -4,12 +4,21 @@
  *  @author Manel González Farrera
  *  @date   February 2018 
  *  @brief  Implements AnalogSensorNtcThermistorTest
+ *
+ *  Reads model 25C10KB3470 through the ADS1115 driver on SimulatedAds1115,
+ *  checks the table against the equation from -20 to 100 degC and at the
+ *  ends of the ratio range, the calibration of an input, a Vcc measured
+ *  on its own input, batch conversions against single ones, and times
+ *  table, equation and batch conversions.
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <stdlib.h>
+#include <math.h>
+#include <chrono>
 #include "AnalogSensorNtcThermistor.h"
 #include "GpioAnalogRaspberryPi2BAds1115.h"
+#include "SimulatedAds1115.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -20,9 +29,16 @@ char Logger::logFileName_[] = "AnalogSensorNtcThermistorTest.logs";
 
 int main(int argc, char *argv[]) {
 
+    unsigned int errors = 0;
+
     std::cout << "main creating instance of AnalogSensorNtcThermistor model 25C10KB3470" << std::endl;
 
-    GpioAnalogRaspberryPi2BAds1115 * gpioAnalog = new GpioAnalogRaspberryPi2BAds1115("GpioAnalogRaspberryPi2BAds1115");
+    // ADS1115 stand-in: NTC at 25 degC (R0 = RPU) on input 0, at about 0 degC (27.6 kOhm) on input 1
+    SimulatedAds1115 ads1115;
+    ads1115.setInput(0, 1.65f);
+    ads1115.setInput(1, 3.3f * 27600.0f / ( 27600.0f + 10000.0f ));
+
+    GpioAnalogRaspberryPi2BAds1115 * gpioAnalog = new GpioAnalogRaspberryPi2BAds1115("GpioAnalogRaspberryPi2BAds1115", &ads1115);
     gpioAnalog->initialize();
 
     for ( int id = 0; id < 4; id++)
@@ -53,9 +69,124 @@ int main(int argc, char *argv[]) {
     sprintf(charTemp, "%0.1f", temperatureValue);
     std::cout << "main read value of temperature is channel ID 0 is " << charTemp << " degC" << std::endl;
 
+    if ( result != RESULT_OK || fabsf(temperatureValue - 25.0f) > 0.05f )
+    {
+        std::cout << "ERROR main temperature at 1.65 V is not 25 degC" << std::endl;
+        errors++;
+    }
+
     result =  ntcThermistor.readValue( static_cast<unsigned char>(1), temperatureValue );
     sprintf(charTemp, "%0.1f", temperatureValue);
     std::cout << "main read value of temperature is channel ID 1 is " << charTemp << " degC" << std::endl;
 
-    return 0;
+    // Table within 0.005 degC of the equation in the usual range, clamped at the ends
+    float maxError = 0.0f;
+    for ( unsigned int i=1; i < 100000u; i++ )
+    {
+        float ratio = static_cast<float>(i) / 100000u;
+        float exact = ntcThermistor.evaluate(ratio);
+        if ( exact < -20.0f || exact > 100.0f ) continue;
+        maxError = fmaxf(maxError, fabsf(ntcThermistor.toTemperature(ratio) - exact));
+    }
+    std::cout << "main table of " << AnalogSensorNtcThermistor::TABLE_SEGMENTS << " segments within " << maxError << " degC of equation" << std::endl;
+    if ( maxError > 0.005f || ntcThermistor.toTemperature(-1.0f) != AnalogSensorNtcThermistor::MAX_TEMPERATURE ||
+         ntcThermistor.toTemperature(NAN) != AnalogSensorNtcThermistor::MAX_TEMPERATURE ||
+         ntcThermistor.toTemperature(1.5f) != AnalogSensorNtcThermistor::MIN_TEMPERATURE )
+    {
+        std::cout << "ERROR main table of temperatures" << std::endl;
+        errors++;
+    }
+
+    // Input 0 calibrated by gain 1.01 and offset -0.3 degC; ids out of calibration are rejected
+    if ( ntcThermistor.setCalibration(0, 1.01f, -0.3f) != RESULT_OK || ntcThermistor.setCalibration(AnalogSensorNtcThermistor::MAX_IDS, 1.0f, 0.0f) == RESULT_OK ||
+         ntcThermistor.readValue(static_cast<unsigned char>(0), temperatureValue) != RESULT_OK || fabsf(temperatureValue - 24.95f) > 0.05f )
+    {
+        std::cout << "ERROR main calibrated temperature " << temperatureValue << " instead of 24.95 degC" << std::endl;
+        errors++;
+    }
+    ntcThermistor.setCalibration(0, 1.0f, 0.0f);
+
+    // Supply dropped to 3.0 V measured on input 3: input 0 still reads 25 degC, not with NTC_VCC_VOLTS
+    ads1115.setInput(0, 1.5f);
+    ads1115.setInput(3, 3.0f);
+    ntcThermistor.setVccInput(3);
+    if ( ntcThermistor.readValue(static_cast<unsigned char>(0), temperatureValue) != RESULT_OK || fabsf(temperatureValue - 25.0f) > 0.05f )
+    {
+        std::cout << "ERROR main temperature with Vcc of 3.0 V measured is " << temperatureValue << " instead of 25 degC" << std::endl;
+        errors++;
+    }
+    ads1115.setInput(3, 0.5f);
+    if ( ntcThermistor.readValue(static_cast<unsigned char>(0), temperatureValue) == RESULT_OK )
+    {
+        std::cout << "ERROR main Vcc of 0.5 V accepted" << std::endl;
+        errors++;
+    }
+    ntcThermistor.setVccInput(AnalogSensorNtcThermistor::NO_VCC_INPUT);
+
+    // Table access against equation
+    const unsigned int NUM_CONVERSIONS = 1000000u;
+    float sums[2] = { 0.0f, 0.0f };
+    double nsPerConversion[2];
+    for ( unsigned int method = 0; method < 2u; method++ )
+    {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for ( unsigned int i=0; i < NUM_CONVERSIONS; i++ )
+        {
+            float ratio = 0.15f + 0.6f * ( i & 0xFFFu ) / 4096.0f;
+            sums[method] += ( method == 0u ) ? ntcThermistor.toTemperature(ratio) : ntcThermistor.evaluate(ratio);
+        }
+        nsPerConversion[method] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / NUM_CONVERSIONS;
+    }
+    std::cout << "main table " << nsPerConversion[0] << " ns, equation " << nsPerConversion[1] << " ns per conversion"
+              << " (checksums " << sums[0] << " " << sums[1] << ")" << std::endl;
+
+    // Batch conversions give the temperatures of single ones, at the ends of the range too
+    const unsigned int NUM_RATIOS = 4096u;
+    static float ratios[NUM_RATIOS], temperatures[NUM_RATIOS];
+    for ( unsigned int i=0; i < NUM_RATIOS; i++ ) ratios[i] = -0.1f + 1.2f * i / NUM_RATIOS;
+    ratios[0] = -AnalogSensorNtcThermistor::RATIO_LIMIT / 2.0f;
+    ratios[1] = 1.0f;
+    ratios[2] = AnalogSensorNtcThermistor::RATIO_LIMIT / 2.0f;
+    ntcThermistor.toTemperatures(ratios, temperatures, NUM_RATIOS);
+    unsigned int mismatches = 0u;
+    for ( unsigned int i=0; i < NUM_RATIOS; i++ )
+    {
+        if ( fabsf(temperatures[i] - ntcThermistor.toTemperature(ratios[i])) > 0.001f ) mismatches++;
+    }
+
+    // Reading 4 inputs at once, input 4 is not of the ADS1115
+    ads1115.setInput(0, 1.65f);
+    ads1115.setInput(2, 0.8f);
+    const unsigned char IDS[5] = { 0, 1, 2, 3, 4 };
+    float values[5];
+    if ( ntcThermistor.readValues(IDS, values, 4u) != RESULT_OK ) mismatches++;
+    for ( unsigned char id = 0; id < 4; id++ )
+    {
+        float value = 0.0f;
+        if ( ntcThermistor.readValue(id, value) != RESULT_OK || fabsf(values[id] - value) > 0.001f ) mismatches++;
+    }
+    if ( ntcThermistor.readValues(IDS, values, 5u) == RESULT_OK || !isnan(values[4]) || isnan(values[0]) ) mismatches++;
+    if ( mismatches != 0u )
+    {
+        std::cout << "ERROR main " << mismatches << " batch conversions differ from single ones" << std::endl;
+        errors++;
+    }
+
+    // 16 temperatures at once against one by one
+    const unsigned int NUM_BATCHES = 100000u;
+    float batch[16];
+    float batchSum = 0.0f;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for ( unsigned int i=0; i < NUM_BATCHES; i++ )
+    {
+        ntcThermistor.toTemperatures(&ratios[( i * 16u ) & ( NUM_RATIOS - 1u )], batch, 16u);
+        batchSum += batch[i & 15u];
+    }
+    double nsPerBatch = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / NUM_BATCHES;
+    std::cout << "main 16 temperatures at once " << nsPerBatch << " ns, one by one " << 16.0 * nsPerConversion[0] << " ns"
+              << " (checksum " << batchSum << ")" << std::endl;
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
 }
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ChannelFilterTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ChannelFilterTest
+ *
+ *  Checks the outputs of the moving average, median and IIR filters while
+ *  their windows fill and once full, the invalid configurations, and that
+ *  filtering a noisy input around a guard threshold crosses it fewer times
+ *  than the raw samples do.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include "ChannelFilter.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Times samples cross threshold, each sample above or below it
+ */
+static unsigned int crossings(ChannelFilter & filter, const float* samples, unsigned int numSamples, float threshold)
+{
+    unsigned int count = 0u;
+    bool above = filter.apply(samples[0]) > threshold;
+    for ( unsigned int i=1; i < numSamples; i++ )
+    {
+        bool sampleAbove = filter.apply(samples[i]) > threshold;
+        if ( sampleAbove != above ) count++;
+        above = sampleAbove;
+    }
+
+    return count;
+}
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    // Moving average of 4: mean of the samples there are, then of the last 4
+    ChannelFilter average;
+    average.configure(ChannelFilter::MOVING_AVERAGE, 4u);
+    const float SAMPLES[6] = { 1.0f, 3.0f, 5.0f, 7.0f, 9.0f, 100.0f };
+    const float AVERAGES[6] = { 1.0f, 2.0f, 3.0f, 4.0f, 6.0f, 30.25f };
+    for ( unsigned int i=0; i < 6u; i++ )
+    {
+        float output = average.apply(SAMPLES[i]);
+        if ( fabsf(output - AVERAGES[i]) > 1e-5f )
+        {
+            std::cout << "ERROR main moving average output " << i << " is " << output << " instead of " << AVERAGES[i] << std::endl;
+            errors++;
+        }
+    }
+
+    // Median of 3 drops a spike; median of an even count is mean of the middle samples
+    ChannelFilter median;
+    median.configure(ChannelFilter::MEDIAN, 3u);
+    const float MEDIANS[6] = { 1.0f, 2.0f, 3.0f, 5.0f, 7.0f, 9.0f };
+    for ( unsigned int i=0; i < 6u; i++ )
+    {
+        float output = median.apply(SAMPLES[i]);
+        if ( output != MEDIANS[i] )
+        {
+            std::cout << "ERROR main median output " << i << " is " << output << " instead of " << MEDIANS[i] << std::endl;
+            errors++;
+        }
+    }
+    median.reset();
+    if ( median.apply(50.0f) != 50.0f || median.apply(-1.0f) != 24.5f || median.apply(3.0f) != 3.0f || median.apply(-400.0f) != -1.0f )
+    {
+        std::cout << "ERROR main median after reset" << std::endl;
+        errors++;
+    }
+
+    // IIR of time constant 4 starts at first sample and moves 1/4 of the way
+    ChannelFilter iir;
+    iir.configure(ChannelFilter::IIR, 4u);
+    if ( iir.apply(8.0f) != 8.0f || iir.apply(0.0f) != 6.0f || iir.apply(0.0f) != 4.5f )
+    {
+        std::cout << "ERROR main IIR outputs" << std::endl;
+        errors++;
+    }
+
+    // Invalid configurations leave the filter unchanged
+    ChannelFilter none;
+    if ( none.configure(ChannelFilter::MEDIAN, 0u) || none.configure(ChannelFilter::MEDIAN, ChannelFilter::MAX_LENGTH + 1u) ||
+         none.configure(static_cast<ChannelFilter::Type_T>(4), 2u) || none.getType() != ChannelFilter::NONE || none.apply(3.5f) != 3.5f )
+    {
+        std::cout << "ERROR main invalid configuration accepted" << std::endl;
+        errors++;
+    }
+
+    // Noisy input of +/- 0.2 around a threshold drifting 0.001 per sample
+    const unsigned int NUM_SAMPLES = 1000u;
+    float noisy[NUM_SAMPLES];
+    srand(1);
+    for ( unsigned int i=0; i < NUM_SAMPLES; i++ ) noisy[i] = 0.5f + 0.001f * i + 0.4f * ( rand() / static_cast<float>(RAND_MAX) - 0.5f );
+    unsigned int rawCrossings = crossings(none, noisy, NUM_SAMPLES, 1.0f);
+    for ( ChannelFilter::Type_T type : { ChannelFilter::MOVING_AVERAGE, ChannelFilter::MEDIAN, ChannelFilter::IIR } )
+    {
+        ChannelFilter filter;
+        filter.configure(type, ChannelFilter::MAX_LENGTH);
+        unsigned int filteredCrossings = crossings(filter, noisy, NUM_SAMPLES, 1.0f);
+        std::cout << "main filter " << type << " crosses threshold " << filteredCrossings << " times, raw samples " << rawCrossings << std::endl;
+        if ( filteredCrossings * 4u > rawCrossings )
+        {
+            std::cout << "ERROR main filter " << type << " does not reduce threshold crossings" << std::endl;
+            errors++;
+        }
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ControlEngineTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ControlEngineTest
+ *
+ *  Steps a ControlEngine through duty cycles, a condition, a trigger and a
+ *  manual program time out, and checks the relay set points. Checks the
+ *  compiled guards against a guard by guard evaluation on random guard
+ *  sets, with levels equal to the input values for the == and <= cases,
+ *  and times both per guard set. Checks guard hysteresis, debounce and
+ *  relay minimum on/off times, that steps on input edges do not advance
+ *  debounce, and counts the transitions of a relay guarded by a
+ *  temperature hovering around its level for one day, without and with
+ *  them.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "ControlEngine.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "ControlEngineTest.logs";
+
+/**
+ * Transitions of relay 2 in one day at 1 Hz, condition LOWER_THAN 20.0 on a temperature within 0.8 of it
+ */
+static unsigned int transitionsPerDay(const ControlTypes::Channel_T* channels, const ProgramStorage & storage,
+                                      const ControlTypes::GuardTuning_T* tunings, const ControlTypes::RelayTiming_T* timings)
+{
+    ControlTypes::Guard_T guards[2];
+    guards[0] = { ControlTypes::CONDITION, 2u, 16u, ControlTypes::LOWER_THAN, 20.0f };
+    guards[1].type = ControlTypes::END_OF_GUARDS;
+    ControlEngine engine("ControlEngine");
+    if ( engine.configure(channels, guards) != RESULT_OK || engine.setGuardTunings(tunings) != RESULT_OK ||
+         engine.setProgram(storage.getImage()) != RESULT_OK ) return 0u;
+    engine.setRelayTimings(timings);
+
+    ControlEngine::IoValues_T ioValues;
+    ControlEngine::Outputs_T outputs;
+    unsigned int transitions = 0u;
+    Mask_T relay = 0u;
+    srand(2);
+    for ( long second = 0; second < 24l*60l*60l; second++ )
+    {
+        // Drift of +/- 0.6 degC in about an hour plus +/- 0.2 degC of noise
+        ioValues[16] = 20.0f + 0.6f * sinf(second / 600.0f) + 0.4f * ( rand() / static_cast<float>(RAND_MAX) - 0.5f );
+        engine.step(second, ioValues, outputs);
+        if ( ( outputs.relaySetpoints & RelayMask::bit(2) ) != relay ) transitions++;
+        relay = outputs.relaySetpoints & RelayMask::bit(2);
+    }
+
+    return transitions;
+}
+
+static unsigned int check(const char* name, Mask_T value, Mask_T expected)
+{
+    if ( value == expected ) return 0u;
+    std::cout << "ERROR main " << name << " is " << RelayMask::toString(value) << " expected " << RelayMask::toString(expected) << std::endl;
+    return 1u;
+}
+
+/**
+ * Guard by guard evaluation: a map lookup and a switch on the threshold per guard
+ */
+static void evaluateGuards(const ControlTypes::Guard_T* guards, const ControlEngine::IoValues_T & ioValues, Mask_T & conditionsMask, Mask_T & triggersMask)
+{
+    conditionsMask = RelayMask::ALL;
+    triggersMask = 0u;
+    for ( unsigned int i=0; i < MAX_NUM_GUARDS && guards[i].type != ControlTypes::END_OF_GUARDS; i++ )
+    {
+        ControlEngine::IoValues_T::const_iterator it = ioValues.find(guards[i].guardId);
+        float value = ( it == ioValues.end() ) ? 0.0f : it->second;
+        float level = guards[i].guardLevel;
+        bool holds = false;
+        switch ( guards[i].guardThreshold )
+        {
+            case ControlTypes::MAXIMUM:     holds = ( value <= level ); break;
+            case ControlTypes::MINIMUM:     holds = ( value >= level ); break;
+            case ControlTypes::HIGHER_THAN: holds = ( value >  level ); break;
+            case ControlTypes::LOWER_THAN:  holds = ( value <  level ); break;
+            case ControlTypes::EQUAL_TO:    holds = ( value == level ); break;
+            case ControlTypes::UNEQUAL_TO:  holds = ( value != level ); break;
+        }
+        if ( guards[i].type == ControlTypes::CONDITION && !holds ) conditionsMask &= ~RelayMask::bit(guards[i].channelId);
+        if ( guards[i].type == ControlTypes::TRIGGER && holds ) triggersMask |= RelayMask::bit(guards[i].channelId);
+    }
+}
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    // Program v1: relays 0, 1 and 2 on all week
+    Byte_T program[PROGRAM_V1_SIZE_IN_BYTES];
+    memset(program, 0x07, sizeof(program));
+    FILE* filePtr = fopen("ControlEngineTest.prog", "w");
+    fwrite(program, 1, sizeof(program), filePtr);
+    fclose(filePtr);
+    ProgramStorage storage("ProgramStorage");
+    if ( storage.loadWeekProgram("ControlEngineTest.prog", NUM_OUTPUT_RELAYS) != RESULT_OK )
+    {
+        std::cout << "ERROR main loading program" << std::endl;
+        return 1;
+    }
+
+    // Relay 1 has a 30 s duty cycle
+    ControlTypes::Channel_T channels[NUM_HOST_CHANNELS];
+    memset(channels, 0, sizeof(channels));
+    for ( unsigned int i=0; i < NUM_HOST_CHANNELS; i++ )
+    {
+        channels[i].id = i;
+        channels[i].type = ( i < NUM_OUTPUT_RELAYS ) ? ControlTypes::OUTPUT_RELAY : ControlTypes::INPUT_ANALOG;
+        channels[i].dutyCycle = ( i == 1 ) ? 30u : 60u;
+    }
+
+    // Relay 2 needs channel 16 at most 25.0; relay 3 is triggered by channel 17 higher than 1.0
+    ControlTypes::Guard_T guards[3];
+    guards[0] = { ControlTypes::CONDITION, 2u, 16u, ControlTypes::MAXIMUM, 25.0f };
+    guards[1] = { ControlTypes::TRIGGER, 3u, 17u, ControlTypes::HIGHER_THAN, 1.0f };
+    guards[2].type = ControlTypes::END_OF_GUARDS;
+
+    ControlEngine engine("ControlEngine");
+    if ( engine.configure(channels, guards) != RESULT_OK || engine.setProgram(storage.getImage()) != RESULT_OK )
+    {
+        std::cout << "ERROR main configuring engine" << std::endl;
+        return 1;
+    }
+
+    ControlEngine::IoValues_T ioValues;
+    ControlEngine::Outputs_T outputs;
+    ioValues[16] = 20.0f;
+    ioValues[17] = 0.0f;
+    engine.step(10, ioValues, outputs);
+    errors += check("relays in first half of minute", outputs.relaySetpoints, 0x07);
+    engine.step(40, ioValues, outputs);
+    errors += check("relays after duty cycle", outputs.relaySetpoints, 0x05);
+    ioValues[16] = 30.0f;
+    ioValues[17] = 2.0f;
+    engine.step(70, ioValues, outputs);
+    errors += check("conditions mask", outputs.conditionsMask, RelayMask::ALL & ~RelayMask::bit(2));
+    errors += check("relays with guards", outputs.relaySetpoints, 0x0B);
+    if ( engine.secondsToNextEvent(70) != 0 )
+    {
+        std::cout << "ERROR main engine with guards must be stepped every tick" << std::endl;
+        errors++;
+    }
+
+    // Manual program of relay 4 for 2 minutes
+    engine.setManualProgram(RelayMask::bit(4), 2u);
+    engine.step(120, ioValues, outputs);
+    errors += check("manual program before start", outputs.relaySetpoints, 0x00);
+    engine.startManualProgram();
+    engine.step(125, ioValues, outputs);
+    errors += check("manual program", outputs.relaySetpoints, 0x10);
+    engine.step(245, ioValues, outputs);
+    errors += check("manual program after time out", outputs.relaySetpoints, 0x00);
+
+    // Unknown threshold is rejected at configure, leaving no guards
+    guards[0].guardThreshold = static_cast<ControlTypes::Threshold_T>(6);
+    if ( engine.configure(channels, guards) == RESULT_OK || engine.hasGuards() )
+    {
+        std::cout << "ERROR main guard of unknown threshold accepted" << std::endl;
+        errors++;
+    }
+
+    // Random sets of 16 guards on 6 inputs of values 0 to 3, levels 0 to 3
+    const unsigned int NUM_GUARD_SETS = 1000u;
+    const unsigned int NUM_EVALUATIONS = 1000u;
+    ControlTypes::Guard_T guardSet[MAX_NUM_GUARDS];
+    double nsPerGuardSet[2] = { 0.0, 0.0 };
+    unsigned int checksum = 0u;
+    srand(1);
+    for ( unsigned int set = 0; set < NUM_GUARD_SETS; set++ )
+    {
+        for ( unsigned int i=0; i < MAX_NUM_GUARDS; i++ )
+        {
+            guardSet[i].type = ( rand() & 1 ) ? ControlTypes::CONDITION : ControlTypes::TRIGGER;
+            guardSet[i].channelId = static_cast<uint8_t>( rand() % NUM_OUTPUT_RELAYS );
+            guardSet[i].guardId = static_cast<uint8_t>( NUM_OUTPUT_RELAYS + rand() % 6 );
+            guardSet[i].guardThreshold = static_cast<ControlTypes::Threshold_T>( rand() % 6 );
+            guardSet[i].guardLevel = static_cast<float>( rand() % 4 );
+        }
+        if ( engine.configure(channels, guardSet) != RESULT_OK )
+        {
+            std::cout << "ERROR main configuring guard set " << set << std::endl;
+            errors++;
+            break;
+        }
+        ioValues.clear();
+        for ( unsigned int input = 0; input < 6u; input++ ) ioValues[NUM_OUTPUT_RELAYS + input] = static_cast<float>( rand() % 4 );
+
+        Mask_T masks[2][2];
+        for ( unsigned int method = 0; method < 2u; method++ )
+        {
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            for ( unsigned int i=0; i < NUM_EVALUATIONS; i++ )
+            {
+                if ( method == 0u ) engine.evaluateGuards(ioValues, masks[method][0], masks[method][1]);
+                else evaluateGuards(guardSet, ioValues, masks[method][0], masks[method][1]);
+                checksum += masks[method][0] ^ masks[method][1];
+            }
+            nsPerGuardSet[method] += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        }
+        if ( masks[0][0] != masks[1][0] || masks[0][1] != masks[1][1] )
+        {
+            errors += check("compiled conditions mask", masks[0][0], masks[1][0]);
+            errors += check("compiled triggers mask", masks[0][1], masks[1][1]);
+        }
+    }
+    std::cout << "main 16 guards compiled " << nsPerGuardSet[0] / ( NUM_GUARD_SETS * NUM_EVALUATIONS ) << " ns, guard by guard "
+              << nsPerGuardSet[1] / ( NUM_GUARD_SETS * NUM_EVALUATIONS ) << " ns per guard set (checksum " << checksum << ")" << std::endl;
+
+    // Relay 2 needs channel 16 lower than 20.0 with hysteresis 0.5; relay 3 is triggered by channel 17
+    // higher than 1.0 for 3 steps; relay 2 stays off 120 s once off
+    guards[0] = { ControlTypes::CONDITION, 2u, 16u, ControlTypes::LOWER_THAN, 20.0f };
+    guards[1] = { ControlTypes::TRIGGER, 3u, 17u, ControlTypes::HIGHER_THAN, 1.0f };
+    ControlTypes::GuardTuning_T tunings[MAX_NUM_GUARDS];
+    memset(tunings, 0, sizeof(tunings));
+    tunings[0].hysteresis = -0.5f;
+    ControlTypes::RelayTiming_T timings[NUM_OUTPUT_RELAYS];
+    memset(timings, 0, sizeof(timings));
+    timings[2].minOffSeconds = 120u;
+    ControlEngine tunedEngine("ControlEngine");
+    if ( tunedEngine.configure(channels, guards) != RESULT_OK || tunedEngine.setGuardTunings(tunings) == RESULT_OK )
+    {
+        std::cout << "ERROR main negative hysteresis accepted" << std::endl;
+        errors++;
+    }
+    tunings[0].hysteresis = 0.5f;
+    tunings[1].debounce = 3u;
+    tunedEngine.setGuardTunings(tunings);
+    tunedEngine.setRelayTimings(timings);
+    tunedEngine.setProgram(storage.getImage());
+    const struct { long second; float temperature; float level; Mask_T conditions; Mask_T triggers; Mask_T held; } STEPS[] =
+    {
+        { 200, 19.0f, 0.0f, RelayMask::ALL,                   0u,                0u               },
+        { 201, 20.1f, 2.0f, RelayMask::ALL & ~RelayMask::bit(2), 0u,             0u               },
+        { 202, 19.8f, 2.0f, RelayMask::ALL & ~RelayMask::bit(2), 0u,             0u               },
+        { 203, 19.4f, 2.0f, RelayMask::ALL,                   RelayMask::bit(3), RelayMask::bit(2) },
+        { 321, 19.4f, 2.0f, RelayMask::ALL,                   RelayMask::bit(3), 0u               },
+    };
+    for ( unsigned int i=0; i < sizeof(STEPS) / sizeof(STEPS[0]); i++ )
+    {
+        ioValues[16] = STEPS[i].temperature;
+        ioValues[17] = STEPS[i].level;
+        tunedEngine.step(STEPS[i].second, ioValues, outputs);
+        std::string step = "tuned step at " + std::to_string(STEPS[i].second) + " s ";
+        errors += check(( step + "conditions mask" ).c_str(), outputs.conditionsMask, STEPS[i].conditions);
+        errors += check(( step + "triggers mask" ).c_str(), outputs.triggersMask, STEPS[i].triggers);
+        errors += check(( step + "held relays" ).c_str(), outputs.heldRelays, STEPS[i].held);
+        errors += check(( step + "relay 2" ).c_str(), outputs.relaySetpoints & RelayMask::bit(2), ( STEPS[i].held == 0u ) ? STEPS[i].conditions & RelayMask::bit(2) : 0u);
+    }
+
+    // Steps on edges of a bouncing input do not advance debounce: the trigger ends on the third tick
+    for ( unsigned int i=0; i < 10u; i++ )
+    {
+        ioValues[17] = ( i % 2u == 0u ) ? 0.0f : 2.0f;
+        tunedEngine.step(322, ioValues, outputs, false);
+    }
+    errors += check("tuned step on edges triggers mask", outputs.triggersMask, RelayMask::bit(3));
+    ioValues[17] = 0.0f;
+    tunedEngine.step(322, ioValues, outputs, false);
+    for ( long second = 323; second < 325; second++ )
+    {
+        tunedEngine.step(second, ioValues, outputs);
+        errors += check("tuned tick after edges triggers mask", outputs.triggersMask, RelayMask::bit(3));
+    }
+    tunedEngine.step(325, ioValues, outputs);
+    errors += check("tuned third tick after edges triggers mask", outputs.triggersMask, 0u);
+
+    // Relay transitions per day of a temperature hovering around the level of a condition
+    unsigned int before = transitionsPerDay(channels, storage, nullptr, nullptr);
+    memset(tunings, 0, sizeof(tunings));
+    tunings[0].hysteresis = 0.5f;
+    tunings[0].debounce = 5u;
+    for ( unsigned int i=0; i < NUM_OUTPUT_RELAYS; i++ ) timings[i] = { 300u, 300u };
+    unsigned int after = transitionsPerDay(channels, storage, tunings, timings);
+    std::cout << "main relay transitions per day: " << before << " without hysteresis, debounce and minimum on/off times, "
+              << after << " with them" << std::endl;
+    if ( after == 0u || after * 20u > before )
+    {
+        std::cout << "ERROR main relay transitions per day not cut" << std::endl;
+        errors++;
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioAnalogFrontEndTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioAnalogFrontEndTest
+ *
+ *  Runs GpioAnalogFrontEnd on 4 SimulatedAds1115 sharing one bus stand-in:
+ *  checks the 16 input ids, samples of a partial mask, inputs converted on
+ *  their own, a missing chip, noise of an oversampled input, and the
+ *  samples per second of 1, 2 and 4 chips with and without ALERT/RDY,
+ *  which must grow with the chips.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <iostream>
+#include "GpioAnalogFrontEnd.h"
+#include "SimulatedAds1115.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "GpioAnalogFrontEndTest.logs";
+
+/*
+ * Bus of several stand-ins: a message goes to the one acknowledging its address
+ */
+class SimulatedBus : public II2cBus
+{
+  public:
+
+    SimulatedBus(SimulatedAds1115* devices, unsigned int numDevices) : devices_(devices), numDevices_(numDevices) {}
+
+    Result write(uint8_t address, const uint8_t* data, size_t size)
+    {
+        for ( unsigned int i=0; i < numDevices_; i++ )
+        {
+            if ( devices_[i].write(address, data, size) == RESULT_OK ) return RESULT_OK;
+        }
+        return RESULT_ERROR;
+    }
+
+    Result writeRead(uint8_t address, const uint8_t* writeData, size_t writeSize, uint8_t* readData, size_t readSize)
+    {
+        for ( unsigned int i=0; i < numDevices_; i++ )
+        {
+            if ( devices_[i].writeRead(address, writeData, writeSize, readData, readSize) == RESULT_OK ) return RESULT_OK;
+        }
+        return RESULT_ERROR;
+    }
+
+  private:
+
+    SimulatedAds1115* devices_;
+    unsigned int numDevices_;
+};
+
+static float inputVolts(unsigned int id) { return 0.1f + 0.2f * id; }
+
+/**
+ * Samples all inputs of numChips chips at 860 SPS
+ * @return double samples per second, 0 on error
+ */
+static double samplesPerSecond(SimulatedBus & bus, SimulatedAds1115* ads1115, unsigned char numChips, bool readyWait)
+{
+    GpioAnalogFrontEnd frontEnd("GpioAnalogFrontEnd", &bus, numChips, GpioAnalogRaspberryPi2BAds1115::PGA_4_096V, GpioAnalogRaspberryPi2BAds1115::DR_860_SPS);
+    for ( unsigned char chip = 0; chip < numChips && readyWait; chip++ )
+    {
+        SimulatedAds1115* device = &ads1115[chip];
+        frontEnd.setReadyWait(chip, [device] (unsigned int timeoutUs) { return device->waitReady(timeoutUs); });
+    }
+    if ( frontEnd.initialize() != RESULT_OK ) return 0.0;
+
+    const unsigned int NUM_PASSES = 20u;
+    GpioAnalogFrontEnd::InputMask_T mask = static_cast<GpioAnalogFrontEnd::InputMask_T>( ( 1u << frontEnd.getNumInputs() ) - 1u );
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for ( unsigned int pass = 0; pass < NUM_PASSES; pass++ )
+    {
+        if ( frontEnd.sampleInputs(mask) != RESULT_OK ) return 0.0;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    for ( unsigned char id = 0; id < frontEnd.getNumInputs(); id++ )
+    {
+        float voltage = 0.0f;
+        if ( frontEnd.getVoltage(id, voltage) != RESULT_OK || fabsf(voltage - inputVolts(id)) > 0.00025f ) return 0.0;
+    }
+
+    return frontEnd.getSampleCount() / seconds;
+}
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    SimulatedAds1115 ads1115[4] = { { 0x48u }, { 0x49u }, { 0x4Au }, { 0x4Bu } };
+    for ( unsigned int id = 0; id < 16u; id++ ) ads1115[id / 4u].setInput(id % 4u, inputVolts(id));
+    SimulatedBus bus(ads1115, 4u);
+
+    GpioAnalogFrontEnd frontEnd("GpioAnalogFrontEnd", &bus, 4u, GpioAnalogRaspberryPi2BAds1115::PGA_4_096V, GpioAnalogRaspberryPi2BAds1115::DR_860_SPS);
+    if ( frontEnd.initialize() != RESULT_OK || frontEnd.getNumInputs() != 16u )
+    {
+        std::cout << "ERROR main initializing front end of 4 ADS1115" << std::endl;
+        return 1;
+    }
+
+    // Inputs 1 of chip 0 and 2 and 3 of chip 3 sampled at once
+    if ( frontEnd.sampleInputs(0xC002u) != RESULT_OK )
+    {
+        std::cout << "ERROR main sampling inputs of mask 0xC002" << std::endl;
+        errors++;
+    }
+    ads1115[0].setInput(1, 3.0f);
+    float voltage = 0.0f;
+    if ( frontEnd.getVoltage(1, voltage) != RESULT_OK || fabsf(voltage - inputVolts(1)) > 0.00025f ||
+         frontEnd.getVoltage(15, voltage) != RESULT_OK || fabsf(voltage - inputVolts(15)) > 0.00025f )
+    {
+        std::cout << "ERROR main sampled voltage " << voltage << std::endl;
+        errors++;
+    }
+
+    // Input 9 not sampled is converted on its own; sampling again drops old samples
+    if ( frontEnd.getVoltage(9, voltage) != RESULT_OK || fabsf(voltage - inputVolts(9)) > 0.00025f ||
+         frontEnd.sampleInputs(0x0002u) != RESULT_OK || frontEnd.getVoltage(1, voltage) != RESULT_OK || fabsf(voltage - 3.0f) > 0.00025f )
+    {
+        std::cout << "ERROR main voltage of input not sampled " << voltage << std::endl;
+        errors++;
+    }
+    ads1115[0].setInput(1, inputVolts(1));
+    if ( frontEnd.getVoltage(16, voltage) == RESULT_OK )
+    {
+        std::cout << "ERROR main input 16 out of range accepted" << std::endl;
+        errors++;
+    }
+
+    // Chip 3 is missing; inputs of chip 1 are out of a front end of one chip
+    SimulatedBus threeChipBus(ads1115, 3u);
+    GpioAnalogFrontEnd missingChip("GpioAnalogFrontEnd", &threeChipBus, 4u);
+    if ( missingChip.initialize() == RESULT_OK )
+    {
+        std::cout << "ERROR main front end initialized without chip 3" << std::endl;
+        errors++;
+    }
+    GpioAnalogFrontEnd oneChip("GpioAnalogFrontEnd", &bus, 1u);
+    if ( oneChip.initialize() != RESULT_OK || oneChip.sampleInputs(0x0010u) == RESULT_OK )
+    {
+        std::cout << "ERROR main input 4 of front end of one chip accepted" << std::endl;
+        errors++;
+    }
+
+    // Oversampling 16 averages out noise of +/- 8 LSB of input 5, not of input 4
+    ads1115[1].setNoise(8u);
+    if ( frontEnd.setOversampling(5, 16u) != RESULT_OK || frontEnd.setOversampling(5, 17u) == RESULT_OK )
+    {
+        std::cout << "ERROR main setting oversampling of input 5" << std::endl;
+        errors++;
+    }
+    double squaredErrors[2] = { 0.0, 0.0 };
+    uint64_t sampleCount = frontEnd.getSampleCount();
+    for ( unsigned int pass = 0; pass < 20u; pass++ )
+    {
+        if ( frontEnd.sampleInputs(0x0030u) != RESULT_OK ) errors++;
+        for ( unsigned char id = 4; id < 6; id++ )
+        {
+            frontEnd.getVoltage(id, voltage);
+            squaredErrors[id - 4] += ( voltage - inputVolts(id) ) * ( voltage - inputVolts(id) );
+        }
+    }
+    std::cout << "main rms noise of input 4: " << sqrt(squaredErrors[0] / 20) * 1e6 << " uV, oversampled input 5: "
+              << sqrt(squaredErrors[1] / 20) * 1e6 << " uV" << std::endl;
+    if ( squaredErrors[1] * 4.0 > squaredErrors[0] || frontEnd.getSampleCount() != sampleCount + 20u * 17u )
+    {
+        std::cout << "ERROR main oversampling does not reduce noise" << std::endl;
+        errors++;
+    }
+    ads1115[1].setNoise(0u);
+    frontEnd.setOversampling(5, 1u);
+
+    // Aggregate samples per second scale with the number of chips
+    for ( bool readyWait : { false, true } )
+    {
+        double rates[3];
+        const unsigned char NUM_CHIPS[3] = { 1, 2, 4 };
+        for ( unsigned int i=0; i < 3u; i++ )
+        {
+            rates[i] = samplesPerSecond(bus, ads1115, NUM_CHIPS[i], readyWait);
+            std::cout << "main " << static_cast<unsigned int>(NUM_CHIPS[i]) << " chips at 860 SPS " << ( readyWait ? "with ALERT/RDY: " : "sleeping: " )
+                      << rates[i] << " samples/s" << std::endl;
+        }
+        if ( rates[0] <= 0.0 || rates[1] < 1.7 * rates[0] || rates[2] < 3.2 * rates[0] )
+        {
+            std::cout << "ERROR main samples per second do not scale with the number of chips" << std::endl;
+            errors++;
+        }
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioAnalogRaspberryPi2BAds1115Test.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioAnalogRaspberryPi2BAds1115Test
+ *
+ *  Runs the ADS1115 driver on SimulatedAds1115: checks the ALERT/RDY
+ *  thresholds and continuous mode written, voltages of the 4 inputs read
+ *  with and without ready signal, that the input being converted is read
+ *  with one message, the PGA full scale, a device not acknowledging, and
+ *  the time taken to sequence the 4 inputs.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <iostream>
+#include "GpioAnalogRaspberryPi2BAds1115.h"
+#include "SimulatedAds1115.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "GpioAnalogRaspberryPi2BAds1115Test.logs";
+
+static const float INPUT_VOLTS[4] = { 0.5f, 1.0f, 2.0f, 3.3f };
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    SimulatedAds1115 ads1115;
+    for ( unsigned int i=0; i < 4u; i++ ) ads1115.setInput(i, INPUT_VOLTS[i]);
+
+    // Continuous conversion at 860 SPS, waiting on ALERT/RDY
+    GpioAnalogRaspberryPi2BAds1115 gpioAnalog("GpioAnalogRaspberryPi2BAds1115", &ads1115, ADS1115_ADDRESS,
+                                              GpioAnalogRaspberryPi2BAds1115::PGA_4_096V, GpioAnalogRaspberryPi2BAds1115::DR_860_SPS);
+    gpioAnalog.setReadyWait([&ads1115] (unsigned int timeoutUs) { return ads1115.waitReady(timeoutUs); });
+    if ( gpioAnalog.initialize() != RESULT_OK )
+    {
+        std::cout << "ERROR main initializing ADS1115 driver" << std::endl;
+        return 1;
+    }
+    if ( ads1115.getHiThresh() != ADS1115_RDY_HI_THRESH || ads1115.getLoThresh() != ADS1115_RDY_LO_THRESH ||
+         ( ads1115.getConfig() & ADS1115_CONFIG_MODE_SINGLE ) != 0u || ( ads1115.getConfig() & ADS1115_CONFIG_COMP_QUE_DISABLE ) == ADS1115_CONFIG_COMP_QUE_DISABLE )
+    {
+        std::cout << "ERROR main ADS1115 not in continuous mode with ALERT/RDY, config 0x" << std::hex << ads1115.getConfig() << std::dec << std::endl;
+        errors++;
+    }
+
+    // Inputs sequenced by the multiplexer, within 2 LSB of 125 uV
+    float voltages[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    if ( gpioAnalog.getVoltages(voltages) != RESULT_OK )
+    {
+        std::cout << "ERROR main getting voltages" << std::endl;
+        errors++;
+    }
+    for ( unsigned int i=0; i < 4u; i++ )
+    {
+        if ( fabsf(voltages[i] - INPUT_VOLTS[i]) > 0.00025f )
+        {
+            std::cout << "ERROR main voltage of input " << i << " is " << voltages[i] << " instead of " << INPUT_VOLTS[i] << std::endl;
+            errors++;
+        }
+    }
+
+    // Input being converted: one combined message, no multiplexer switch
+    float voltage = 0.0f;
+    uint64_t numWrites = ads1115.getNumWrites();
+    if ( gpioAnalog.getVoltage(3, voltage) != RESULT_OK || fabsf(voltage - INPUT_VOLTS[3]) > 0.00025f || ads1115.getNumWrites() != numWrites + 1u )
+    {
+        std::cout << "ERROR main reading input being converted took " << ads1115.getNumWrites() - numWrites << " messages" << std::endl;
+        errors++;
+    }
+
+    // Switch to an input right after its change: result is of the new voltage
+    ads1115.setInput(1, 1.5f);
+    int16_t code = 0;
+    if ( gpioAnalog.getCode(1, code) != RESULT_OK || abs(code - 12000) > 2 )
+    {
+        std::cout << "ERROR main code of input 1 is " << code << " instead of 12000" << std::endl;
+        errors++;
+    }
+    if ( gpioAnalog.getCode(4, code) == RESULT_OK )
+    {
+        std::cout << "ERROR main input 4 out of range accepted" << std::endl;
+        errors++;
+    }
+
+    // Sequencing the 4 inputs takes 2 conversions per input
+    const unsigned int NUM_PASSES = 20u;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for ( unsigned int pass = 0; pass < NUM_PASSES; pass++ ) gpioAnalog.getVoltages(voltages);
+    double passMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / NUM_PASSES;
+    std::cout << "main 4 inputs at 860 SPS with ALERT/RDY in " << passMs << " ms" << std::endl;
+    if ( passMs > 4 * 2 * 1.2 * 1000.0 / 860 + 1.0 )
+    {
+        std::cout << "ERROR main sequencing 4 inputs slower than 2 conversions per input" << std::endl;
+        errors++;
+    }
+
+    // Without ALERT/RDY the conversion time is slept; PGA 2.048 V clips input 3
+    GpioAnalogRaspberryPi2BAds1115 gpioAnalogSleeping("GpioAnalogRaspberryPi2BAds1115", &ads1115, ADS1115_ADDRESS,
+                                                      GpioAnalogRaspberryPi2BAds1115::PGA_2_048V, GpioAnalogRaspberryPi2BAds1115::DR_475_SPS);
+    if ( gpioAnalogSleeping.initialize() != RESULT_OK || gpioAnalogSleeping.getVoltages(voltages) != RESULT_OK ||
+         fabsf(voltages[0] - INPUT_VOLTS[0]) > 0.000125f || fabsf(voltages[3] - 2.048f) > 0.000125f )
+    {
+        std::cout << "ERROR main voltages at full scale 2.048 V are " << voltages[0] << " and " << voltages[3] << std::endl;
+        errors++;
+    }
+    begin = std::chrono::steady_clock::now();
+    for ( unsigned int pass = 0; pass < NUM_PASSES; pass++ ) gpioAnalogSleeping.getVoltages(voltages);
+    passMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / NUM_PASSES;
+    std::cout << "main 4 inputs at 475 SPS sleeping in " << passMs << " ms" << std::endl;
+
+    // No ADS1115 at address 0x49
+    GpioAnalogRaspberryPi2BAds1115 gpioAnalogMissing("GpioAnalogRaspberryPi2BAds1115", &ads1115, 0x49u);
+    if ( gpioAnalogMissing.initialize() == RESULT_OK )
+    {
+        std::cout << "ERROR main ADS1115 at address 0x49 initialized" << std::endl;
+        errors++;
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioMemRaspberryPi2BTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioMemRaspberryPi2BTest
+ *
+ *  Runs GpioMemRaspberryPi2B on a plain file standing in for /dev/gpiomem,
+ *  mapped as well by the test, which plays the hardware: checks function
+ *  select bits, the GPSET0/GPCLR0 stores of setLevels(), levels got from
+ *  GPLEV0, inverted modes and the time taken by setLevels() and getLevels().
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <chrono>
+#include <iostream>
+#include "GpioMemRaspberryPi2B.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "GpioMemRaspberryPi2BTest.logs";
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    // Register block stand-in in a tmpfs file
+    char memName[] = "/dev/shm/GpioMemRaspberryPi2BTest.XXXXXX";
+    char fallbackMemName[] = "/tmp/GpioMemRaspberryPi2BTest.XXXXXX";
+    const char* name = memName;
+    int memFd = mkstemp(memName);
+    if ( memFd < 0 )
+    {
+        name = fallbackMemName;
+        memFd = mkstemp(fallbackMemName);
+    }
+    if ( memFd < 0 || ftruncate(memFd, GPIO_MEM_BLOCK_SIZE) != 0 )
+    {
+        std::cout << "ERROR main creating GPIO memory stand-in" << std::endl;
+        return 1;
+    }
+    volatile uint32_t * registers = static_cast<volatile uint32_t *>(mmap(NULL, GPIO_MEM_BLOCK_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0));
+    close(memFd);
+    if ( registers == MAP_FAILED )
+    {
+        std::cout << "ERROR main mapping GPIO memory stand-in" << std::endl;
+        return 1;
+    }
+    volatile uint32_t & gpfsel1 = registers[( GPIO_REG_GPFSEL0 + 4u ) / 4u];
+    volatile uint32_t & gpset0  = registers[GPIO_REG_GPSET0 / 4u];
+    volatile uint32_t & gpclr0  = registers[GPIO_REG_GPCLR0 / 4u];
+    volatile uint32_t & gplev0  = registers[GPIO_REG_GPLEV0 / 4u];
+
+    GpioMemRaspberryPi2B gpio("GpioMemRaspberryPi2B", name);
+    if ( gpio.initialize() != RESULT_OK )
+    {
+        std::cout << "ERROR main initializing GPIO on " << name << std::endl;
+        return 1;
+    }
+
+    // Relay 0 (GPIO 17) output, digital input 8 (GPIO 12) input: function select bits in GPFSEL1
+    gpfsel1 = 0xFFFFFFFFu;
+    if ( gpio.setMode(0, IGpio::OUTPUT_DIGITAL) != RESULT_OK || gpio.setMode(8, IGpio::INPUT_DIGITAL) != RESULT_OK )
+    {
+        std::cout << "ERROR main setting GPIO modes" << std::endl;
+        errors++;
+    }
+    if ( ( ( gpfsel1 >> 21 ) & 7u ) != 1u || ( ( gpfsel1 >> 6 ) & 7u ) != 0u || gpclr0 != ( 1u << 17 ) )
+    {
+        std::cout << "ERROR main GPFSEL1 0x" << std::hex << gpfsel1 << " GPCLR0 0x" << gpclr0 << std::dec << std::endl;
+        errors++;
+    }
+
+    // Relays 0 and 2 high, 1 and 3-7 low: one store to each of GPSET0 and GPCLR0
+    const uint32_t RELAY_PINS = (1u << 17) | (1u << 27) | (1u << 22) | (1u << 10) | (1u << 25) | (1u << 9) | (1u << 8) | (1u << 11);
+    gplev0 = (1u << 17) | (1u << 22);
+    if ( gpio.setLevels(0x00FFu, 0x0005u) != RESULT_OK || gpset0 != ( (1u << 17) | (1u << 22) ) || gpclr0 != ( RELAY_PINS & ~gpset0 ) )
+    {
+        std::cout << "ERROR main setLevels: GPSET0 0x" << std::hex << gpset0 << " GPCLR0 0x" << gpclr0 << std::dec << std::endl;
+        errors++;
+    }
+
+    // Verification fails if GPLEV0 does not follow
+    gplev0 = 0u;
+    if ( gpio.setLevels(0x00FFu, 0x0005u) == RESULT_OK )
+    {
+        std::cout << "ERROR main setLevels not verified in GPLEV0" << std::endl;
+        errors++;
+    }
+
+    // Inputs 8 (GPIO 12) and 15 (GPIO 21) high, input 9 (GPIO 6) inverted and low
+    gpio.setMode(9, IGpio::INPUT_DIGITAL_INVERTED);
+    gplev0 = (1u << 12) | (1u << 21);
+    IGpioBulk::GpioMask_T levels;
+    signed int level;
+    if ( gpio.getLevels(0xFF00u, levels) != RESULT_OK || levels != 0x8300u || gpio.getLevel(9, level) != RESULT_OK || level != 1 )
+    {
+        std::cout << "ERROR main getLevels 0x" << std::hex << levels << ", expected 0x8300" << std::dec << std::endl;
+        errors++;
+    }
+
+    // A tick of all relays costs two stores and one load, no system call
+    const unsigned int NUM_TICKS = 1000000u;
+    gplev0 = (1u << 17) | (1u << 22);
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for ( unsigned int tick = 0; tick < NUM_TICKS; tick++ ) gpio.setLevels(0x00FFu, 0x0005u);
+    double setLevelsNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / NUM_TICKS;
+    begin = std::chrono::steady_clock::now();
+    for ( unsigned int tick = 0; tick < NUM_TICKS; tick++ ) gpio.getLevels(0xFF00u, levels);
+    double getLevelsNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / NUM_TICKS;
+    std::cout << "main setLevels " << setLevelsNs << " ns, getLevels " << getLevelsNs << " ns" << std::endl;
+    if ( setLevelsNs > 10000.0 || getLevelsNs > 10000.0 )
+    {
+        std::cout << "ERROR main register access slower than 10 us" << std::endl;
+        errors++;
+    }
+
+    gpio.shutdown();
+    munmap(const_cast<uint32_t *>(registers), GPIO_MEM_BLOCK_SIZE);
+    unlink(name);
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   GpioRaspberryPi2BTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements GpioRaspberryPi2BTest
+ *
+ *  Runs GpioRaspberryPi2B against a fake sysfs GPIO tree in a tmpfs
+ *  directory: checks modes and levels written to the attribute files,
+ *  levels read back, bulk levels by mask, reset of edges, the time
+ *  taken by setLevel() and getLevel() and the wait for exported GPIO's.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "GpioRaspberryPi2B.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "GpioRaspberryPi2BTest.logs";
+
+static const uint8_t GPIO_NUMBERS[] = { 17, 27, 22, 10, 25, 9, 8, 11, 12, 6, 13, 16, 19, 20, 26, 21 };
+
+static void writeFile(const std::string & fileName, const char* content)
+{
+    FILE* filePtr = fopen(fileName.c_str(), "w");
+    fputs(content, filePtr);
+    fclose(filePtr);
+}
+
+static std::string readFile(const std::string & fileName)
+{
+    char buffer[16] = { 0 };
+    FILE* filePtr = fopen(fileName.c_str(), "r");
+    if ( filePtr == NULL ) return "";
+    if ( fgets(buffer, sizeof(buffer), filePtr) == NULL ) buffer[0] = '\0';
+    fclose(filePtr);
+    buffer[strcspn(buffer, "\n")] = '\0';
+    return buffer;
+}
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    // Fake sysfs tree as exported by the kernel
+    char rootName[] = "/dev/shm/GpioRaspberryPi2BTest.XXXXXX";
+    char fallbackRootName[] = "/tmp/GpioRaspberryPi2BTest.XXXXXX";
+    const char* root = mkdtemp(rootName);
+    if ( root == NULL ) root = mkdtemp(fallbackRootName);
+    if ( root == NULL )
+    {
+        std::cout << "ERROR main creating fake sysfs directory" << std::endl;
+        return 1;
+    }
+    std::string sysfsRoot = root;
+    writeFile(sysfsRoot + "/export", "");
+    for ( uint8_t number : GPIO_NUMBERS )
+    {
+        std::string gpioDir = sysfsRoot + "/gpio" + std::to_string(number);
+        mkdir(gpioDir.c_str(), 0755);
+        writeFile(gpioDir + "/value", "0\n");
+        writeFile(gpioDir + "/direction", "in\n");
+        writeFile(gpioDir + "/active_low", "0\n");
+        writeFile(gpioDir + "/edge", "both\n");
+    }
+
+    GpioRaspberryPi2B gpio("GpioRaspberryPi2B", sysfsRoot.c_str());
+    if ( gpio.initialize() != RESULT_OK )
+    {
+        std::cout << "ERROR main initializing GPIO on fake sysfs " << sysfsRoot << std::endl;
+        return 1;
+    }
+
+    // Edges left by a previous run are reset
+    if ( readFile(sysfsRoot + "/gpio17/edge") != "none" || readFile(sysfsRoot + "/gpio21/edge") != "none" )
+    {
+        std::cout << "ERROR main edges not reset by initialize" << std::endl;
+        errors++;
+    }
+
+    // Relay 0 output, relay 1 inverted output, digital input 8 inverted input
+    std::string gpio17 = sysfsRoot + "/gpio17", gpio27 = sysfsRoot + "/gpio27", gpio12 = sysfsRoot + "/gpio12";
+    if ( gpio.setMode(0, IGpio::OUTPUT_DIGITAL) != RESULT_OK || gpio.setMode(1, IGpio::OUTPUT_DIGITAL_INVERTED) != RESULT_OK ||
+         gpio.setMode(8, IGpio::INPUT_DIGITAL_INVERTED) != RESULT_OK )
+    {
+        std::cout << "ERROR main setting GPIO modes" << std::endl;
+        errors++;
+    }
+    if ( readFile(gpio17 + "/direction") != "out" || readFile(gpio17 + "/active_low") != "0" ||
+         readFile(gpio27 + "/direction") != "out" || readFile(gpio27 + "/active_low") != "1" ||
+         readFile(gpio12 + "/direction") != "in"  || readFile(gpio12 + "/active_low") != "1" )
+    {
+        std::cout << "ERROR main GPIO modes in fake sysfs" << std::endl;
+        errors++;
+    }
+
+    // Levels written and read through the kept file descriptors
+    if ( gpio.setLevel(0, 1) != RESULT_OK || readFile(gpio17 + "/value") != "1" ||
+         gpio.setLevel(0, 0) != RESULT_OK || readFile(gpio17 + "/value") != "0" || gpio.setLevel(0, 2) == RESULT_OK )
+    {
+        std::cout << "ERROR main setting level of GPIO 17" << std::endl;
+        errors++;
+    }
+    writeFile(gpio12 + "/value", "1\n");
+    signed int level = 0;
+    if ( gpio.getLevel(8, level) != RESULT_OK || level != 1 )
+    {
+        std::cout << "ERROR main getting level of GPIO 12: " << level << std::endl;
+        errors++;
+    }
+
+    // Bulk levels: relays 0 and 1 set at once, GPIO's out of mask untouched
+    IGpioBulk::GpioMask_T levels = 0u;
+    writeFile(gpio27 + "/value", "0\n");
+    if ( gpio.setLevels(0x03u, 0x06u) != RESULT_OK || readFile(gpio17 + "/value") != "0" || readFile(gpio27 + "/value") != "1" ||
+         readFile(sysfsRoot + "/gpio22/value") != "0" )
+    {
+        std::cout << "ERROR main setting levels of relay GPIO mask 0x03" << std::endl;
+        errors++;
+    }
+    if ( gpio.getLevels(0x0103u, levels) != RESULT_OK || levels != 0x0102u || gpio.getLevels(0x10000u, levels) == RESULT_OK )
+    {
+        std::cout << "ERROR main getting levels of GPIO mask 0x0103: 0x" << std::hex << levels << std::dec << std::endl;
+        errors++;
+    }
+
+    // Ticks of 8 relays take microseconds, not a fork and 10 ms sleep per relay
+    const unsigned int NUM_TICKS = 1000u;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for ( unsigned int tick = 0; tick < NUM_TICKS; tick++ )
+    {
+        for ( uint8_t id = 0; id < 8; id++ ) gpio.setLevel(id, ( tick + id ) % 2);
+    }
+    double setLevelUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / (NUM_TICKS*8);
+    begin = std::chrono::steady_clock::now();
+    for ( unsigned int tick = 0; tick < NUM_TICKS; tick++ )
+    {
+        for ( uint8_t id = 8; id < 16; id++ ) gpio.getLevel(id, level);
+    }
+    double getLevelUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / (NUM_TICKS*8);
+    std::cout << "main setLevel " << setLevelUs << " us, getLevel " << getLevelUs << " us" << std::endl;
+    if ( setLevelUs > 1000.0 || getLevelUs > 1000.0 )
+    {
+        std::cout << "ERROR main GPIO access slower than 1 ms" << std::endl;
+        errors++;
+    }
+
+    // GPIO 21 not exported: initialize() requests it and waits until udev makes it accessible
+    gpio.shutdown();
+    std::string gpio21 = sysfsRoot + "/gpio21";
+    unlink((gpio21 + "/value").c_str());
+    unlink((gpio21 + "/direction").c_str());
+    unlink((gpio21 + "/active_low").c_str());
+    unlink((gpio21 + "/edge").c_str());
+    rmdir(gpio21.c_str());
+    writeFile(sysfsRoot + "/export", "");
+    std::thread udev([&gpio21] ()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        mkdir(gpio21.c_str(), 0755);
+        writeFile(gpio21 + "/edge", "none\n");
+        writeFile(gpio21 + "/active_low", "0\n");
+        writeFile(gpio21 + "/direction", "in\n");
+        writeFile(gpio21 + "/value", "0\n");
+    });
+    begin = std::chrono::steady_clock::now();
+    Result result = gpio.initialize();
+    double initializeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    udev.join();
+    std::cout << "main initialize with export " << initializeMs << " ms" << std::endl;
+    if ( result != RESULT_OK || readFile(sysfsRoot + "/export") != "21" || initializeMs < 50.0 || initializeMs > 500.0 )
+    {
+        std::cout << "ERROR main exporting GPIO 21" << std::endl;
+        errors++;
+    }
+
+    gpio.shutdown();
+    for ( uint8_t number : GPIO_NUMBERS )
+    {
+        std::string gpioDir = sysfsRoot + "/gpio" + std::to_string(number);
+        unlink((gpioDir + "/value").c_str());
+        unlink((gpioDir + "/direction").c_str());
+        unlink((gpioDir + "/active_low").c_str());
+        unlink((gpioDir + "/edge").c_str());
+        rmdir(gpioDir.c_str());
+    }
+    unlink((sysfsRoot + "/export").c_str());
+    rmdir(sysfsRoot.c_str());
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
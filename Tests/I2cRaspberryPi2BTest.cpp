@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   I2cRaspberryPi2BTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements I2cRaspberryPi2BTest
+ *
+ *  Runs I2cRaspberryPi2B with its I2C_RDWR ioctl replaced by a bus of
+ *  SimulatedAds1115 that can stop acknowledging: checks combined register
+ *  reads, a batch to 4 devices in one transaction, retries of a device not
+ *  acknowledging, errors of a missing device, per-device statistics and
+ *  that transactions of several threads never overlap.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <errno.h>
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <linux/i2c.h>
+#include "I2cRaspberryPi2B.h"
+#include "SimulatedAds1115.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "I2cRaspberryPi2BTest.logs";
+
+/*
+ * I2C_RDWR of 4 stand-ins at 0x48 to 0x4B; a message to another address is not acknowledged
+ */
+class SimulatedI2c : public I2cRaspberryPi2B
+{
+  public:
+
+    SimulatedI2c() : I2cRaspberryPi2B("I2cRaspberryPi2B", "/dev/null", 3u) {}
+
+    SimulatedAds1115 devices_[4] = { { 0x48u }, { 0x49u }, { 0x4Au }, { 0x4Bu } };
+    std::atomic<unsigned int> nacks_ { 0u };       // Attempts still to fail
+    std::atomic<unsigned int> calls_ { 0u };
+    std::atomic<unsigned int> inside_ { 0u };
+    std::atomic<bool> overlapped_ { false };
+
+  protected:
+
+    int rdwr(struct i2c_msg* messages, unsigned int numMessages)
+    {
+        calls_++;
+        if ( inside_++ != 0u ) overlapped_ = true;
+        int result = run(messages, numMessages);
+        inside_--;
+
+        return result;
+    }
+
+  private:
+
+    int run(struct i2c_msg* messages, unsigned int numMessages)
+    {
+        if ( nacks_ > 0u )
+        {
+            nacks_--;
+            return -EREMOTEIO;
+        }
+        for ( unsigned int i=0; i < numMessages; i++ )
+        {
+            if ( messages[i].addr < 0x48u || messages[i].addr > 0x4Bu ) return -ENXIO;
+            SimulatedAds1115 & device = devices_[messages[i].addr - 0x48u];
+            if ( messages[i].flags & I2C_M_RD ) return -EINVAL;
+            if ( i + 1u < numMessages && ( messages[i + 1u].flags & I2C_M_RD ) )
+            {
+                if ( device.writeRead(messages[i].addr, messages[i].buf, messages[i].len, messages[i + 1u].buf, messages[i + 1u].len) != RESULT_OK ) return -ENXIO;
+                i++;
+            }
+            else if ( device.write(messages[i].addr, messages[i].buf, messages[i].len) != RESULT_OK ) return -ENXIO;
+        }
+
+        return static_cast<int>(numMessages);
+    }
+};
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    SimulatedI2c bus;
+    I2cRaspberryPi2B::DeviceStats_T stats;
+
+    // Register pointer and register read in one transaction
+    uint8_t pointer = ADS1115_REG_CONFIG;
+    uint8_t config[2] = { 0u, 0u };
+    if ( bus.writeRead(0x48u, &pointer, 1u, config, 2u) != RESULT_OK || ( ( config[0] << 8 ) | config[1] ) != 0x8583u || bus.calls_ != 1u )
+    {
+        std::cout << "ERROR main reading config register of 0x48" << std::endl;
+        errors++;
+    }
+
+    // Config of 4 devices written in one transaction
+    uint8_t data[4][3];
+    I2cRaspberryPi2B::Message_T messages[4];
+    for ( unsigned int i=0; i < 4u; i++ )
+    {
+        data[i][0] = ADS1115_REG_HI_THRESH;
+        data[i][1] = 0x80u;
+        data[i][2] = static_cast<uint8_t>(i);
+        messages[i].address = static_cast<uint8_t>(0x48u + i);
+        messages[i].read = false;
+        messages[i].data = data[i];
+        messages[i].size = 3u;
+    }
+    unsigned int calls = bus.calls_;
+    if ( bus.transfer(messages, 4u) != RESULT_OK || bus.calls_ != calls + 1u || bus.devices_[3].getHiThresh() != 0x8003u )
+    {
+        std::cout << "ERROR main batch of 4 devices took " << bus.calls_ - calls << " transactions" << std::endl;
+        errors++;
+    }
+    bus.getStats(0x4Bu, stats);
+    if ( stats.transactions != 1u || stats.bytesWritten != 3u || stats.bytesRead != 0u )
+    {
+        std::cout << "ERROR main stats of 0x4B after batch: " << stats.transactions << " transactions " << stats.bytesWritten << " bytes" << std::endl;
+        errors++;
+    }
+
+    // Two NACKs retried; four fail after 3 retries
+    bus.nacks_ = 2u;
+    if ( bus.write(0x49u, data[1], 3u) != RESULT_OK )
+    {
+        std::cout << "ERROR main write not retried after 2 NACKs" << std::endl;
+        errors++;
+    }
+    bus.nacks_ = 4u;
+    if ( bus.write(0x49u, data[1], 3u) == RESULT_OK || bus.nacks_ != 0u )
+    {
+        std::cout << "ERROR main write succeeded after 4 NACKs" << std::endl;
+        errors++;
+    }
+    bus.getStats(0x49u, stats);
+    if ( stats.transactions != 3u || stats.retries != 5u || stats.errors != 1u )
+    {
+        std::cout << "ERROR main stats of 0x49: " << stats.transactions << " transactions " << stats.retries << " retries "
+                  << stats.errors << " errors" << std::endl;
+        errors++;
+    }
+
+    // Missing device is not acknowledged at every retry; an invalid message is not retried
+    calls = bus.calls_;
+    if ( bus.write(0x50u, data[0], 3u) == RESULT_OK || bus.calls_ != calls + 4u )
+    {
+        std::cout << "ERROR main write to missing device 0x50 took " << bus.calls_ - calls << " attempts" << std::endl;
+        errors++;
+    }
+    calls = bus.calls_;
+    messages[0].read = true;
+    if ( bus.transfer(messages, 1u) == RESULT_OK || bus.calls_ != calls + 1u || bus.transfer(messages, 43u) == RESULT_OK )
+    {
+        std::cout << "ERROR main invalid transaction took " << bus.calls_ - calls << " attempts" << std::endl;
+        errors++;
+    }
+
+    // Threads reading their devices never overlap on the bus
+    std::thread threads[4];
+    std::atomic<unsigned int> threadErrors { 0u };
+    for ( unsigned int t=0; t < 4u; t++ )
+    {
+        threads[t] = std::thread([&bus, &threadErrors, t] ()
+        {
+            uint8_t reg = ADS1115_REG_HI_THRESH;
+            uint8_t value[2];
+            for ( unsigned int i=0; i < 2000u; i++ )
+            {
+                if ( bus.writeRead(static_cast<uint8_t>(0x48u + t), &reg, 1u, value, 2u) != RESULT_OK || value[1] != t ) threadErrors++;
+            }
+        });
+    }
+    for ( unsigned int t=0; t < 4u; t++ ) threads[t].join();
+    bus.getStats(0x4Au, stats);
+    uint64_t histogram = 0u;
+    for ( unsigned int i=0; i < I2cRaspberryPi2B::NUM_LATENCY_BUCKETS; i++ ) histogram += stats.latencies[i];
+    if ( threadErrors != 0u || bus.overlapped_ || stats.transactions != 2001u || histogram != stats.transactions || stats.bytesRead != 4000u )
+    {
+        std::cout << "ERROR main concurrent transactions: " << threadErrors << " errors, overlapped " << bus.overlapped_
+                  << ", " << stats.transactions << " transactions of 0x4A in " << histogram << " latency buckets" << std::endl;
+        errors++;
+    }
+    bus.logStats();
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
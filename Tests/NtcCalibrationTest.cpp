@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   NtcCalibrationTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements NtcCalibrationTest
+ *
+ *  Fits Steinhart-Hart coefficients of points of a known thermistor, read
+ *  from a points file, and checks that AnalogSensorNtcThermistor fills its
+ *  table with them from the constants file. Fits gain and offset of a
+ *  sensor reading off, also as constants of a readings file, and of a
+ *  single point, and rejects points that do not determine a fit.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <math.h>
+#include <fstream>
+#include <iostream>
+#include "NtcCalibration.h"
+#include "AnalogSensorNtcThermistor.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "NtcCalibrationTest.logs";
+
+/*
+ * Coefficients of a usual 10 kOhm thermistor
+ */
+const double SH_COEFFICIENTS[3] = { 1.129148e-3, 2.34125e-4, 8.76741e-8 };
+
+static double shTemperature(double resistance)
+{
+    double logResistance = log(resistance);
+    return 1.0 / ( SH_COEFFICIENTS[0] + SH_COEFFICIENTS[1] * logResistance + SH_COEFFICIENTS[2] * logResistance * logResistance * logResistance ) - 273.15;
+}
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    NtcCalibration ntcCalibration("NtcCalibration");
+
+    // Points file of resistance and temperature from 1 kOhm to 300 kOhm
+    const char* POINTS_FILE_NAME = "NtcCalibrationTest.points";
+    std::ofstream pointsFile(POINTS_FILE_NAME);
+    pointsFile << "# Ohm degC" << std::endl << std::endl;
+    for ( double resistance = 1000.0; resistance < 300000.0; resistance *= 1.5 ) pointsFile << resistance << " " << shTemperature(resistance) << std::endl;
+    pointsFile.close();
+
+    std::vector<NtcCalibration::Point_T> points;
+    double coefficients[3];
+    double maxError = 1.0;
+    if ( ntcCalibration.readPoints(POINTS_FILE_NAME, points) != RESULT_OK || points.size() != 15u ||
+         ntcCalibration.fitSteinhartHart(points, coefficients, maxError) != RESULT_OK )
+    {
+        std::cout << "ERROR main fitting Steinhart-Hart coefficients of points file" << std::endl;
+        return 1;
+    }
+    std::cout << "main Steinhart-Hart coefficients " << coefficients[0] << " " << coefficients[1] << " " << coefficients[2]
+              << ", largest error " << maxError << " degC" << std::endl;
+    for ( unsigned int i=0; i < 3u; i++ )
+    {
+        if ( fabs(coefficients[i] - SH_COEFFICIENTS[i]) > 1e-3 * SH_COEFFICIENTS[i] || maxError > 0.01 )
+        {
+            std::cout << "ERROR main Steinhart-Hart coefficient " << i << " is " << coefficients[i] << " instead of " << SH_COEFFICIENTS[i] << std::endl;
+            errors++;
+        }
+    }
+
+    // Constants of the fit fill the table of the thermistor model
+    int32_t constants[3];
+    unsigned int numPoints = 0u;
+    if ( ntcCalibration.fitSteinhartHartConstants(POINTS_FILE_NAME, constants, numPoints, maxError) != RESULT_OK || numPoints != 15u )
+    {
+        std::cout << "ERROR main fitting Steinhart-Hart constants of points file" << std::endl;
+        return 1;
+    }
+    std::ofstream constantsFile("NtcThermistorTestSH.consts");
+    constantsFile << "RPU:10000" << std::endl;
+    for ( unsigned int i=0; i < 3u; i++ )
+    {
+        if ( constants[i] != llround(coefficients[i] * 1e12) )
+        {
+            std::cout << "ERROR main Steinhart-Hart constant " << i << " is " << constants[i] << std::endl;
+            errors++;
+        }
+        constantsFile << "SH_" << static_cast<char>('A' + i) << "_E12:" << constants[i] << std::endl;
+    }
+    constantsFile.close();
+    AnalogSensorNtcThermistor ntcThermistor("NtcThermistor", "TestSH");
+    ntcThermistor.initialize();
+    float tableError = 0.0f;
+    for ( unsigned int i=1; i < 1000u; i++ )
+    {
+        float ratio = static_cast<float>(i) / 1000u;
+        double expected = shTemperature(10000.0 * ratio / ( 1.0 - ratio ));
+        if ( expected < -20.0 || expected > 100.0 ) continue;
+        tableError = fmaxf(tableError, fabsf(ntcThermistor.toTemperature(ratio) - static_cast<float>(expected)));
+    }
+    std::cout << "main Steinhart-Hart table within " << tableError << " degC of the thermistor" << std::endl;
+    if ( !ntcThermistor.isSteinhartHart() || tableError > 0.02f )
+    {
+        std::cout << "ERROR main table of Steinhart-Hart constants" << std::endl;
+        errors++;
+    }
+
+    // Sensor reading 2 % high and 0.4 degC low
+    std::vector<NtcCalibration::Point_T> readings;
+    for ( double reference : { 0.0, 20.0, 40.0, 60.0 } ) readings.push_back(NtcCalibration::Point_T(1.02 * reference - 0.4, reference));
+    double gain = 0.0, offset = 0.0;
+    if ( ntcCalibration.fitOffsetGain(readings, gain, offset, maxError) != RESULT_OK ||
+         fabs(gain - 1.0 / 1.02) > 1e-9 || fabs(offset - 0.4 / 1.02) > 1e-9 || maxError > 1e-9 )
+    {
+        std::cout << "ERROR main gain " << gain << " and offset " << offset << " of readings" << std::endl;
+        errors++;
+    }
+
+    // Gain and offset of readings file as constants of parts per million and millidegrees
+    const char* READINGS_FILE_NAME = "NtcCalibrationTest.readings";
+    std::ofstream readingsFile(READINGS_FILE_NAME);
+    for ( const NtcCalibration::Point_T & reading : readings ) readingsFile << reading.first << " " << reading.second << std::endl;
+    readingsFile.close();
+    int32_t gainPpm = 0, offsetMdegC = 0;
+    if ( ntcCalibration.fitOffsetGainConstants(READINGS_FILE_NAME, gainPpm, offsetMdegC, numPoints, maxError) != RESULT_OK ||
+         numPoints != 4u || gainPpm != 980392 || offsetMdegC != 392 )
+    {
+        std::cout << "ERROR main gain " << gainPpm << " ppm and offset " << offsetMdegC << " mdegC of readings file" << std::endl;
+        errors++;
+    }
+
+    // One point fits the offset only
+    readings.resize(1u);
+    if ( ntcCalibration.fitOffsetGain(readings, gain, offset, maxError) != RESULT_OK || gain != 1.0 || fabs(offset - 0.4) > 1e-9 )
+    {
+        std::cout << "ERROR main offset of one reading " << offset << std::endl;
+        errors++;
+    }
+
+    // Two points, or a single resistance, do not determine Steinhart-Hart coefficients
+    std::vector<NtcCalibration::Point_T> fewPoints(points.begin(), points.begin() + 2);
+    std::vector<NtcCalibration::Point_T> samePoints(3u, points[0]);
+    readings.clear();
+    if ( ntcCalibration.fitSteinhartHart(fewPoints, coefficients, maxError) == RESULT_OK ||
+         ntcCalibration.fitSteinhartHart(samePoints, coefficients, maxError) == RESULT_OK ||
+         ntcCalibration.fitOffsetGain(readings, gain, offset, maxError) == RESULT_OK )
+    {
+        std::cout << "ERROR main fit of points that do not determine it" << std::endl;
+        errors++;
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   ProgramStorageTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements ProgramStorageTest
+ *
+ *  Writes a v1 program, converts it to v2 event list and v2 dense slots
+ *  and checks that all of them give the same set points for every second
+ *  of the week, through ProgramStorage and through ProgramTransitionIndex.
+ *  Checks that a header of more events than slots and a corrupted payload
+ *  are rejected.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "ProgramStorage.h"
+#include "ProgramTransitionIndex.h"
+#include "ProgramConverter.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "ProgramStorageTest.logs";
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    // Program v1: channel 0 every morning 07:00-07:30, channel 3 on Sunday
+    Byte_T program[PROGRAM_V1_SIZE_IN_BYTES] = { 0 };
+    for ( unsigned int day = 0; day < 7; day++ )
+    {
+        for ( unsigned int minute = 7*60; minute < 7*60 + 30; minute++ ) program[day*24*60 + minute] |= 0x01;
+    }
+    for ( unsigned int minute = 6*24*60; minute < 7*24*60; minute++ ) program[minute] |= 0x08;
+
+    FILE* filePtr = fopen("ProgramStorageTest.v1.prog", "w");
+    fwrite(program, 1, sizeof(program), filePtr);
+    fclose(filePtr);
+
+    ProgramConverter converter("ProgramConverter");
+    if ( converter.convertToEventList("ProgramStorageTest.v1.prog", "ProgramStorageTest.el.prog") != RESULT_OK )
+    {
+        std::cout << "ERROR main converting to event list" << std::endl;
+        errors++;
+    }
+    if ( converter.convertToDenseSlots("ProgramStorageTest.v1.prog", "ProgramStorageTest.ds.prog", 15) != RESULT_OK )
+    {
+        std::cout << "ERROR main converting to dense slots" << std::endl;
+        errors++;
+    }
+
+    const char* fileNames[] = { "ProgramStorageTest.v1.prog", "ProgramStorageTest.el.prog", "ProgramStorageTest.ds.prog" };
+    for ( const char* fileName : fileNames )
+    {
+        ProgramStorage storage("ProgramStorage");
+        if ( storage.loadWeekProgram(fileName, 8u) != RESULT_OK )
+        {
+            std::cout << "ERROR main loading " << fileName << std::endl;
+            errors++;
+            continue;
+        }
+        const ProgramStorage::ProgramImage* image = storage.getImage();
+
+        ProgramTransitionIndex index("ProgramTransitionIndex");
+        index.build(*image, nullptr, 0u);
+
+        unsigned int mismatches = 0;
+        for ( long weekSecond = 0; weekSecond < SECONDS_PER_WEEK; weekSecond++ )
+        {
+            Byte_T expected = program[weekSecond / 60];
+            if ( image->lookup(weekSecond) != expected || index.lookup(weekSecond) != expected ) mismatches++;
+        }
+        std::cout << "main " << fileName << " size:" << image->size << " bytes version:" << (int)image->version
+                  << " encoding:" << (int)image->encoding << " transitions:" << index.getNumTransitions()
+                  << " mismatches:" << mismatches << std::endl;
+        errors += mismatches;
+    }
+
+    // Program of as many channels as the build: highest relay on in the second half of the week
+    {
+        std::vector<uint32_t> starts = { 0u, static_cast<uint32_t>(SECONDS_PER_WEEK / 2) };
+        std::vector<Mask_T> values = { RelayMask::bit(0), RelayMask::bit(HOST_TIMER_NUM_OUTPUT_RELAYS - 1) };
+        ProgramStorage storage("ProgramStorage");
+        if ( converter.writeEventList("ProgramStorageTest.wide.prog", starts, values, 60u, HOST_TIMER_NUM_OUTPUT_RELAYS) != RESULT_OK
+             || storage.loadWeekProgram("ProgramStorageTest.wide.prog", HOST_TIMER_NUM_OUTPUT_RELAYS) != RESULT_OK
+             || storage.getImage()->lookup(0) != values[0] || storage.getImage()->lookup(SECONDS_PER_WEEK - 1) != values[1] )
+        {
+            std::cout << "ERROR main " << HOST_TIMER_NUM_OUTPUT_RELAYS << " channels program" << std::endl;
+            errors++;
+        }
+    }
+
+    // Number of events beyond one per slot must be rejected; 2 + 2^29 events of 4 byte slots
+    // wrap the payload size of 2 events on 32-bit targets
+    {
+        ProgramHeader_T header;
+        filePtr = fopen("ProgramStorageTest.wide.prog", "r+");
+        if ( fread(&header, sizeof(header), 1, filePtr) != 1u ) errors++;
+        header.numSlots += 1u << 29;
+        fseek(filePtr, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, filePtr);
+        fclose(filePtr);
+        ProgramStorage storage("ProgramStorage");
+        if ( storage.loadWeekProgram("ProgramStorageTest.wide.prog", HOST_TIMER_NUM_OUTPUT_RELAYS) == RESULT_OK )
+        {
+            std::cout << "ERROR main program of " << header.numSlots << " events accepted" << std::endl;
+            errors++;
+        }
+    }
+
+    // Corrupted payload must be rejected by CRC
+    filePtr = fopen("ProgramStorageTest.el.prog", "r+");
+    fseek(filePtr, sizeof(ProgramHeader_T) + 4, SEEK_SET);
+    fputc(0x7F, filePtr);
+    fclose(filePtr);
+    ProgramStorage storage("ProgramStorage");
+    if ( storage.loadWeekProgram("ProgramStorageTest.el.prog", 8u) == RESULT_OK )
+    {
+        std::cout << "ERROR main corrupted program accepted" << std::endl;
+        errors++;
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   RelayOutputsTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements RelayOutputsTest
+ *
+ *  Runs RelayOutputs against a fake IGpioBulk that counts its calls:
+ *  checks that unchanged set points cost no I/O, that only changed relays
+ *  are written, the switch counters and that periodic verification finds
+ *  and rewrites a tampered relay.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include "RelayOutputs.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FAKE GPIO'S
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class FakeGpioBulk : public IGpioBulk
+{
+  public:
+
+    GpioMask_T levels = 0u;
+    GpioMask_T lastSetMask = 0u;
+    unsigned int setLevelsCount = 0u;
+    mutable unsigned int getLevelsCount = 0u;
+
+    Result setMode(uint8_t gpioId, GpioMode_T mode) { return RESULT_OK; }
+    Result getLevel(uint8_t gpioId, signed int& level) const { level = ( levels >> gpioId ) & 1u; return RESULT_OK; }
+    Result setLevel(uint8_t gpioId, signed int level) { return setLevels(1u << gpioId, level ? ( 1u << gpioId ) : 0u); }
+    Result getVoltage(uint8_t gpioId, float &voltage) { return RESULT_UNIMPLEMENTED; }
+
+    Result setLevels(GpioMask_T mask, GpioMask_T newLevels)
+    {
+        setLevelsCount++;
+        lastSetMask = mask;
+        levels = ( levels & ~mask ) | ( newLevels & mask );
+        return RESULT_OK;
+    }
+
+    Result getLevels(GpioMask_T mask, GpioMask_T & currentLevels) const
+    {
+        getLevelsCount++;
+        currentLevels = levels & mask;
+        return RESULT_OK;
+    }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "RelayOutputsTest.logs";
+
+// Relays 0..7 on GPIO Id 7..0, so that relay and GPIO bits differ
+static const uint8_t GPIO_IDS[] = { 7, 6, 5, 4, 3, 2, 1, 0 };
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    FakeGpioBulk gpio;
+    RelayOutputs relays("RelayOutputs", &gpio, GPIO_IDS, 8u, 60u);
+
+    // First commit writes all relays
+    time_t now = 1000;
+    relays.commit(0x05u, now);
+    if ( gpio.setLevelsCount != 1u || gpio.lastSetMask != 0xFFu || gpio.levels != 0xA0u )
+    {
+        std::cout << "ERROR main first commit: setLevels " << gpio.setLevelsCount << " mask 0x" << std::hex << gpio.lastSetMask
+                  << " levels 0x" << gpio.levels << std::dec << std::endl;
+        errors++;
+    }
+
+    // Unchanged set points cost no I/O until verification is due
+    unsigned int ioCount = relays.getIoCount();
+    for ( unsigned int tick = 1; tick < 60; tick++ ) relays.commit(0x05u, now + tick);
+    if ( relays.getIoCount() != ioCount || gpio.setLevelsCount != 1u )
+    {
+        std::cout << "ERROR main unchanged set points made " << relays.getIoCount() - ioCount << " GPIO calls" << std::endl;
+        errors++;
+    }
+
+    // Only changed relays are written
+    relays.commit(0x06u, now + 10);
+    if ( gpio.setLevelsCount != 2u || gpio.lastSetMask != 0xC0u || gpio.levels != 0x60u || relays.getShadow() != 0x06u )
+    {
+        std::cout << "ERROR main changed relays: mask 0x" << std::hex << gpio.lastSetMask << " levels 0x" << gpio.levels << std::dec << std::endl;
+        errors++;
+    }
+    relays.commit(0x07u, now + 11);
+    relays.commit(0x06u, now + 12);
+    if ( relays.getSwitchCount(0) != 3u || relays.getSwitchCount(1) != 1u || relays.getSwitchCount(2) != 0u )
+    {
+        std::cout << "ERROR main switch counts " << relays.getSwitchCount(0) << " " << relays.getSwitchCount(1) << " "
+                  << relays.getSwitchCount(2) << ", expected 3 1 0" << std::endl;
+        errors++;
+    }
+
+    // Verification reads back all relays and rewrites a tampered one
+    gpio.levels ^= ( 1u << GPIO_IDS[4] );
+    unsigned int setLevelsCount = gpio.setLevelsCount;
+    relays.commit(0x06u, now + 59);
+    if ( gpio.getLevelsCount != 0u || relays.getTamperCount() != 0u )
+    {
+        std::cout << "ERROR main verification before period" << std::endl;
+        errors++;
+    }
+    relays.commit(0x06u, now + 60);
+    if ( gpio.getLevelsCount != 1u || relays.getTamperCount() != 1u || gpio.setLevelsCount != setLevelsCount + 1u
+         || gpio.lastSetMask != ( 1u << GPIO_IDS[4] ) || gpio.levels != 0x60u )
+    {
+        std::cout << "ERROR main verification: getLevels " << gpio.getLevelsCount << " tampers " << relays.getTamperCount()
+                  << " levels 0x" << std::hex << gpio.levels << std::dec << std::endl;
+        errors++;
+    }
+
+    // Invalidated shadow writes all relays again, without counting switches
+    relays.invalidate();
+    relays.commit(0x06u, now + 61);
+    if ( gpio.lastSetMask != 0xFFu || gpio.levels != 0x60u || relays.getSwitchCount(1) != 1u )
+    {
+        std::cout << "ERROR main commit after invalidate: mask 0x" << std::hex << gpio.lastSetMask << std::dec << std::endl;
+        errors++;
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
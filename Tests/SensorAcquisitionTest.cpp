@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   SensorAcquisitionTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements SensorAcquisitionTest
+ *
+ *  Samples simulated channels with a slow reader in the acquisition thread
+ *  and checks that the control side gets consistent samples without waiting
+ *  for the slow reads, and that a failing channel keeps its last sample.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <unistd.h>
+#include "SensorAcquisition.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "SensorAcquisitionTest.logs";
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    // Seqlock: reader never sees a torn pair written by another thread
+    {
+        struct Pair_T { uint64_t a; uint64_t b; uint64_t c; };
+        SeqlockSnapshot<Pair_T> snapshot;
+        std::atomic<bool> done { false };
+        std::thread writer([&snapshot, &done] ()
+        {
+            for ( uint64_t i=1; i <= 2000000u; i++ ) snapshot.write(Pair_T{ i, ~i, i*3u });
+            done = true;
+        });
+        unsigned int torn = 0u;
+        while ( !done )
+        {
+            Pair_T pair;
+            if ( snapshot.read(pair) && ( pair.b != ~pair.a || pair.c != pair.a*3u ) ) torn++;
+        }
+        writer.join();
+        if ( torn != 0u )
+        {
+            std::cout << "ERROR main " << torn << " torn seqlock reads" << std::endl;
+            errors++;
+        }
+    }
+
+    // Channel 16 reads take 50 ms; channel 17 fails after its first read
+    std::atomic<unsigned int> reads17 { 0u };
+    SensorAcquisition acquisition("SensorAcquisition", 10u);
+    Result result = acquisition.start({ 16u, 17u }, [&reads17] (uint8_t channelId, float & value)
+    {
+        if ( channelId == 17u ) return ( reads17++ == 0u ) ? ( value = 1.0f, RESULT_OK ) : RESULT_ERROR;
+        usleep(50000);
+        value = 21.5f;
+        return RESULT_OK;
+    });
+    if ( result != RESULT_OK )
+    {
+        std::cout << "ERROR main starting acquisition" << std::endl;
+        return 1;
+    }
+
+    // Samples of the first pass are there as soon as start() returns
+    std::map<uint8_t, float> values;
+    if ( acquisition.readLatest(values, 1000000000ll) != 0u || values[16] != 21.5f || values[17] != 1.0f )
+    {
+        std::cout << "ERROR main first samples " << values[16] << " " << values[17] << std::endl;
+        errors++;
+    }
+
+    // Reading the latest samples does not wait for the 50 ms reads
+    int64_t begin = SensorAcquisition::now();
+    for ( unsigned int i=0; i < 1000u; i++ ) acquisition.readLatest(values, 1000000000ll);
+    int64_t elapsedNs = SensorAcquisition::now() - begin;
+    if ( elapsedNs > 50000000ll )
+    {
+        std::cout << "ERROR main 1000 reads of latest samples took " << elapsedNs << " ns" << std::endl;
+        errors++;
+    }
+
+    usleep(500000);
+    acquisition.stop();
+
+    SensorAcquisition::Sample_T sample16, sample17;
+    acquisition.readLatest(16u, sample16);
+    acquisition.readLatest(17u, sample17);
+    if ( sample16.sampleCount < 3u || sample17.sampleCount != 1u || sample17.value != 1.0f || acquisition.getErrorCount() == 0u )
+    {
+        std::cout << "ERROR main samples after stop: channel 16 " << sample16.sampleCount << " samples, channel 17 "
+                  << sample17.sampleCount << " samples, " << acquisition.getErrorCount() << " errors" << std::endl;
+        errors++;
+    }
+    usleep(200000);
+    if ( acquisition.readLatest(values, 100000000ll) != 2u )
+    {
+        std::cout << "ERROR main samples older than 100 ms must be stale" << std::endl;
+        errors++;
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
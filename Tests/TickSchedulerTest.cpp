@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   TickSchedulerTest.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements TickSchedulerTest
+ *
+ *  Runs a TickScheduler on a SimulatedClock and checks that a week of ticks
+ *  covers every week second once, that waitUntil() skips ticks and that a
+ *  loop slower than the tick period is counted as overrun. On the system
+ *  clock, checks that an event fd wakes up the wait without losing the tick,
+ *  and that an event fd always readable does not starve the ticks.
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "TickScheduler.h"
+#include "SimulatedClock.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char Logger::logFileName_[] = "TickSchedulerTest.logs";
+
+int main(int argc, char *argv[]) {
+
+    unsigned int errors = 0;
+
+    // A week at 1 Hz: one tick per week second, in order
+    {
+        SimulatedClock clock;
+        TickScheduler scheduler("TickScheduler", 1u, &clock);
+        scheduler.initialize();
+        std::vector<bool> seen(SECONDS_PER_WEEK, false);
+        unsigned int outOfOrder = 0u;
+        long prevWeekSecond = -1l;
+        for ( long i=0; i < SECONDS_PER_WEEK; i++ )
+        {
+            struct timespec now;
+            clock.now(now);
+            long weekSecond = clock.weekSecond(now.tv_sec);
+            if ( weekSecond != prevWeekSecond + 1 ) outOfOrder++;
+            seen[weekSecond] = true;
+            prevWeekSecond = weekSecond;
+            scheduler.waitNextTick();
+        }
+        unsigned int missing = 0u;
+        for ( bool second : seen ) if ( !second ) missing++;
+        if ( outOfOrder != 0u || missing != 0u || scheduler.getTickCount() != static_cast<uint64_t>(SECONDS_PER_WEEK) )
+        {
+            std::cout << "ERROR main week of ticks: " << outOfOrder << " out of order, " << missing << " missing, "
+                      << scheduler.getTickCount() << " ticks" << std::endl;
+            errors++;
+        }
+        if ( clock.weekSecond(scheduler.getTickTime().tv_sec) != 0 )
+        {
+            std::cout << "ERROR main week of ticks must end on Monday 00:00:00" << std::endl;
+            errors++;
+        }
+    }
+
+    // 10 Hz ticks on tenths of second; waitUntil skips to the given second
+    {
+        SimulatedClock clock(100);
+        TickScheduler scheduler("TickScheduler", 10u, &clock);
+        scheduler.initialize();
+        scheduler.waitNextTick();
+        if ( scheduler.getTickTime().tv_sec != 100 || scheduler.getTickTime().tv_nsec != 100000000l )
+        {
+            std::cout << "ERROR main first 10 Hz tick at " << scheduler.getTickTime().tv_sec << "." << scheduler.getTickTime().tv_nsec << std::endl;
+            errors++;
+        }
+        scheduler.waitUntil(160);
+        if ( scheduler.getTickTime().tv_sec != 160 || scheduler.getTickTime().tv_nsec != 0 || scheduler.getTickCount() != 2u )
+        {
+            std::cout << "ERROR main waitUntil woke up at " << scheduler.getTickTime().tv_sec << "." << scheduler.getTickTime().tv_nsec << std::endl;
+            errors++;
+        }
+
+        // Loop busy for 350 ms: deadline missed and realigned to next tenth
+        clock.advance(350000000ll);
+        scheduler.waitNextTick();
+        if ( scheduler.getOverrunCount() != 1u || scheduler.getMissedTickCount() != 3u || scheduler.getTickTime().tv_nsec != 400000000l )
+        {
+            std::cout << "ERROR main overrun: " << scheduler.getOverrunCount() << " overruns, " << scheduler.getMissedTickCount()
+                      << " missed ticks, tick at " << scheduler.getTickTime().tv_nsec << " ns" << std::endl;
+            errors++;
+        }
+    }
+
+    // 3 Hz does not divide the second: ticks stay on thirds of second and every third one on the second
+    {
+        SimulatedClock clock(100);
+        clock.advance(500000000ll);
+        TickScheduler scheduler("TickScheduler", 3u, &clock);
+        scheduler.initialize();
+        scheduler.waitNextTick();
+        if ( scheduler.getTickTime().tv_sec != 100 || scheduler.getTickTime().tv_nsec != 666666666l )
+        {
+            std::cout << "ERROR main first 3 Hz tick at " << scheduler.getTickTime().tv_sec << "." << scheduler.getTickTime().tv_nsec << std::endl;
+            errors++;
+        }
+        for ( unsigned int i=0; i < 3u * 3600u; i++ ) scheduler.waitNextTick();
+        if ( scheduler.getTickTime().tv_sec != 3700 || scheduler.getTickTime().tv_nsec != 666666666l || scheduler.getOverrunCount() != 0u )
+        {
+            std::cout << "ERROR main 3 Hz tick after an hour at " << scheduler.getTickTime().tv_sec << "." << scheduler.getTickTime().tv_nsec << std::endl;
+            errors++;
+        }
+        scheduler.waitNextTick();
+        if ( scheduler.getTickTime().tv_sec != 3701 || scheduler.getTickTime().tv_nsec != 0l )
+        {
+            std::cout << "ERROR main 3 Hz tick off the second boundary at " << scheduler.getTickTime().tv_sec << "." << scheduler.getTickTime().tv_nsec << std::endl;
+            errors++;
+        }
+    }
+
+    // On the system clock an event fd cuts the wait short and keeps the pending tick
+    {
+        TickScheduler scheduler("TickScheduler", 1u);
+        scheduler.initialize();
+        scheduler.waitNextTick();
+        int eventFd = eventfd(0, EFD_CLOEXEC);
+        std::chrono::steady_clock::time_point signalTime;
+        std::thread signaller([&] ()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            signalTime = std::chrono::steady_clock::now();
+            uint64_t one = 1u;
+            if ( write(eventFd, &one, sizeof(one)) != sizeof(one) ) std::cout << "ERROR main writing event fd" << std::endl;
+        });
+        bool event = false;
+        scheduler.waitNextTick(eventFd, event);
+        std::chrono::steady_clock::time_point wakeupTime = std::chrono::steady_clock::now();
+        signaller.join();
+        double latencyMs = std::chrono::duration<double, std::milli>(wakeupTime - signalTime).count();
+        std::cout << "main event wake-up latency " << latencyMs << " ms" << std::endl;
+        if ( !event || scheduler.getTickCount() != 1u || latencyMs > 10.0 )
+        {
+            std::cout << "ERROR main event wake-up: event " << event << ", " << scheduler.getTickCount() << " ticks" << std::endl;
+            errors++;
+        }
+
+        // Event consumed: next wait is released by the pending tick
+        uint64_t count;
+        if ( read(eventFd, &count, sizeof(count)) != sizeof(count) ) errors++;
+        scheduler.waitNextTick(eventFd, event);
+        if ( event || scheduler.getTickCount() != 2u || scheduler.getOverrunCount() != 0u )
+        {
+            std::cout << "ERROR main tick after event: event " << event << ", " << scheduler.getTickCount() << " ticks" << std::endl;
+            errors++;
+        }
+
+        // Event fd left readable and processed longer than until the deadline: ticks keep coming
+        uint64_t one = 1u;
+        if ( write(eventFd, &one, sizeof(one)) != sizeof(one) ) errors++;
+        TickScheduler fastScheduler("TickScheduler", 10u);
+        fastScheduler.initialize();
+        fastScheduler.waitNextTick();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds(550);
+        unsigned int events = 0u;
+        while ( std::chrono::steady_clock::now() < end )
+        {
+            fastScheduler.waitNextTick(eventFd, event);
+            if ( event )
+            {
+                events++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        std::cout << "main " << fastScheduler.getTickCount() << " ticks among " << events << " events" << std::endl;
+        if ( fastScheduler.getTickCount() < 5u || fastScheduler.getOverrunCount() != 0u )
+        {
+            std::cout << "ERROR main ticks starved by events: " << fastScheduler.getTickCount() << " ticks, "
+                      << fastScheduler.getOverrunCount() << " overruns" << std::endl;
+            errors++;
+        }
+        close(eventFd);
+    }
+
+    std::cout << "main " << ( errors == 0 ? "PASSED" : "FAILED" ) << std::endl;
+
+    return ( errors == 0 ) ? 0 : 1;
+}
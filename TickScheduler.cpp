@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   TickScheduler.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements TickScheduler class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TickScheduler.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TickScheduler::TickScheduler(const char* instanceName, unsigned int tickRateHz, IClock* clock)
+:   IComponent(instanceName),
+    clock_(clock),
+    tickRateHz_(tickRateHz)
+{
+    logChannels_ = Logger::ERRORS;
+
+    if ( clock_ == nullptr )
+    {
+        systemClock_ = new SystemClock("SystemClock");
+        ASSERT( systemClock_ != nullptr );
+        clock_ = systemClock_;
+    }
+
+    if ( tickRateHz_ < MIN_TICK_RATE_HZ ) tickRateHz_ = MIN_TICK_RATE_HZ;
+    if ( tickRateHz_ > MAX_TICK_RATE_HZ ) tickRateHz_ = MAX_TICK_RATE_HZ;
+    // Nominal period, deadlines are computed from the tick index within the second
+    tickPeriodNs_ = NSEC_PER_SEC / tickRateHz_;
+
+    tickTime_.tv_sec = 0; tickTime_.tv_nsec = 0;
+    nextTick_.tv_sec = 0; nextTick_.tv_nsec = 0;
+}
+
+TickScheduler::~TickScheduler()
+{
+    shutdown();
+    delete systemClock_;
+}
+
+Result TickScheduler::initialize()
+{
+    aligned_ = false;
+    tickPending_ = false;
+
+    LOGGING(INFO, "tick rate is %d Hz, tick period is %ld ns", tickRateHz_, tickPeriodNs_);
+
+    return RESULT_OK;
+}
+
+void TickScheduler::shutdown()
+{
+    aligned_ = false;
+}
+
+Result TickScheduler::waitNextTick()
+{
+    bool event;
+
+    return waitNextTick(-1, event);
+}
+
+Result TickScheduler::waitNextTick(int eventFd, bool & event)
+{
+    struct timespec now;
+    clock_->now(now);
+
+    if ( !aligned_ )
+    {
+        alignNextTick(now);
+        aligned_ = true;
+    }
+    else
+    {
+        // Check if the deadline already passed while the loop was busy
+        long long lateNs = static_cast<long long>(now.tv_sec - nextTick_.tv_sec) * NSEC_PER_SEC + (now.tv_nsec - nextTick_.tv_nsec);
+        if ( lateNs >= 0 && tickPending_ )
+        {
+            // Passed while the event of an early return was processed: the tick is due now
+            event = false;
+            releaseTick();
+            return RESULT_OK;
+        }
+        if ( lateNs >= 0 )
+        {
+            uint64_t missed = static_cast<uint64_t>(lateNs / tickPeriodNs_) + 1u;
+            overrunCount_++;
+            missedTickCount_ += missed;
+            LOGGING(ERRORS, "WARNING tick overrun by %lld ns, %llu tick(s) missed", lateNs, static_cast<unsigned long long>(missed));
+            alignNextTick(now);
+        }
+    }
+
+    Result result = clock_->sleepUntil(nextTick_, eventFd, event);
+    if ( result == RESULT_CANCELLED )
+    {
+        // Wall clock was stepped: realign to the new second boundary
+        LOGMSG(ERRORS, "WARNING wall clock stepped, realigning ticks");
+        clock_->now(now);
+        alignNextTick(now);
+        result = clock_->sleepUntil(nextTick_, eventFd, event);
+    }
+    if ( result != RESULT_OK && result != RESULT_CANCELLED )
+    {
+        LOGGING(ERRORS, "ERROR waiting for tick with result %d", result);
+        return result;
+    }
+
+    // Woken up by event before the deadline: the tick is still pending
+    // At or after the deadline the tick comes first, the event stays readable
+    if ( event )
+    {
+        clock_->now(now);
+        if ( now.tv_sec < nextTick_.tv_sec || ( now.tv_sec == nextTick_.tv_sec && now.tv_nsec < nextTick_.tv_nsec ) )
+        {
+            tickPending_ = true;
+            return RESULT_OK;
+        }
+        event = false;
+    }
+
+    releaseTick();
+
+    return RESULT_OK;
+}
+
+Result TickScheduler::waitUntil(time_t wakeupTime)
+{
+    bool event;
+
+    return waitUntil(wakeupTime, -1, event);
+}
+
+Result TickScheduler::waitUntil(time_t wakeupTime, int eventFd, bool & event)
+{
+    if ( aligned_ && wakeupTime > nextTick_.tv_sec )
+    {
+        nextTick_.tv_sec  = wakeupTime;
+        nextTick_.tv_nsec = 0;
+        nextTickIndex_ = 0u;
+    }
+
+    return waitNextTick(eventFd, event);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TickScheduler::releaseTick()
+{
+    tickPending_ = false;
+    tickTime_ = nextTick_;
+    tickCount_++;
+
+    // Schedule following deadline
+    nextTickIndex_++;
+    if ( nextTickIndex_ >= tickRateHz_ )
+    {
+        nextTick_.tv_sec += 1;
+        nextTickIndex_ = 0u;
+    }
+    nextTick_.tv_nsec = tickOffsetNs(nextTickIndex_);
+}
+
+void TickScheduler::alignNextTick(const struct timespec & now)
+{
+    nextTick_.tv_sec = now.tv_sec;
+    nextTickIndex_ = static_cast<unsigned int>( static_cast<long long>(now.tv_nsec) * tickRateHz_ / NSEC_PER_SEC ) + 1u;
+    if ( tickOffsetNs(nextTickIndex_) <= now.tv_nsec ) nextTickIndex_++;
+    if ( nextTickIndex_ >= tickRateHz_ )
+    {
+        nextTick_.tv_sec += 1;
+        nextTickIndex_ = 0u;
+    }
+    nextTick_.tv_nsec = tickOffsetNs(nextTickIndex_);
+}
@@ -0,0 +1,160 @@
+#ifndef _TICK_SCHEDULER_H
+#define _TICK_SCHEDULER_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   TickScheduler.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of TickScheduler
+ *
+ *  Paces the HostTimer control loop with absolute deadlines aligned to
+ *  wall-clock second boundaries, so the time spent inside one iteration
+ *  does not accumulate as drift.
+ *
+ *  Time is taken from an IClock: by default a SystemClock, whose deadlines
+ *  are armed on a CLOCK_REALTIME timerfd, or a SimulatedClock to run the
+ *  loop faster than real time. A wall-clock step (NTP, RTC sync) cancels
+ *  the wait and the schedule is realigned to the new second boundary.
+ *  The wait can also be cut short by an event file descriptor (e.g. digital
+ *  input edges) without losing the pending deadline.
+ *
+ *  Counters:
+ *      - overruns    : iterations whose work exceeded one tick period.
+ *      - missed ticks: deadlines that passed while the loop was busy.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <time.h>
+#include "LenamDevs_types.h"
+#include "IComponent.h"
+#include "IClock.h"
+#include "SystemClock.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// GLOBAL CONSTANTS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int MIN_TICK_RATE_HZ =  1u;
+const unsigned int MAX_TICK_RATE_HZ = 10u;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class TickScheduler : public IComponent
+{
+  public:
+
+    /*
+     * Class constructor
+     * @param tickRateHz number of ticks per second, from MIN_TICK_RATE_HZ to MAX_TICK_RATE_HZ
+     * @param clock time source, not owned; a SystemClock is used if nullptr
+     */
+    TickScheduler(const char* instanceName, unsigned int tickRateHz = MIN_TICK_RATE_HZ, IClock* clock = nullptr);
+
+    /*
+     * Class destructor
+     */
+    ~TickScheduler();
+
+    Result initialize();
+
+    Result start() { return RESULT_OK; }
+
+    void shutdown();
+
+    /**
+     * Blocks until the next tick deadline (aligned to the tick period within the second)
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result waitNextTick();
+
+    /**
+     * Blocks until wall-clock second wakeupTime, skipping the ticks in between
+     * A wakeupTime earlier than the next tick behaves as waitNextTick()
+     * @param wakeupTime absolute wall-clock second to wake up at
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result waitUntil(time_t wakeupTime);
+
+    /**
+     * As waitNextTick(), but returns earlier if eventFd becomes readable
+     * An early return keeps the pending deadline: the next call waits for the same tick,
+     * or releases it at once if the deadline passed meanwhile, so events cannot starve ticks
+     * @param eventFd file descriptor to wake up on, -1 for none; it is not read
+     * @param event true if woken up by eventFd before the tick
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result waitNextTick(int eventFd, bool & event);
+
+    /**
+     * As waitUntil(), but returns earlier if eventFd becomes readable
+     * @param wakeupTime absolute wall-clock second to wake up at
+     * @param eventFd file descriptor to wake up on, -1 for none; it is not read
+     * @param event true if woken up by eventFd before wakeupTime
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result waitUntil(time_t wakeupTime, int eventFd, bool & event);
+
+    /**
+     * Time of the tick that last released waitNextTick()
+     * @return timespec with wall-clock time of the tick deadline
+     */
+    const struct timespec & getTickTime() const { return tickTime_; }
+
+    unsigned int getTickRateHz() const { return tickRateHz_; }
+
+    uint64_t getTickCount() const { return tickCount_; }
+
+    uint64_t getOverrunCount() const { return overrunCount_; }
+
+    uint64_t getMissedTickCount() const { return missedTickCount_; }
+
+  private:
+
+    static const long NSEC_PER_SEC = 1000000000l;
+
+    IClock * clock_;
+    SystemClock * systemClock_ = nullptr;
+
+    unsigned int tickRateHz_;
+    long tickPeriodNs_;
+
+    struct timespec tickTime_;
+    struct timespec nextTick_;
+    unsigned int nextTickIndex_ = 0u;   // tick of nextTick_ within its second, from 0 to tickRateHz_ - 1
+    bool aligned_ = false;
+    bool tickPending_ = false;      // deadline of an early return on event not released yet
+
+    uint64_t tickCount_       = 0u;
+    uint64_t overrunCount_    = 0u;
+    uint64_t missedTickCount_ = 0u;
+
+    /**
+     * Sets nextTick_ to the first tick boundary strictly after now
+     * @param now current wall-clock time
+     */
+    void alignNextTick(const struct timespec & now);
+
+    /**
+     * Releases the tick of nextTick_ and schedules the following deadline
+     */
+    void releaseTick();
+
+    /**
+     * Offset in the second of tick index, index * NSEC_PER_SEC / tickRateHz_ rounded down, so that
+     * rates not dividing the second (3, 6, 7, 9 Hz) do not accumulate the truncation of tickPeriodNs_
+     * @param index tick within the second, from 0 to tickRateHz_
+     * @return long offset in ns
+     */
+    long tickOffsetNs(unsigned int index) const
+    {
+        return static_cast<long>( static_cast<long long>(index) * NSEC_PER_SEC / tickRateHz_ );
+    }
+};
+
+#endif // _TICK_SCHEDULER_H
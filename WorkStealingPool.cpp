@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   WorkStealingPool.cpp
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Implements WorkStealingPool class
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PUBLIC METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+WorkStealingPool::WorkStealingPool(const char* instanceName, unsigned int numWorkers) : Logs(instanceName)
+{
+    logChannels_ = Logger::ERRORS;
+
+    if ( numWorkers == 0u ) numWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+    for ( unsigned int i=0; i < numWorkers; i++ )
+    {
+        queues_.push_back(new Queue_T);
+        ASSERT( queues_.back() != nullptr );
+    }
+    for ( unsigned int i=0; i < numWorkers; i++ ) threads_.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+
+    LOGGING(INFO, "started %d worker threads", numWorkers);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeup_.notify_all();
+    for ( std::thread & thread : threads_ ) thread.join();
+    for ( Queue_T* queue : queues_ ) delete queue;
+}
+
+Result WorkStealingPool::run(unsigned int numTasks, const Task_T & task)
+{
+    if ( numTasks == 0u ) return RESULT_OK;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if ( pendingTasks_ != 0u )
+    {
+        LOGMSG(ERRORS, "ERROR running batch while previous batch is pending");
+        return RESULT_ERROR;
+    }
+    done_.wait(lock, [this] { return activeWorkers_ == 0u; });
+
+    // Deal contiguous blocks of tasks so that neighbouring tasks run on the same worker
+    unsigned int numWorkers = queues_.size();
+    for ( unsigned int worker=0; worker < numWorkers; worker++ )
+    {
+        std::lock_guard<std::mutex> queueLock(queues_[worker]->mutex);
+        unsigned int first = static_cast<unsigned int>( static_cast<uint64_t>(numTasks) * worker / numWorkers );
+        unsigned int last  = static_cast<unsigned int>( static_cast<uint64_t>(numTasks) * (worker + 1) / numWorkers );
+        for ( unsigned int i=first; i < last; i++ ) queues_[worker]->tasks.push_back(i);
+    }
+
+    task_ = &task;
+    pendingTasks_ = numTasks;
+    batch_++;
+    wakeup_.notify_all();
+
+    done_.wait(lock, [this] { return pendingTasks_ == 0u && activeWorkers_ == 0u; });
+    task_ = nullptr;
+
+    return RESULT_OK;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PRIVATE METHODS
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void WorkStealingPool::workerLoop(unsigned int worker)
+{
+    uint64_t lastBatch = 0u;
+
+    while (1)
+    {
+        const Task_T* task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeup_.wait(lock, [this, lastBatch] { return stop_ || batch_ != lastBatch; });
+            if ( stop_ ) return;
+            lastBatch = batch_;
+            task = task_;
+            if ( task == nullptr ) continue;    // Woken after the batch was completed by other workers
+            activeWorkers_++;
+        }
+
+        // All tasks of the batch are dealt before wake up, so an empty scan means the batch is taken
+        unsigned int number;
+        while ( takeTask(worker, number) )
+        {
+            (*task)(number, worker);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            pendingTasks_--;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if ( --activeWorkers_ == 0u ) done_.notify_all();
+    }
+}
+
+bool WorkStealingPool::takeTask(unsigned int worker, unsigned int & task)
+{
+    {
+        Queue_T & own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if ( !own.tasks.empty() )
+        {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    unsigned int numWorkers = queues_.size();
+    for ( unsigned int i=1; i < numWorkers; i++ )
+    {
+        Queue_T & victim = *queues_[(worker + i) % numWorkers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if ( !victim.tasks.empty() )
+        {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            stealCount_++;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,107 @@
+#ifndef _WORK_STEALING_POOL_H
+#define _WORK_STEALING_POOL_H
+
+/////////////////////////////////////////////////////////////////////////////
+/**
+ *  @file   WorkStealingPool.h
+ *  @author Manel Gonzalez Farrera
+ *  @date   October 2026
+ *  @brief  Definition of WorkStealingPool
+ *
+ *  Fixed set of worker threads running batches of independent tasks.
+ *  Tasks of a batch are dealt in contiguous blocks to per-worker queues;
+ *  a worker takes its own tasks from the back and, when it runs out,
+ *  steals from the front of the other queues, so uneven tasks (e.g. hosts
+ *  with guards that must be stepped every second) keep all cores busy.
+ *  A batch ends when its tasks are done and every worker has stopped
+ *  scanning the queues, so no worker can take a task of the next batch
+ *  with the function of the previous one.
+ */
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "LenamDevs_types.h"
+#include "Logs.h"
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// CLASS DECLARATION
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class WorkStealingPool : public Logs
+{
+  public:
+
+    /*
+     * Task function, called with task number and worker number
+     */
+    typedef std::function<void(unsigned int task, unsigned int worker)> Task_T;
+
+    /*
+     * Class constructor
+     * @param numWorkers number of worker threads, 0 for one per core
+     */
+    WorkStealingPool(const char* instanceName, unsigned int numWorkers = 0u);
+
+    /*
+     * Class destructor; joins worker threads
+     */
+    ~WorkStealingPool();
+
+    unsigned int getNumWorkers() const { return threads_.size(); }
+
+    /*
+     * Number of tasks run by a worker other than the one they were dealt to
+     */
+    uint64_t getStealCount() const { return stealCount_.load(); }
+
+    /**
+     * Runs tasks 0 to numTasks - 1 on the worker threads and waits for all of them
+     * @param numTasks number of tasks
+     * @param task function run for every task; must not throw
+     * @return Result RESULT_OK in case of correct execution
+     */
+    Result run(unsigned int numTasks, const Task_T & task);
+
+  private:
+
+    struct Queue_T
+    {
+        std::mutex mutex;
+        std::deque<unsigned int> tasks;
+    };
+
+    std::vector<std::thread> threads_;
+    std::vector<Queue_T*> queues_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable done_;
+
+    const Task_T* task_ = nullptr;
+    uint64_t batch_ = 0u;
+    unsigned int pendingTasks_ = 0u;
+    unsigned int activeWorkers_ = 0u;
+    bool stop_ = false;
+
+    std::atomic<uint64_t> stealCount_ { 0u };
+
+    void workerLoop(unsigned int worker);
+
+    /**
+     * Takes next task: own queue first, then the other queues
+     * @param worker number
+     * @param task taken
+     * @return bool true if a task was taken
+     */
+    bool takeTask(unsigned int worker, unsigned int & task);
+};
+
+#endif // _WORK_STEALING_POOL_H